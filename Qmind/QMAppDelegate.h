@@ -20,6 +20,7 @@ static NSString *const qDefaultsVersionKey = @"Version";
 
 @property (weak) IBOutlet NSMenuItem *insertNewChildNodeMenuItem;
 @property (weak) IBOutlet NSMenuItem *insertNewLeftChildNodeMenuItem;
+@property (weak) IBOutlet NSMenuItem *exportTraceMenuItem;
 
 @property (unsafe_unretained) IBOutlet NSWindow *preferencesWindow;
 
@@ -29,4 +30,9 @@ static NSString *const qDefaultsVersionKey = @"Version";
 
 - (IBAction)showPreferencesWindow:(id)sender;
 
+/**
+* Writes the trace recorded so far to a file chosen by the user. The menu item is hidden unless QM_TRACE is defined.
+*/
+- (IBAction)exportTraceAction:(id)sender;
+
 @end
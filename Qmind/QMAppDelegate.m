@@ -8,6 +8,7 @@
 
 #import "QMAppDelegate.h"
 #import "TBCacao/TBCacao.h"
+#import "QMTrace.h"
 
 @implementation QMAppDelegate
 
@@ -20,6 +21,22 @@ TB_MANUALWIRE(documentController)
     [self.preferencesWindow makeKeyAndOrderFront:self];
 }
 
+- (IBAction)exportTraceAction:(id)sender {
+#ifdef QM_TRACE
+    NSSavePanel *savePanel = [NSSavePanel savePanel];
+    savePanel.allowedFileTypes = @[@"json"];
+    savePanel.nameFieldStringValue = @"qmind-trace.json";
+
+    if ([savePanel runModal] != NSFileHandlingPanelOKButton) {
+        return;
+    }
+
+    if (!QMTraceWriteChromeTraceToUrl(savePanel.URL)) {
+        NSBeep();
+    }
+#endif
+}
+
 #pragma mark NSObject
 - (id)init {
     self = [super init];
@@ -43,6 +60,10 @@ TB_MANUALWIRE(documentController)
     NSInteger currentVersion = [[self.mainBundle objectForInfoDictionaryKey:qBundleVersionKey] integerValue];
     [self readPreferencesWithCurrentVersion:currentVersion];
 
+#ifndef QM_TRACE
+    self.exportTraceMenuItem.hidden = YES;
+#endif
+
 #ifdef DEBUG
     NSString *template = [NSString stringWithFormat:@"%@%@", NSHomeDirectory(), @"/Projects/qmind/Meta/TestFiles/%d.mm"];
 
@@ -53,6 +74,17 @@ TB_MANUALWIRE(documentController)
 #endif
 }
 
+#ifdef QM_TRACE
+- (void)applicationWillTerminate:(NSNotification *)notification {
+    NSString *tracePath = [[NSProcessInfo processInfo] environment][@"QM_TRACE_FILE"];
+    if (tracePath == nil) {
+        return;
+    }
+
+    QMTraceWriteChromeTraceToUrl([NSURL fileURLWithPath:tracePath]);
+}
+#endif
+
 #pragma mark Private
 - (void)readPreferencesWithCurrentVersion:(NSInteger)currentVersion {
     NSInteger versionOfDefaults = [self.userDefaults integerForKey:qDefaultsVersionKey];
@@ -8,6 +8,7 @@
 
 #import <Cocoa/Cocoa.h>
 #import <TBCacao/TBCacao.h>
+#import "QMLayoutCore.h"
 
 extern NSString * const qSettingInternodeHorizontalDistance;
 extern NSString * const qSettingInternodeVerticalDistance;
@@ -50,6 +51,8 @@ extern NSString * const qSettingFoldingMarkerLineWidth;
 extern NSString * const qSettingCellHorizontalPadding;
 extern NSString * const qSettingCellVerticalPadding;
 
+extern NSString * const qSettingMaxUndoLevels;
+
 /**
 * Application-wide settings for Qmind, eg constatns for drawing. These settings are not persistent for now. They'll be
 * eventually persisted.
@@ -67,4 +70,9 @@ extern NSString * const qSettingCellVerticalPadding;
 */
 - (CGFloat)floatForKey:(NSString *)key;
 
+/**
+* The settings the geometry of cells depends on, for the layout core.
+*/
+@property (readonly) QMLayoutMetrics layoutMetrics;
+
 @end
@@ -51,6 +51,8 @@ NSString *const qSettingFoldingMarkerLineWidth = @"FoldingMarkerLindWidth";
 NSString *const qSettingCellHorizontalPadding = @"CellHorizontalPadding";
 NSString *const qSettingCellVerticalPadding = @"CellVerticalPadding";
 
+NSString *const qSettingMaxUndoLevels = @"MaxUndoLevels";
+
 static const NSUInteger qEscCharacter = 27;
 static const NSUInteger qSpaceCharacter = 0x20;
 
@@ -87,6 +89,7 @@ static inline NSCharacterSet *single_key_charset(NSUInteger charCode) {
   self = [super init];
   if (self) {
     [self initSettingsDict];
+    [self initLayoutMetrics];
   }
 
   return self;
@@ -144,6 +147,8 @@ static inline NSCharacterSet *single_key_charset(NSUInteger charCode) {
       qSettingCellHorizontalPadding : @3,
       qSettingCellVerticalPadding : @3,
 
+      qSettingMaxUndoLevels : @100,
+
       qSettingIconTextDistance : @5,
       qSettingInterIconDistance : @3,
       qSettingIconDrawSize : @16,
@@ -162,6 +167,24 @@ static inline NSCharacterSet *single_key_charset(NSUInteger charCode) {
   }];
 }
 
+- (void)initLayoutMetrics {
+  _layoutMetrics = (QMLayoutMetrics) {
+      .cellHorizontalPadding = [self floatForKey:qSettingCellHorizontalPadding],
+      .cellVerticalPadding = [self floatForKey:qSettingCellVerticalPadding],
+      .iconDrawSize = [self floatForKey:qSettingIconDrawSize],
+      .interIconDistance = [self floatForKey:qSettingInterIconDistance],
+      .iconTextDistance = [self floatForKey:qSettingIconTextDistance],
+      .linkIconDrawSize = [self floatForKey:qSettingLinkIconDrawSize],
+      .linkIconHorizontalMargin = [self floatForKey:qSettingLinkIconHorizontalMargin],
+      .nodeMinWidth = [self floatForKey:qSettingNodeMinWidth],
+      .nodeMinHeight = [self floatForKey:qSettingNodeMinHeight],
+      .internodeHorizontalDistance = [self floatForKey:qSettingInternodeHorizontalDistance],
+      .internodeVerticalDistance = [self floatForKey:qSettingInternodeVerticalDistance],
+      .maxTextNodeWidth = [self floatForKey:qSettingMaxTextNodeWidth],
+      .maxRootCellTextWidth = [self floatForKey:qSettingMaxRootCellTextWidth],
+  };
+}
+
 - (NSFont *)fontawesomeFont {
   NSString *fontPath = [[NSBundle bundleForClass:self.class] pathForResource:@"fontawesome-webfont" ofType:@"ttf"];
   NSData *fontData = [[NSData alloc] initWithContentsOfFile:fontPath];
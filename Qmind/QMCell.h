@@ -16,6 +16,8 @@
 @class QMTextLayoutManager;
 @class QMCellSizeManager;
 @class QMIcon;
+@class QMLayoutContext;
+@class QMTextLayout;
 
 typedef enum {
     QMCellRegionNone = 0,
@@ -169,6 +171,12 @@ typedef enum {
 */
 @property (readonly) NSRect textFrame;
 
+/**
+* The text laid out in the text size, created on the first draw and kept until the text, the font or the text size
+* changes. Thus, repainting, eg when scrolling, does not lay out the text again.
+*/
+@property (readonly) QMTextLayout *textLayout;
+
 /**
 * Size of icons only
 */
@@ -177,10 +185,22 @@ typedef enum {
 @property BOOL needsToRecomputeSize;
 
 /**
-* Designated initializer. If parent is nil, then the cell will most probably be a root node or is being copied.
+* Computes the sizes of all descendants which need to recompute their sizes, the deepest first, such that computing the
+* size of the children family of the receiver does not recurse. Called when the sizes of the receiver are computed.
+*/
+- (void)computeSizesOfDescendantsIfNecessary;
+
+/**
+* Convenience initializer which creates a new QMLayoutContext. Prefer -initWithView:layoutContext: when creating many
+* cells.
 */
 - (id)initWithView:(QMMindmapView *)view;
 
+/**
+* Designated initializer. The beans are taken from the given context, which should be shared by all cells of a view.
+*/
+- (id)initWithView:(QMMindmapView *)view layoutContext:(QMLayoutContext *)layoutContext;
+
 /**
 * Draws the cell and all of its children.
 */
@@ -196,9 +216,16 @@ typedef enum {
 
 /**
 * Returns the index within the parent's array which contains this cell. When this cell is a left cell and a direct
-* child of the root cell, the index is computed from the left children array of the root cell.
+* child of the root cell, this is the index within the left children array of the root cell. Maintained by the
+* mutators of the parent.
+*/
+@property NSUInteger indexWithinParent;
+
+/**
+* Sets the index within parent of the given cells starting from the given index. Every mutator of the children calls
+* this for the part of the array it shifted.
 */
-- (NSUInteger)indexWithinParent;
+- (void)updateIndexesOfChildren:(NSArray *)childCells fromIndex:(NSUInteger)index;
 
 /**
 * Returns parent's children array which contains this cell. When this cell is a direct child of the root cell,
@@ -233,4 +260,9 @@ typedef enum {
 */
 - (void)computeGeometry;
 
+/**
+* Resets the cell to the state of a newly initialized one, keeping the children and icons arrays. Used by QMCellPool.
+*/
+- (void)prepareForReuse;
+
 @end
@@ -15,6 +15,14 @@
 #import "QMRootCell.h"
 #import "QMCellSizeManager.h"
 #import "QMIcon.h"
+#import "QMLayoutContext.h"
+#import "QMTrace.h"
+#import "QMTextLayout.h"
+
+/**
+* Key of the thread dictionary for the arrays of children which are released by the outermost -dealloc, see there.
+*/
+static NSString *const qCellGraveyardKey = @"com.qvacua.qmind.cell-graveyard";
 
 @interface QMCell ()
 
@@ -29,10 +37,15 @@
 @implementation QMCell {
     NSMutableArray *_children;
     BOOL _left;
+    NSUInteger _indexWithinParent;
 
     NSBezierPath *_line;
     NSAttributedString *_attributedString;
     NSFont *_font;
+    /**
+    * Weak since QMTextLayoutManager keeps only the recently drawn layouts alive.
+    */
+    __weak QMTextLayout *_textLayout;
     NSMutableArray *_icons;
 
     BOOL _folded;
@@ -51,11 +64,13 @@
 @dynamic iconSize;
 @dynamic textSize;
 @dynamic textFrame;
+@dynamic textLayout;
 @dynamic folded;
 @dynamic familySize;
 @dynamic needsToRecomputeSize;
 @dynamic mutableChildren;
 @dynamic mutableIcons;
+@dynamic indexWithinParent;
 
 #pragma mark Public
 - (BOOL)needsToRecomputeSize {
@@ -64,6 +79,11 @@
     }
 }
 
+/**
+* The family sizes of all ancestors depend on the size of the receiver, thus, we mark them as well. An ancestor which is
+* already marked has all its ancestors marked. We walk up the parents instead of using the setter of the parent to not
+* nest the locks of all ancestors.
+*/
 - (void)setNeedsToRecomputeSize:(BOOL)flag {
     @synchronized (self) {
         if (_needsToRecomputeSize == flag) {
@@ -71,9 +91,19 @@
         }
 
         _needsToRecomputeSize = flag;
+    }
 
-        if (flag == YES) {
-            self.parent.needsToRecomputeSize = YES;
+    if (flag == NO) {
+        return;
+    }
+
+    for (QMCell *cell = self.parent; cell != nil; cell = cell.parent) {
+        @synchronized (cell) {
+            if (cell->_needsToRecomputeSize) {
+                return;
+            }
+
+            cell->_needsToRecomputeSize = YES;
         }
     }
 }
@@ -153,6 +183,24 @@
     }
 }
 
+- (QMTextLayout *)textLayout {
+    @synchronized (self) {
+        NSSize textSize = self.textSize;
+        QMTextLayout *textLayout = _textLayout;
+
+        if (![textLayout isLayoutOfAttributedString:_attributedString containerSize:textSize]) {
+            QM_TRACE_COUNT("text layout cache misses", 1);
+            textLayout = [self.textLayoutManager textLayoutOfAttributedString:_attributedString containerSize:textSize];
+            _textLayout = textLayout;
+        } else {
+            QM_TRACE_COUNT("text layout cache hits", 1);
+            [self.textLayoutManager touchTextLayout:textLayout];
+        }
+
+        return textLayout;
+    }
+}
+
 - (NSRect)familyFrame {
     @synchronized (self) {
         return NewRectWithOriginAndSize(self.familyOrigin, self.familySize);
@@ -164,14 +212,23 @@
 }
 
 - (void)drawRect:(NSRect)dirtyRect {
-    [self.cellDrawer drawCell:self rect:dirtyRect];
+    QMStack *cellStack = [[NSMutableArray alloc] initWithCapacity:15];
+    [cellStack push:self];
 
-    if (self.leaf || self.folded) {
-        return;
-    }
+    while (cellStack.count > 0) {
+        QMCell *cell = [cellStack pop];
+
+        QM_TRACE_COUNT("cells drawn", 1);
+        [self.cellDrawer drawCell:cell rect:dirtyRect];
 
-    for (QMCell *childCell in self.children) {
-        [childCell drawRect:dirtyRect];
+        if (cell.leaf || cell.folded) {
+            continue;
+        }
+
+        // using all children here, we've covered also the root cell; the first child is drawn first
+        for (QMCell *childCell in cell.allChildren.reverseObjectEnumerator) {
+            [cellStack push:childCell];
+        }
     }
 }
 
@@ -180,8 +237,7 @@
 }
 
 - (void)removeChild:(QMCell *)childCell {
-    const NSUInteger indexOfObject = [self.children indexOfObject:childCell];
-    [self removeObjectFromChildrenAtIndex:indexOfObject];
+    [self removeObjectFromChildrenAtIndex:[self indexOfChild:childCell]];
 }
 
 - (NSArray *)allChildren {
@@ -258,6 +314,7 @@
     childCell.parent = self;
     childCell.left = self.isLeft;
     [self.mutableChildren insertObject:childCell atIndex:index];
+    [self updateIndexesOfChildren:_children fromIndex:index];
 
     self.needsToRecomputeSize = YES;
 }
@@ -268,6 +325,7 @@
     cellToDel.left = NO;
 
     [self.mutableChildren removeObjectAtIndex:index];
+    [self updateIndexesOfChildren:_children fromIndex:index];
 
     self.needsToRecomputeSize = YES;
 }
@@ -277,11 +335,29 @@
 }
 
 - (NSUInteger)indexOfChild:(QMCell *)childCell {
-    return [self.children indexOfObject:childCell];
+    if (childCell.parent != self) {
+        return NSNotFound;
+    }
+
+    return childCell.indexWithinParent;
 }
 
 - (NSUInteger)indexWithinParent {
-    return [self.parent indexOfChild:self];
+    @synchronized (self) {
+        return _indexWithinParent;
+    }
+}
+
+- (void)setIndexWithinParent:(NSUInteger)index {
+    @synchronized (self) {
+        _indexWithinParent = index;
+    }
+}
+
+- (void)updateIndexesOfChildren:(NSArray *)childCells fromIndex:(NSUInteger)index {
+    for (NSUInteger i = index; i < childCells.count; i++) {
+        [childCells[i] setIndexWithinParent:i];
+    }
 }
 
 - (QMIcon *)objectInIconsAtIndex:(NSUInteger)index {
@@ -336,13 +412,98 @@
     [self.cellLayoutManager computeGeometryAndLinesOfCell:self];
 }
 
+- (void)prepareForReuse {
+    @synchronized (self) {
+        self.parent = nil;
+        [_children removeAllObjects];
+        [_icons removeAllObjects];
+
+        self.identifier = nil;
+        self.link = nil;
+        _left = NO;
+        _folded = NO;
+        _indexWithinParent = 0;
+
+        _font = nil;
+        _textLayout = nil;
+        self.stringValue = @"";
+
+        self.line = nil;
+        self.dragRegion = QMCellRegionNone;
+        self.origin = NewPoint(0, 0);
+        self.familyOrigin = NewPoint(0, 0);
+        self.textOrigin = NewPoint(0, 0);
+
+        _needsToRecomputeSize = NO;
+        self.needsToRecomputeSize = YES;
+    }
+}
+
+- (void)computeSizesOfDescendantsIfNecessary {
+    NSMutableArray *cells = [[NSMutableArray alloc] init];
+
+    // a cell which does not need to recompute its size has no descendant which needs to, see -setNeedsToRecomputeSize:
+    QMStack *cellStack = [[NSMutableArray alloc] initWithCapacity:15];
+    [cellStack pushArray:self.allChildren];
+    while (cellStack.count > 0) {
+        QMCell *cell = [cellStack pop];
+        if (!cell.needsToRecomputeSize) {
+            continue;
+        }
+
+        [cells addObject:cell];
+        [cellStack pushArray:cell.allChildren];
+    }
+
+    // every cell comes after its ancestors in the array
+    for (QMCell *cell in cells.reverseObjectEnumerator) {
+        @synchronized (cell) {
+            [cell computeAllSizesIfNecessary];
+        }
+    }
+}
+
 #pragma mark NSObject
 - (NSString *)description {
     return self.stringValue.stringByCropping;
 }
 
+/**
+* Releases the children iteratively, see -[QMNode dealloc].
+*/
+- (void)dealloc {
+    if (_children.count == 0) {
+        return;
+    }
+
+    NSMutableDictionary *threadDict = [NSThread currentThread].threadDictionary;
+    NSMutableArray *graveyard = threadDict[qCellGraveyardKey];
+    if (graveyard != nil) {
+        [graveyard addObject:_children];
+        _children = nil;
+
+        return;
+    }
+
+    graveyard = [[NSMutableArray alloc] initWithObjects:_children, nil];
+    _children = nil;
+    threadDict[qCellGraveyardKey] = graveyard;
+
+    while (graveyard.count > 0) {
+        NSArray *children = graveyard.lastObject;
+        [graveyard removeLastObject];
+        children = nil;
+    }
+
+    [threadDict removeObjectForKey:qCellGraveyardKey];
+}
+
 #pragma mark Initializer
 - (id)initWithView:(QMMindmapView *)view {
+    return [self initWithView:view layoutContext:[[QMLayoutContext alloc] init]];
+}
+
+- (id)initWithView:(QMMindmapView *)view layoutContext:(QMLayoutContext *)layoutContext {
     if ((self = [super init])) {
         _view = view;
         _children = [[NSMutableArray alloc] initWithCapacity:3];
@@ -350,12 +511,11 @@
 
         _folded = NO;
 
-        TBContext *context = [TBContext sharedContext];
-        // autowireSeed takes too long...
-        _cellLayoutManager = [context beanWithClass:[QMCellLayoutManager class]];
-        _cellDrawer = [context beanWithClass:[QMCellDrawer class]];
-        _textLayoutManager = [context beanWithClass:[QMTextLayoutManager class]];
-        _cellSizeManager = [context beanWithClass:[QMCellSizeManager class]];
+        // autowireSeed and even -beanWithClass: take too long when done for each cell...
+        _cellLayoutManager = layoutContext.cellLayoutManager;
+        _cellDrawer = layoutContext.cellDrawer;
+        _textLayoutManager = layoutContext.textLayoutManager;
+        _cellSizeManager = layoutContext.cellSizeManager;
 
         self.stringValue = @"";
 
@@ -368,9 +528,13 @@
 #pragma mark Private
 - (void)computeAllSizesIfNecessary {
     if (!self.needsToRecomputeSize) {
+        QM_TRACE_COUNT("text size cache hits", 1);
         return;
     }
 
+    QM_TRACE_COUNT("text size cache misses", 1);
+
+    [self computeSizesOfDescendantsIfNecessary];
     self.needsToRecomputeSize = NO;
 
     _iconSize = [self.cellSizeManager sizeOfIconsOfCell:self];
@@ -27,4 +27,10 @@
 - (void)drawCell:(QMCell *)cell rect:(NSRect)dirtyRect;
 - (void)drawContentForCell:(QMCell *)cell rect:(NSRect)dirtyRect;
 
+/**
+* Returns the rect -drawCell:rect: paints into, ie the frame including the focus ring and the folding marker, and the
+* line of the cell.
+*/
+- (NSRect)displayRectOfCell:(QMCell *)cell;
+
 @end
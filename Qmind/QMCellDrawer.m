@@ -17,6 +17,10 @@
 #import "QMCellLayoutManager.h"
 #import "QMIcon.h"
 
+/**
+* NSSetFocusRingStyle() paints the ring outside of the path.
+*/
+static const CGFloat qFocusRingWidth = 4.0;
 
 @implementation QMCellDrawer
 
@@ -31,7 +35,7 @@ TB_AUTOWIRE(settings)
     [self drawRootEllipseForFrame:cell.frame];
   }
 
-  [self.textDrawer drawAttributedString:cell.attributedString inRect:cell.textFrame range:cell.rangeOfStringValue];
+  [self.textDrawer drawTextLayout:cell.textLayout range:cell.rangeOfStringValue atPoint:cell.textOrigin];
   [self drawIconsForCell:cell rect:dirtyRect];
 }
 
@@ -53,6 +57,21 @@ TB_AUTOWIRE(settings)
   [self drawMetaInfoForCell:cell];
 }
 
+- (NSRect)displayRectOfCell:(QMCell *)cell {
+  CGFloat focusRingMargin = [self.settings floatForKey:qSettingNodeFocusRingMargin] + qFocusRingWidth;
+  CGFloat foldingMarkerMargin = [self.settings floatForKey:qSettingFoldingMarkerRadius] / 2
+      + [self.settings floatForKey:qSettingFoldingMarkerLineWidth];
+
+  CGFloat margin = MAX(focusRingMargin, foldingMarkerMargin);
+  NSRect result = NewRectExpanding(cell.frame, margin, margin);
+
+  if (cell.line != nil) {
+    result = NSUnionRect(result, NewRectExpanding(cell.line.bounds, 1, 1));
+  }
+
+  return result;
+}
+
 #pragma mark Private
 - (void)drawRegionForCell:(QMCell *)cell {
   if (cell.dragRegion == QMCellRegionNone) {
@@ -13,6 +13,7 @@
 #import "QMCell.h"
 #import "QMAppSettings.h"
 #import "QMBorderedView.h"
+#import "QMDamageTracker.h"
 
 
 static NSInteger const qEscUnicode = 27;
@@ -97,11 +98,16 @@ TB_MANUALWIRE(settings)
   [self.view scrollRectToVisible:self.editorView.frame];
   [self.view.window makeFirstResponder:self.textField];
 
-  [self.view setNeedsDisplay:YES];
+  [self.view.damageTracker addCell:cellToEdit];
+  [self.view.damageTracker addRect:self.editorView.frame];
+  [self.view.damageTracker invalidateView:self.view];
 }
 
 #pragma mark NSControlSubclassNotifications
 - (void)controlTextDidEndEditing:(NSNotification *)notification {
+  QMCell *editedCell = self.currentlyEditedCell;
+  NSRect editorFrame = self.editorView.frame;
+
   NSAttributedString *attrString = [[NSAttributedString alloc] initWithAttributedString:self.textField.attributedStringValue];
 
   if (self.editingCanceled) {
@@ -127,7 +133,10 @@ TB_MANUALWIRE(settings)
   self.editorView.hidden = YES;
 
   [self.view.window makeFirstResponder:self.view];
-  [self.view setNeedsDisplay:YES];
+
+  [self.view.damageTracker addCell:editedCell];
+  [self.view.damageTracker addRect:editorFrame];
+  [self.view.damageTracker invalidateView:self.view];
 }
 
 #pragma mark NSControlTextEditingDelegate
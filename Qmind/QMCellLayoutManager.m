@@ -11,6 +11,8 @@
 #import "QMAppSettings.h"
 #import "QMRootCell.h"
 #import "QMIcon.h"
+#import "QMTrace.h"
+#import "QMLayoutCoreCocoa.h"
 
 @implementation QMCellLayoutManager
 
@@ -48,57 +50,42 @@ TB_AUTOWIRE(settings)
 }
 
 - (NSRect)regionFrameOfCell:(QMCell *)cell ofRegion:(QMCellRegion)region {
-    NSSize size = cell.size;
-    CGFloat width = size.width;
-    CGFloat height = size.height;
+    QMLayoutRect frame = QMLayoutRectFromNSRect(cell.frame);
 
-    if ([cell isRoot]) {
-        switch (region) {
-            case QMCellRegionEast:
-                return NewRect(cell.origin.x + width / 2, cell.origin.y, width / 2, height);
-            case QMCellRegionWest:
-                return NewRect(cell.origin.x, cell.origin.y, width / 2, height);
-            default:
-                return NSZeroRect;
-        }
-    }
-
-    if ([cell isLeft]) {
-        switch (region) {
-            case QMCellRegionWest:
-                return NewRectWithOrigin(cell.origin, width / 2, height);
-            case QMCellRegionSouth:
-                return NewRect(cell.origin.x + width / 2, cell.origin.y + height / 2, width / 2, height / 2);
-            case QMCellRegionNorth:
-                return NewRect(cell.origin.x + width / 2, cell.origin.y, width / 2, height / 2);
-            default:
-                return NSZeroRect;
-        }
-    }
-
-    switch (region) {
-        case QMCellRegionEast:
-            return NewRect(cell.origin.x + width / 2, cell.origin.y, width / 2, height);
-        case QMCellRegionSouth:
-            return NewRect(cell.origin.x, cell.origin.y + height / 2, width / 2, height / 2);
-        case QMCellRegionNorth:
-            return NewRectWithOrigin(cell.origin, width / 2, height / 2);
-        default:
-            return NSZeroRect;
-    }
+    return NSRectFromQMLayoutRect(QMLayoutRegionFrameOfCell(QMLayoutCellKindOfCell(cell), frame, (QMLayoutRegion) region));
 }
 
+/**
+* Lays out the cells top-down with an explicit stack: when a cell is popped, its origin is known and the families of its
+* children are stacked. Thus, the depth of the map is not limited by the call stack. The descendants of folded cells
+* get their origins, but neither text origins nor lines.
+*/
 - (void)computeGeometryAndLinesOfCell:(QMCell *)cell {
+    QM_TRACE_SCOPE("compute geometry");
+
     [self computeOriginOfCell:cell];
-    [self computeOriginOfChildrenFamilyOfCell:cell];
-    if (cell.isRoot) {
-        [self computeOriginOfLeftChildrenFamilyOfCell:cell];
-    }
 
-    [self computeIconsOriginOfCell:cell];
-    [self computeTextOriginOfCell:cell];
+    QMStack *cellStack = [[NSMutableArray alloc] initWithCapacity:15];
+    [cellStack push:@[cell, @NO]];
+
+    while (cellStack.count > 0) {
+        NSArray *entry = [cellStack pop];
+        QMCell *currentCell = entry[0];
+        BOOL hidden = [entry[1] boolValue];
+
+        [self computeOriginOfChildrenFamilyOfCell:currentCell];
+        [self computeIconsOriginOfCell:currentCell];
+
+        if (!hidden) {
+            [self computeTextOriginOfCell:currentCell];
+            [self computeLinesOfCell:currentCell];
+        }
 
-    [self computeLinesOfCell:cell];
+        NSNumber *childrenHidden = @(hidden || currentCell.isFolded);
+        for (QMCell *childCell in currentCell.allChildren) {
+            [cellStack push:@[childCell, childrenHidden]];
+        }
+    }
 }
 
 #pragma mark Private
@@ -259,17 +246,9 @@ TB_AUTOWIRE(settings)
 
     [self addLinesToChildrenForCell:cell path:path];
     cell.line = path;
-
-    for (QMCell *childCell in [cell allChildren]) {
-        [self computeLinesOfCell:childCell];
-    }
 }
 
 - (void)computeIconsOriginOfCell:(QMCell *)cell {
-    [cell.allChildren enumerateObjectsUsingBlock:^(QMCell *childCell, NSUInteger index, BOOL *stop) {
-        [self computeIconsOriginOfCell:childCell];
-    }];
-
     NSArray *icons = cell.icons;
     if ([icons count] == 0) {
         return;
@@ -321,14 +300,6 @@ TB_AUTOWIRE(settings)
 
 - (void)computeTextOriginOfCell:(QMCell *)cell {
     cell.textOrigin = [self textOriginOfCell:cell inFrame:cell.frame];
-
-    if (cell.isLeaf || cell.isFolded) {
-        return;
-    }
-
-    for (QMCell *childCell in cell.allChildren) {
-        [self computeTextOriginOfCell:childCell];
-    }
 }
 
 /**
@@ -336,159 +307,89 @@ TB_AUTOWIRE(settings)
 * @param all sizes of self and its children
 */
 - (void)computeOriginOfCell:(QMCell *)cell {
-    CGFloat interNodeHorDist = [_settings floatForKey:qSettingInternodeHorizontalDistance];
-
-    NSSize size = cell.size;
-    NSSize familySize = cell.familySize;
-    NSPoint familyOrigin = cell.familyOrigin;
+    QM_TRACE_COUNT("cells laid out", 1);
 
+    NSUInteger countOfLeftChildren = 0;
+    QMLayoutSize leftChildrenFamilySize = {0, 0};
     if ([cell isRoot]) {
         QMRootCell *rootCell = (QMRootCell *) cell;
-        if (rootCell.countOfLeftChildren == 0) {
-            if (size.height < familySize.height) {
-                rootCell.origin = NewPoint(familyOrigin.x, familyOrigin.y + familySize.height / 2 - size.height / 2);
-            } else {
-                rootCell.origin = NewPoint(familyOrigin.x, familyOrigin.y);
-            }
-        } else {
-            if (size.height < familySize.height) {
-                rootCell.origin = NewPoint(familyOrigin.x + rootCell.leftChildrenFamilySize.width + interNodeHorDist, familyOrigin.y + familySize.height / 2 - size.height / 2);
-            } else {
-                rootCell.origin = NewPoint(familyOrigin.x + rootCell.leftChildrenFamilySize.width + interNodeHorDist, familyOrigin.y);
-            }
-        }
-
-        return;
-    }
 
-    if ([cell isLeft]) {
-        if (size.height < familySize.height) {
-            cell.origin = NewPoint(cell.parent.origin.x - interNodeHorDist - size.width, familyOrigin.y + familySize.height / 2 - size.height / 2);
-        } else {
-            cell.origin = NewPoint(cell.parent.origin.x - interNodeHorDist - size.width, familyOrigin.y);
+        countOfLeftChildren = rootCell.countOfLeftChildren;
+        if (countOfLeftChildren > 0) {
+            leftChildrenFamilySize = QMLayoutSizeFromNSSize(rootCell.leftChildrenFamilySize);
         }
-
-        return;
-    }
-
-    if (size.height < familySize.height) {
-        cell.origin = NewPoint(familyOrigin.x, familyOrigin.y + familySize.height / 2 - size.height / 2);
-    } else {
-        cell.origin = NewPoint(familyOrigin.x, familyOrigin.y);
     }
-}
 
-- (void)computeOriginOfLeftChildrenFamilyOfCell:(QMCell *)cell {
-    NSArray *children;
-    if (cell.isRoot) {
-        children = [(QMRootCell *) cell leftChildren];
-    } else {
-        children = cell.children;
+    QMLayoutPoint parentOrigin = {0, 0};
+    if (![cell isRoot]) {
+        parentOrigin = QMLayoutPointFromNSPoint(cell.parent.origin);
     }
 
-    CGFloat vertDistance = [_settings floatForKey:qSettingInternodeVerticalDistance];
+    QMLayoutMetrics metrics = _settings.layoutMetrics;
+    QMLayoutPoint origin = QMLayoutOriginOfCell(&metrics, QMLayoutCellKindOfCell(cell), QMLayoutSizeFromNSSize(cell.size),
+            QMLayoutSizeFromNSSize(cell.familySize), QMLayoutPointFromNSPoint(cell.familyOrigin), parentOrigin,
+            countOfLeftChildren, leftChildrenFamilySize);
 
-    NSPoint midPoint = cell.middlePoint;
-
-    if (children.count == 1) {
+    cell.origin = NSPointFromQMLayoutPoint(origin);
+}
 
-        QMCell *childCell = [children objectAtIndex:0];
+/**
+* The families of right children start right of the cell, the ones of left children at the family origin of the cell.
+*/
+- (void)computeOriginOfChildrenFamilyOfCell:(QMCell *)cell {
+    CGFloat rightX = cell.origin.x + cell.size.width + [_settings floatForKey:qSettingInternodeHorizontalDistance];
 
-        childCell.familyOrigin = NewPoint(cell.familyOrigin.x, midPoint.y - childCell.familySize.height / 2);
+    if (cell.isRoot) {
+        QMRootCell *rootCell = (QMRootCell *) cell;
 
-        [self computeOriginOfCell:childCell];
-        [self computeOriginOfLeftChildrenFamilyOfCell:childCell];
+        [self computeFamilyOriginOfChildren:rootCell.children ofCell:rootCell childrenFamilySize:rootCell.childrenFamilySize x:rightX];
+        [self computeFamilyOriginOfChildren:rootCell.leftChildren ofCell:rootCell childrenFamilySize:rootCell.leftChildrenFamilySize x:rootCell.familyOrigin.x];
 
         return;
     }
 
-    NSSize childrenFamilySize;
-    if (cell.isRoot) {
-        childrenFamilySize = [(QMRootCell *) cell leftChildrenFamilySize];
-    } else {
-        childrenFamilySize = cell.childrenFamilySize;
-    }
-
-    [children enumerateObjectsUsingBlock:^(QMCell *childCell, NSUInteger index, BOOL *stop) {
-        if (index == 0) {
-            childCell.familyOrigin = NewPoint(cell.familyOrigin.x, midPoint.y - childrenFamilySize.height / 2);
-        } else {
-            QMCell *prevCell = [children objectAtIndex:index - 1];
-            childCell.familyOrigin = NewPoint(cell.familyOrigin.x, prevCell.familyOrigin.y + prevCell.familySize.height + vertDistance);
-        }
-
-        [self computeOriginOfCell:childCell];
-        [self computeOriginOfLeftChildrenFamilyOfCell:childCell];
-    }];
+    CGFloat x = cell.isLeft ? cell.familyOrigin.x : rightX;
+    [self computeFamilyOriginOfChildren:cell.children ofCell:cell childrenFamilySize:cell.childrenFamilySize x:x];
 }
 
-- (void)computeOriginOfChildrenFamilyOfCell:(QMCell *)cell {
-    NSArray *children = cell.children;
-
-    CGFloat horDistance = [_settings floatForKey:qSettingInternodeHorizontalDistance];
-    CGFloat vertDistance = [_settings floatForKey:qSettingInternodeVerticalDistance];
-
-    NSSize size = cell.size;
-    NSPoint midPoint = cell.middlePoint;
-
-    if (children.count == 1) {
-
-        QMCell *childCell = [children objectAtIndex:0];
+/**
+* Stacks the families of the children at the given x and computes the origin of each child cell.
+*/
+- (void)computeFamilyOriginOfChildren:(NSArray *)children ofCell:(QMCell *)cell childrenFamilySize:(NSSize)childrenFamilySize x:(CGFloat)x {
+    QMLayoutMetrics metrics = _settings.layoutMetrics;
+    NSUInteger countOfChildren = children.count;
+    CGFloat middleY = cell.middlePoint.y;
+
+    QMCell *prevCell = nil;
+    NSUInteger index = 0;
+    for (QMCell *childCell in children) {
+        QMLayoutPoint familyOriginOfPrevCell = {0, 0};
+        QMLayoutSize familySizeOfPrevCell = {0, 0};
+        if (prevCell != nil) {
+            familyOriginOfPrevCell = QMLayoutPointFromNSPoint(prevCell.familyOrigin);
+            familySizeOfPrevCell = QMLayoutSizeFromNSSize(prevCell.familySize);
+        }
 
-        childCell.familyOrigin = NewPoint(cell.origin.x + size.width + horDistance, midPoint.y - childCell.familySize.height / 2);
+        QMLayoutPoint familyOrigin = QMLayoutFamilyOriginOfChild(&metrics, x, middleY, countOfChildren,
+                QMLayoutSizeFromNSSize(childrenFamilySize), index, QMLayoutSizeFromNSSize(childCell.familySize),
+                familyOriginOfPrevCell, familySizeOfPrevCell);
+        childCell.familyOrigin = NSPointFromQMLayoutPoint(familyOrigin);
 
         [self computeOriginOfCell:childCell];
-        [self computeOriginOfChildrenFamilyOfCell:childCell];
 
-        return;
+        prevCell = childCell;
+        index++;
     }
-
-    [children enumerateObjectsUsingBlock:^(QMCell *childCell, NSUInteger index, BOOL *stop) {
-        if (index == 0) {
-            childCell.familyOrigin = NewPoint(cell.origin.x + size.width + horDistance, midPoint.y - cell.childrenFamilySize.height / 2);
-        } else {
-            QMCell *prevCell = [children objectAtIndex:index - 1];
-            childCell.familyOrigin = NewPoint(cell.origin.x + size.width + horDistance, prevCell.familyOrigin.y + prevCell.familySize.height + vertDistance);
-        }
-
-        [self computeOriginOfCell:childCell];
-        [self computeOriginOfChildrenFamilyOfCell:childCell];
-    }];
 }
 
 - (NSPoint)textOriginOfCell:(QMCell *)cell inFrame:(NSRect)frame {
-    CGFloat horPadding = [_settings floatForKey:qSettingCellHorizontalPadding];
-    CGFloat vertPadding = [_settings floatForKey:qSettingCellVerticalPadding];
-    CGFloat iconTextDist = cell.countOfIcons > 0 ? [_settings floatForKey:qSettingIconTextDistance] : 0;
-
-    NSSize iconSize = cell.iconSize;
-    NSSize textSize = cell.textSize;
-    NSSize size = cell.size;
-    NSPoint origin = frame.origin;
+    QMLayoutMetrics metrics = _settings.layoutMetrics;
 
-    CGFloat dy = size.height - textSize.height;
+    QMLayoutPoint textOrigin = QMLayoutTextOriginOfCell(&metrics, QMLayoutCellKindOfCell(cell), QMLayoutRectFromNSRect(frame),
+            QMLayoutSizeFromNSSize(cell.textSize), QMLayoutSizeFromNSSize(cell.iconSize), cell.countOfIcons,
+            cell.stringValue.length > 0);
 
-    if ([cell isRoot]) {
-        if ([cell.stringValue length] == 0) {
-            return NewPoint(origin.x + horPadding, origin.y + vertPadding);
-        } else {
-            return NewPoint(cell.middlePoint.x - (iconSize.width + iconTextDist + cell.textSize.width) / 2 + iconSize.width + iconTextDist, origin.y + dy / 2);
-        }
-    }
-
-    if ([cell isLeft]) {
-        if ([cell.stringValue length] == 0) {
-            return NewPoint(origin.x + horPadding, origin.y + vertPadding);
-        } else {
-            return NewPoint(origin.x + horPadding, origin.y + dy / 2);
-        }
-    }
-
-    if ([cell.stringValue length] == 0) {
-        return NewPoint(origin.x + horPadding, origin.y + vertPadding);
-    } else {
-        return NewPoint(origin.x + horPadding + iconSize.width + iconTextDist, origin.y + dy / 2);
-    }
+    return NSPointFromQMLayoutPoint(textOrigin);
 }
 
 @end
@@ -0,0 +1,55 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import <Foundation/Foundation.h>
+
+@class QMCell;
+@class QMMindmapView;
+@class QMLayoutContext;
+
+/**
+* Per-view pool of cells: when the view is rebuilt, the cells of the old tree are reset and handed out again instead of
+* being deallocated one by one and allocated anew. The root cell is not pooled.
+*/
+@interface QMCellPool : NSObject
+
+@property (readonly, weak) QMMindmapView *view;
+@property (readonly) QMLayoutContext *layoutContext;
+
+/**
+* Number of cells allocated since the creation of the pool.
+*/
+@property (readonly) NSUInteger countOfAllocatedCells;
+
+/**
+* Number of cells handed out again since the creation of the pool.
+*/
+@property (readonly) NSUInteger countOfReusedCells;
+
+@property (readonly) NSUInteger countOfPooledCells;
+
+- (id)initWithView:(QMMindmapView *)view layoutContext:(QMLayoutContext *)layoutContext;
+
+/**
+* Returns a pooled cell or a new one when the pool is empty.
+*/
+- (QMCell *)cell;
+
+/**
+* Resets all descendants of the given cell and puts them into the pool. The cell itself and its descendants must not
+* be used anymore afterwards.
+*/
+- (void)recycleDescendantsOfCell:(QMCell *)cell;
+
+/**
+* Releases pooled cells such that at most as many cells as in the tree of the given cell are left, eg after the view
+* has been rebuilt. Thus, a small map does not keep the cells of a bigger previous one alive.
+*/
+- (void)trimToSizeOfTreeOfCell:(QMCell *)cell;
+
+@end
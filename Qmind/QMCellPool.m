@@ -0,0 +1,87 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import <Qkit/Qkit.h>
+#import "QMCellPool.h"
+#import "QMCell.h"
+#import "QMTrace.h"
+
+@implementation QMCellPool {
+    NSMutableArray *_pooledCells;
+}
+
+#pragma mark Public
+- (NSUInteger)countOfPooledCells {
+    return _pooledCells.count;
+}
+
+- (QMCell *)cell {
+    QMCell *cell = _pooledCells.lastObject;
+
+    if (cell == nil) {
+        QM_TRACE_COUNT("cells allocated", 1);
+        _countOfAllocatedCells++;
+
+        return [[QMCell alloc] initWithView:self.view layoutContext:self.layoutContext];
+    }
+
+    QM_TRACE_COUNT("cells reused", 1);
+    _countOfReusedCells++;
+
+    [_pooledCells removeLastObject];
+    return cell;
+}
+
+- (void)recycleDescendantsOfCell:(QMCell *)cell {
+    QMStack *cellStack = [[NSMutableArray alloc] initWithCapacity:15];
+    [cellStack pushArray:cell.allChildren];
+
+    while (cellStack.count > 0) {
+        QMCell *currentCell = [cellStack pop];
+        [cellStack pushArray:currentCell.allChildren];
+
+        [currentCell prepareForReuse];
+        [_pooledCells addObject:currentCell];
+    }
+}
+
+- (void)trimToSizeOfTreeOfCell:(QMCell *)cell {
+    if (_pooledCells.count == 0) {
+        return;
+    }
+
+    // we only have to count until the pool is not bigger than the tree
+    NSUInteger countOfCells = 0;
+    QMStack *cellStack = [[NSMutableArray alloc] initWithCapacity:15];
+    [cellStack push:cell];
+
+    while (cellStack.count > 0 && countOfCells < _pooledCells.count) {
+        QMCell *currentCell = [cellStack pop];
+        [cellStack pushArray:currentCell.allChildren];
+
+        countOfCells++;
+    }
+
+    if (countOfCells < _pooledCells.count) {
+        QM_TRACE_COUNT("pooled cells released", _pooledCells.count - countOfCells);
+        [_pooledCells removeObjectsInRange:NSMakeRange(countOfCells, _pooledCells.count - countOfCells)];
+    }
+}
+
+#pragma mark Initializer
+- (id)initWithView:(QMMindmapView *)view layoutContext:(QMLayoutContext *)layoutContext {
+    if ((self = [super init])) {
+        _view = view;
+        _layoutContext = layoutContext;
+        _pooledCells = [[NSMutableArray alloc] init];
+    }
+
+    return self;
+}
+
+@end
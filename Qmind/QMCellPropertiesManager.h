@@ -11,9 +11,21 @@
 @protocol QMMindmapViewDataSource;
 @class QMCell;
 @class QMMindmapView;
+@class QMLayoutContext;
+@class QMCellPool;
 
 @interface QMCellPropertiesManager : NSObject
 
+/**
+* The context handed to all cells created by this manager.
+*/
+@property (readonly) QMLayoutContext *layoutContext;
+
+/**
+* When set, the non-root cells are taken from this pool.
+*/
+@property QMCellPool *cellPool;
+
 /**
 * Init for Quick Look plugin for which we don't need the view.
 */
@@ -11,6 +11,9 @@
 #import "QMMindmapViewDataSource.h"
 #import "QMRootCell.h"
 #import "QMMindmapView.h"
+#import "QMLayoutContext.h"
+#import "QMCellPool.h"
+#import <Qkit/Qkit.h>
 
 @interface QMCellPropertiesManager ()
 
@@ -27,6 +30,8 @@
     if (self) {
         _view = view;
         _dataSource = _view.dataSource;
+        _layoutContext = _view.layoutContext ?: [[QMLayoutContext alloc] init];
+        _cellPool = _view.cellPool;
     }
 
     return self;
@@ -37,31 +42,14 @@
     if (self) {
         _view = nil;
         _dataSource = dataSource;
+        _layoutContext = [[QMLayoutContext alloc] init];
     }
 
     return self;
 }
 
 - (QMCell *)cellWithParent:(QMCell *)parentCell itemOfParent:(id)itemOfParent {
-    QMCell *cell;
-
-    if (itemOfParent == nil) {
-        QMRootCell *rootCell = [[QMRootCell alloc] initWithView:self.view];
-        cell = rootCell;
-    } else {
-        cell = [[QMCell alloc] initWithView:self.view];
-
-        if (parentCell.isRoot) {
-            BOOL isItemLeft = [self.dataSource mindmapView:self.view isItemLeft:itemOfParent];
-            if (isItemLeft) {
-                [(QMRootCell *) parentCell addObjectInLeftChildren:cell];
-            } else {
-                [parentCell addObjectInChildren:cell];
-            }
-        } else {
-            [parentCell addObjectInChildren:cell];
-        }
-    }
+    QMCell *cell = [self newCellWithParent:parentCell itemOfParent:itemOfParent];
 
     [self fillCellPropertiesWithIdentifier:itemOfParent cell:cell];
     [self fillAllChildrenWithIdentifier:itemOfParent cell:cell];
@@ -85,22 +73,67 @@
     }
 }
 
+/**
+* The stack contains pairs of the parent cell and the item of the cell to create, such that the depth of the map is not
+* limited by the call stack. The cells are added to their parents in the same order as when recursing.
+*/
 - (void)fillAllChildrenWithIdentifier:(id)givenItem cell:(QMCell *)cell {
-    NSInteger childrenCount = [self.dataSource mindmapView:self.view numberOfChildrenOfItem:givenItem];
-    for (NSUInteger i = 0; i < childrenCount; i++) {
-        id childItem = [self.dataSource mindmapView:self.view child:i ofItem:givenItem];
-        [self cellWithParent:cell itemOfParent:childItem];
+    QMStack *stack = [[NSMutableArray alloc] initWithCapacity:15];
+    [self pushChildItemsOfItem:givenItem cell:cell toStack:stack];
+
+    while (stack.count > 0) {
+        NSArray *entry = [stack pop];
+        QMCell *parentCell = entry[0];
+        id item = entry[1];
+
+        QMCell *childCell = [self newCellWithParent:parentCell itemOfParent:item];
+        [self fillCellPropertiesWithIdentifier:item cell:childCell];
+
+        [self pushChildItemsOfItem:item cell:childCell toStack:stack];
+    }
+}
+
+#pragma mark Private
+/**
+* Pushes the children in reverse order and the left children before the children, such that the first child is popped
+* first.
+*/
+- (void)pushChildItemsOfItem:(id)item cell:(QMCell *)cell toStack:(QMStack *)stack {
+    if (cell.root) {
+        NSInteger leftChildrenCount = [self.dataSource mindmapView:self.view numberOfLeftChildrenOfItem:item];
+        for (NSInteger i = leftChildrenCount - 1; i >= 0; i--) {
+            [stack push:@[cell, [self.dataSource mindmapView:self.view leftChild:i ofItem:item]]];
+        }
     }
 
-    if (!cell.root) {
-        return;
+    NSInteger childrenCount = [self.dataSource mindmapView:self.view numberOfChildrenOfItem:item];
+    for (NSInteger i = childrenCount - 1; i >= 0; i--) {
+        [stack push:@[cell, [self.dataSource mindmapView:self.view child:i ofItem:item]]];
     }
+}
 
-    NSInteger leftChildrenCount = [self.dataSource mindmapView:self.view numberOfLeftChildrenOfItem:givenItem];
-    for (NSUInteger i = 0; i < leftChildrenCount; i++) {
-        id childItem = [self.dataSource mindmapView:self.view leftChild:i ofItem:givenItem];
-        [self cellWithParent:cell itemOfParent:childItem];
+- (QMCell *)newCellWithParent:(QMCell *)parentCell itemOfParent:(id)itemOfParent {
+    if (itemOfParent == nil) {
+        return [[QMRootCell alloc] initWithView:self.view layoutContext:self.layoutContext];
+    }
+
+    QMCell *cell = [self newCell];
+
+    if (parentCell.isRoot && [self.dataSource mindmapView:self.view isItemLeft:itemOfParent]) {
+        [(QMRootCell *) parentCell addObjectInLeftChildren:cell];
+    } else {
+        [parentCell addObjectInChildren:cell];
     }
+
+    return cell;
+}
+
+- (QMCell *)newCell {
+    if (self.cellPool != nil) {
+        return [self.cellPool cell];
+    }
+
+    return [[QMCell alloc] initWithView:self.view layoutContext:self.layoutContext];
 }
 
 @end
@@ -10,6 +10,7 @@
 #import <TBCacao/TBCacao.h>
 #import "QMCellSelector.h"
 #import "QMCell.h"
+#import "QMTrace.h"
 
 
 @implementation QMCellSelector
@@ -26,6 +27,7 @@
 
 - (QMCell *)traverseCell:(QMCell *)parentCell usingBlock:(void (^)(QMCell *cell , BOOL *stop))block {
     // pre-order traversal
+    QM_TRACE_SCOPE("cell selector walk");
 
     BOOL stop = NO;
 
@@ -35,6 +37,7 @@
     __weak QMCell *currentCell;
     while (nodeStack.count > 0) {
         currentCell = [nodeStack pop];
+        QM_TRACE_COUNT("cells visited", 1);
 
         if (currentCell.isLeaf == NO && currentCell.isFolded == NO) {
             [nodeStack pushArray:currentCell.allChildren];
@@ -13,6 +13,8 @@
 #import "QMTextLayoutManager.h"
 #import "QMAppSettings.h"
 #import "QMRootCell.h"
+#import "QMTrace.h"
+#import "QMLayoutCoreCocoa.h"
 
 
 @implementation QMCellSizeManager
@@ -22,54 +24,20 @@ TB_AUTOWIRE(settings)
 
 #pragma mark Public
 - (NSSize)sizeOfCell:(QMCell *)cell {
-    NSSize textSize = cell.textSize;
-    NSSize iconSize = cell.iconSize;
+    QM_TRACE_COUNT("cell sizes computed", 1);
 
-    NSSize result = textSize;
+    QMLayoutMetrics metrics = self.settings.layoutMetrics;
+    QMLayoutSize size = QMLayoutSizeOfCell(&metrics, QMLayoutCellKindOfCell(cell),
+            QMLayoutSizeFromNSSize(cell.textSize), QMLayoutSizeFromNSSize(cell.iconSize), cell.countOfIcons,
+            cell.stringValue.length > 0, cell.link != nil);
 
-    NSUInteger countOfIcons = cell.countOfIcons;
-    BOOL trivialStringValue = [cell.stringValue length] == 0;
-    if (countOfIcons > 0) {
-        result.width += iconSize.width + (trivialStringValue ? 0 : [self.settings floatForKey:qSettingIconTextDistance]);
-
-        if (iconSize.height > result.height) {
-            result.height = iconSize.height;
-        }
-    }
-
-    if (cell.link != nil) {
-        CGFloat linkIconSize = [self.settings floatForKey:qSettingLinkIconDrawSize];
-        result.width += linkIconSize + [self.settings floatForKey:qSettingLinkIconHorizontalMargin];
-        result.height = MAX(linkIconSize, result.height);
-    }
-
-    if (trivialStringValue && countOfIcons == 0) {
-        result.width = [self.settings floatForKey:qSettingNodeMinWidth];
-        result.height = [self.settings floatForKey:qSettingNodeMinHeight];
-    }
-
-    result.width += 2 * [self.settings floatForKey:qSettingCellHorizontalPadding];
-    result.height += 2 * [self.settings floatForKey:qSettingCellVerticalPadding];
-
-    if (cell.root) {
-        return [self sizeOfRootEllipse:result];
-    }
-
-    return result;
+    return NSSizeFromQMLayoutSize(size);
 }
 
 - (NSSize)sizeOfIconsOfCell:(QMCell *)cell {
-    NSUInteger countOfIcons = cell.countOfIcons;
-    if (countOfIcons == 0) {
-        return NewSize(0, 0);
-    }
-
-    const CGFloat iconDrawSize = [self.settings floatForKey:qSettingIconDrawSize];
-    const CGFloat interIconDist = [self.settings floatForKey:qSettingInterIconDistance];
+    QMLayoutMetrics metrics = self.settings.layoutMetrics;
 
-    CGFloat iconWidth = countOfIcons * (iconDrawSize + interIconDist) - interIconDist;
-
-    return NewSize(iconWidth, iconDrawSize);
+    return NSSizeFromQMLayoutSize(QMLayoutSizeOfIcons(&metrics, cell.countOfIcons));
 }
 
 - (NSSize)sizeOfTextOfCell:(QMCell *)cell {
@@ -81,21 +49,16 @@ TB_AUTOWIRE(settings)
 }
 
 - (NSSize)sizeOfChildrenFamily:(NSArray *)children {
-    if ([children count] == 0) {
-        return NewSize(0, 0);
-    }
-
-    CGFloat vertDistance = [self.settings floatForKey:qSettingInternodeVerticalDistance];
-    NSSize result = NewSize(0, (children.count - 1) * vertDistance);
+    QMLayoutMetrics metrics = self.settings.layoutMetrics;
+    QMLayoutSize result = {0, 0};
 
+    NSUInteger index = 0;
     for (QMCell *child in children) {
-        NSSize childFamilySize = child.familySize;
-
-        result.width = MAX(result.width, childFamilySize.width);
-        result.height += childFamilySize.height;
+        result = QMLayoutSizeOfChildrenFamilyAddingChild(&metrics, result, index, QMLayoutSizeFromNSSize(child.familySize));
+        index++;
     }
 
-    return result;
+    return NSSizeFromQMLayoutSize(result);
 }
 
 - (NSSize)sizeOfFamilyOfCell:(QMCell *)cell {
@@ -105,51 +68,28 @@ TB_AUTOWIRE(settings)
         return size;
     }
 
-    // RIGHT CHILDREN
-    CGFloat interNodeHorDistance = [self.settings floatForKey:qSettingInternodeHorizontalDistance];
-
-    CGFloat familyWidth = size.width;
-    CGFloat familyHeight = 0.0;
-
-    NSSize result = NewSize(familyWidth, familyHeight);
-    NSArray *children = cell.children;
-    if (children.count > 0) {
-        NSSize childrenSize = cell.childrenFamilySize;
-        familyWidth += interNodeHorDistance + childrenSize.width;
-        familyHeight = MAX(size.height, childrenSize.height);
-
-        result = NewSize(familyWidth, familyHeight);
-    }
-
-    // ROOT CELL, i.e. we have to process left children
+    NSUInteger countOfLeftChildren = 0;
+    QMLayoutSize leftChildrenFamilySize = {0, 0};
     if ([cell isRoot]) {
         QMRootCell *rootCell = (QMRootCell *) cell;
-        NSArray *leftChildren = rootCell.leftChildren;
 
-        if (leftChildren.count == 0) {
-            return result;
+        countOfLeftChildren = rootCell.countOfLeftChildren;
+        if (countOfLeftChildren > 0) {
+            leftChildrenFamilySize = QMLayoutSizeFromNSSize(rootCell.leftChildrenFamilySize);
         }
-
-        NSSize leftChildrenSize = rootCell.leftChildrenFamilySize;
-        familyWidth += interNodeHorDistance + leftChildrenSize.width;
-
-        const CGFloat heightToCompare = MAX(size.height, familyHeight);
-        familyHeight = MAX(heightToCompare, leftChildrenSize.height);
     }
 
-    result = NewSize(familyWidth, familyHeight);
-    return result;
-}
+    NSUInteger countOfChildren = cell.countOfChildren;
+    QMLayoutSize childrenFamilySize = {0, 0};
+    if (countOfChildren > 0) {
+        childrenFamilySize = QMLayoutSizeFromNSSize(cell.childrenFamilySize);
+    }
 
-#pragma mark Private
-- (NSSize)sizeOfRootEllipse:(NSSize)sizeOfCell {
-    double x0 = sizeOfCell.width / 2;
-    double y0 = sizeOfCell.height / 2;
-    double s = y0 / x0;
-    double a = sqrt(pow(x0, 2.0) + (pow(x0, 4.0 / 3.0) * pow(y0, 2.0 / 3.0)) / pow(s, 2.0 / 3.0));
-    double b = sqrt(pow(a, 2.0) * pow(y0, 2.0) / (pow(a, 2.0) - pow(x0, 2.0)));
+    QMLayoutMetrics metrics = self.settings.layoutMetrics;
+    QMLayoutSize familySize = QMLayoutSizeOfFamily(&metrics, QMLayoutCellKindOfCell(cell), QMLayoutSizeFromNSSize(size),
+            NO, countOfChildren, childrenFamilySize, countOfLeftChildren, leftChildrenFamilySize);
 
-    return NewSize((CGFloat) (2 * a), (CGFloat) (2 * b));
+    return NSSizeFromQMLayoutSize(familySize);
 }
 
 @end
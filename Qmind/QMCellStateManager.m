@@ -8,12 +8,15 @@
 
 #import "QMCellStateManager.h"
 #import "QMCell.h"
-#import "QMRootCell.h"
 #import "QMCellSelector.h"
 #import <Qkit/Qkit.h>
 
 @implementation QMCellStateManager {
-    NSMutableArray *_selectedCells;
+    /**
+    * Hash-based membership since every cell asks whether it is selected when drawn. Kept sorted by the index within
+    * the parent, which all selected cells share.
+    */
+    NSMutableOrderedSet *_selectedCells;
 
     QMStack *_clickedCells;
 
@@ -23,19 +26,23 @@
 }
 
 @dynamic draggedCells;
-@synthesize selectedCells = _selectedCells;
+@dynamic selectedCells;
 @synthesize mouseDownHitCell = _mouseDownHitCell;
 @synthesize dragTargetCell = _dragTargetCell;
 @synthesize cellSelector = _cellSelector;
 
 #pragma mark Public
+- (NSArray *)selectedCells {
+    return _selectedCells.array;
+}
+
 - (NSArray *)draggedCells {
     if (_mouseDownHitCell == nil) {
-        return _selectedCells;
+        return self.selectedCells;
     }
 
     if ([_selectedCells containsObject:_mouseDownHitCell]) {
-        return _selectedCells;
+        return self.selectedCells;
     }
 
     return @[_mouseDownHitCell];
@@ -144,7 +151,7 @@
 #pragma mark NSObject
 - (id)init {
     if ((self = [super init])) {
-        _selectedCells = [[NSMutableArray alloc] initWithCapacity:5];
+        _selectedCells = [[NSMutableOrderedSet alloc] initWithCapacity:5];
         _clickedCells = [[NSMutableArray alloc] initWithCapacity:5];
 
         _cellSelector = [[TBContext sharedContext] beanWithIdentifier:NSStringFromClass([QMCellSelector class])];
@@ -169,9 +176,8 @@
 
 - (void)sortSelectedCells {
     [_selectedCells sortUsingComparator:^(QMCell *cell1, QMCell *cell2) {
-        QMCell *parent = cell1.parent;
-        NSUInteger index1 = [parent indexOfChild:cell1];
-        NSUInteger index2 = [parent indexOfChild:cell2];
+        NSUInteger index1 = cell1.indexWithinParent;
+        NSUInteger index2 = cell2.indexWithinParent;
 
         if (index1 < index2) {
             return (NSComparisonResult) NSOrderedAscending;
@@ -206,32 +212,24 @@
         end = indexOfLastCell;
     }
 
-    if (cellToAdd.isLeft && parent.isRoot) {
-        QMRootCell *root = (QMRootCell *)parent;
-        for (NSUInteger i = initial; i <= end; i++) {
-            QMCell *cell = [root objectInLeftChildrenAtIndex:i];
-            if (![_selectedCells containsObject:cell]) {
-                [_selectedCells addObject:cell];
-            }
-        }
-    } else {
-        for (NSUInteger i = initial; i <= end; i++) {
-            QMCell *cell = [parent objectInChildrenAtIndex:i];
-            if (![_selectedCells containsObject:cell]) {
-                [_selectedCells addObject:cell];
-            }
-        }
-    }
+    // adding an already contained cell is a no-op
+    NSArray *siblings = [cellToAdd containingArray];
+    [_selectedCells addObjectsFromArray:[siblings subarrayWithRange:NSMakeRange(initial, end - initial + 1)]];
 
     [_clickedCells push:cellToAdd];
     [self sortSelectedCells];
 }
 
 - (void)addSingleCell:(QMCell *)cellToAdd {
-    [_selectedCells addObject:cellToAdd];
+    NSArray *selectedCells = _selectedCells.array;
+    NSUInteger index = [selectedCells indexOfObject:cellToAdd inSortedRange:NSMakeRange(0, selectedCells.count)
+                                            options:NSBinarySearchingInsertionIndex
+                                    usingComparator:^(QMCell *cell1, QMCell *cell2) {
+                                        return [@(cell1.indexWithinParent) compare:@(cell2.indexWithinParent)];
+                                    }];
+
+    [_selectedCells insertObject:cellToAdd atIndex:index];
     [_clickedCells push:cellToAdd];
-
-    [self sortSelectedCells];
 }
 
 - (void)removeSingleCell:(QMCell *)cellToRemove {
@@ -254,18 +252,8 @@
         end = indexOfLastCell;
     }
 
-    if (cellToRemove.isLeft && parent.isRoot) {
-        QMRootCell *root = (QMRootCell *)parent;
-        for (NSUInteger i = initial; i <= end; i++) {
-            QMCell *cell = [root objectInLeftChildrenAtIndex:i];
-            [_selectedCells removeObject:cell];
-        }
-    } else {
-        for (NSUInteger i = initial; i <= end; i++) {
-            QMCell *cell = [parent objectInChildrenAtIndex:i];
-            [_selectedCells removeObject:cell];
-        }
-    }
+    NSArray *siblings = [cellToRemove containingArray];
+    [_selectedCells minusSet:[NSSet setWithArray:[siblings subarrayWithRange:NSMakeRange(initial, end - initial + 1)]]];
 
     [_clickedCells removeObject:cellToRemove];
 }
@@ -0,0 +1,42 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import <Cocoa/Cocoa.h>
+
+@class QMCell;
+
+/**
+* Collects the rects of a view which have to be repainted after a change which does not move other cells, eg a
+* selection change or an edit which keeps the size of the cell. Add the cells touched by the change before and after
+* the change such that the old and the new frames are covered, then invalidate only their union.
+*/
+@interface QMDamageTracker : NSObject
+
+/**
+* The union of all added rects. NSZeroRect when nothing has been added since the last invalidation.
+*/
+@property (readonly) NSRect damagedRect;
+
+/**
+* Adds the rect in which the cell draws itself including its focus ring, folding marker and line.
+*/
+- (void)addCell:(QMCell *)cell;
+- (void)addCells:(NSArray *)cells;
+- (void)addRect:(NSRect)rect;
+
+/**
+* Calls -setNeedsDisplayInRect: of the view with the damaged rect and starts over.
+*/
+- (void)invalidateView:(NSView *)view;
+
+/**
+* Drops the damaged rect, eg when the whole view is repainted anyway.
+*/
+- (void)reset;
+
+@end
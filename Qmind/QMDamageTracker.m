@@ -0,0 +1,61 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import "QMDamageTracker.h"
+#import "QMCell.h"
+#import "QMCellDrawer.h"
+#import "QMTrace.h"
+
+@implementation QMDamageTracker
+
+#pragma mark Public
+- (void)addCell:(QMCell *)cell {
+    if (cell == nil) {
+        return;
+    }
+
+    [self addRect:[cell.cellDrawer displayRectOfCell:cell]];
+}
+
+- (void)addCells:(NSArray *)cells {
+    for (QMCell *cell in cells) {
+        [self addCell:cell];
+    }
+}
+
+- (void)addRect:(NSRect)rect {
+    if (NSIsEmptyRect(rect)) {
+        return;
+    }
+
+    _damagedRect = NSIsEmptyRect(_damagedRect) ? rect : NSUnionRect(_damagedRect, rect);
+}
+
+- (void)invalidateView:(NSView *)view {
+    if (!NSIsEmptyRect(_damagedRect)) {
+        QM_TRACE_COUNT("damaged area", (NSInteger) (_damagedRect.size.width * _damagedRect.size.height));
+        [view setNeedsDisplayInRect:_damagedRect];
+    }
+
+    [self reset];
+}
+
+- (void)reset {
+    _damagedRect = NSZeroRect;
+}
+
+#pragma mark NSObject
+- (id)init {
+    if ((self = [super init])) {
+        _damagedRect = NSZeroRect;
+    }
+
+    return self;
+}
+
+@end
@@ -13,6 +13,13 @@ static NSString * const qMindmapVersion = @"0.9.0";
 static NSString * const qMindmapUti = @"net.freemind.mindmap";
 static NSString * const qObjectiveCppUti = @"public.objective-c-plus-plus-source";
 
+/**
+* Outlines which we only import: see QMOutlineReader.
+*/
+static NSString * const qPlainTextUti = @"public.plain-text";
+static NSString * const qMarkdownUti = @"net.daringfireball.markdown";
+static NSString * const qOpmlUti = @"org.opml.opml";
+
 @class QMDocumentWindowController;
 @class QMMindmapReader;
 @class QMMindmapWriter;
@@ -67,6 +74,10 @@ static NSString * const qObjectiveCppUti = @"public.objective-c-plus-plus-source
 
 - (BOOL)itemIsNewlyCreated:(id)item;
 
+/**
+* Moves or copies the items in one splice: the items are removed with one batch operation per sibling array and
+* inserted as one contiguous block, ie one undo action and one KVO notification per step instead of one per item.
+*/
 - (void)moveItems:(NSArray *)itemsToMove toItem:(id)targetItem inDirection:(QMDirection)direction;
 - (void)copyItems:(NSArray *)itemsToMove toItem:(id)targetItem inDirection:(QMDirection)direction;
 
@@ -77,7 +88,40 @@ static NSString * const qObjectiveCppUti = @"public.objective-c-plus-plus-source
 
 - (void)deleteItem:(id)item;
 
+/**
+* Deletes the items with one batch removal per sibling array, ie one undo action retaining the deleted subtrees per
+* sibling array instead of one per item.
+*/
+- (void)deleteItems:(NSArray *)items;
+
 - (void)toggleFoldingForItem:(id)item;
 
+/**
+* Unfolds all folded ancestors of the item. Returns YES when at least one ancestor was folded.
+*/
+- (BOOL)unfoldAncestorsOfItem:(id)item;
+
+/**
+* Bulk folding: the nodes are folded or unfolded without one view update per node; the view is updated once for the
+* whole subtree afterwards.
+*
+* -foldSubtreeOfItem: folds the item and all its descendants, -unfoldSubtreeOfItem:toDepth: unfolds the item and its
+* descendants up to the given depth below the item and folds the descendants at the depth, ie exactly depth levels of
+* descendants are visible; the folding of the nodes further below is kept. -foldSiblingsOfItem: folds all siblings of
+* the item. -unfoldItem: unfolds only the item and keeps the folding of its descendants; it returns YES when the item was
+* folded.
+*/
+- (void)foldSubtreeOfItem:(id)item;
+- (void)unfoldSubtreeOfItem:(id)item toDepth:(NSUInteger)depth;
+- (void)foldSiblingsOfItem:(id)item;
+- (BOOL)unfoldItem:(id)item;
+
+/**
+* Searches the text and the link of all nodes using an index, which is built on the first search and then updated
+* incrementally. The results are in document order, see QMSearchIndex.
+*/
+- (NSArray *)itemsWithPrefix:(NSString *)prefix;
+- (NSArray *)itemsContainingString:(NSString *)string;
+
 @end
 
@@ -12,12 +12,23 @@
 #import "QMDocumentWindowController.h"
 #import "QMMindmapReader.h"
 #import "QMMindmapWriter.h"
+#import "QMOutlineReader.h"
 #import "QMRootNode.h"
 #import "QMAppSettings.h"
 #import "QMCell.h"
+#import "QMSearchIndex.h"
+#import "QMTrace.h"
 
 static NSString *const qDocumentNibName = @"Document";
 
+/**
+* Nodes which we wrote last to a pasteboard. As long as the pasteboard does not change, we paste copies of them instead
+* of unarchiving the promised data.
+*/
+static NSArray *qNodesOnPasteboard = nil;
+static NSString *qNameOfPasteboard = nil;
+static NSInteger qChangeCountOfPasteboard = 0;
+
 @interface QMDocument ()
 
 @property(weak) NSPasteboard *pasteboard;
@@ -25,7 +36,14 @@ static NSString *const qDocumentNibName = @"Document";
 
 @end
 
-@implementation QMDocument
+@implementation QMDocument {
+    QMSearchIndex *_searchIndex;
+
+    /**
+    * YES while folding in bulk: the view is updated once afterwards instead of once per folding notification.
+    */
+    BOOL _foldingInBulk;
+}
 
 TB_MANUALWIRE(settings)
 TB_MANUALWIRE(mindmapReader)
@@ -35,8 +53,7 @@ TB_MANUALWIRE(mindmapWriter)
 - (void)copyItemsToPasteboard:(NSArray *)items {
     NSArray *const copyItems = [[NSArray alloc] initWithArray:items copyItems:YES];
 
-    [self.pasteboard clearContents];
-    [self.pasteboard writeObjects:copyItems];
+    [self writeNodesToPasteboard:copyItems];
 }
 
 - (void)cutItemsToPasteboard:(NSArray *)items {
@@ -46,80 +63,54 @@ TB_MANUALWIRE(mindmapWriter)
     [self.windowController clearSelection:self];
 
     if (parent.root && [self isNodeLeft:anyItem]) {
-        for (QMNode *child in items) {
-            [self.rootNode removeObjectFromLeftChildrenAtIndex:[self.rootNode.leftChildren indexOfObject:child]];
-        }
+        [self.rootNode removeLeftChildrenAtIndexes:[self indexesOfItems:items withParent:self.rootNode inLeftChildren:YES]];
     } else {
-        for (QMNode *child in items) {
-            [parent removeObjectFromChildrenAtIndex:[parent.children indexOfObject:child]];
-        }
+        [parent removeChildrenAtIndexes:[self indexesOfItems:items withParent:parent inLeftChildren:NO]];
     }
 
-    [self.pasteboard clearContents];
-    [self.pasteboard writeObjects:items];
+    [self writeNodesToPasteboard:items];
 }
 
+/**
+* The items of the pasteboard are inserted with one batch insertion, ie with one undo action.
+*/
 - (void)appendItemsFromPBoard:(NSPasteboard *)pasteboard asChildrenToItem:(QMNode *)item {
     [self processNodesFromPasteboard:pasteboard usingBlock:^(NSArray *itemsFromPasteboard) {
-        for (QMNode *aNode in itemsFromPasteboard) {
-            [item addObjectInChildren:aNode];
-        }
+        [item insertChildren:itemsFromPasteboard atIndexes:[self indexesForItems:itemsFromPasteboard atIndex:item.countOfChildren]];
     }];
 }
 
 - (void)appendItemsFromPBoard:(NSPasteboard *)pasteboard asLeftChildrenToItem:(QMNode *)item {
     [self processNodesFromPasteboard:pasteboard usingBlock:^(NSArray *itemsFromPasteboard) {
-        for (QMNode *aNode in itemsFromPasteboard) {
-            [self.rootNode addObjectInLeftChildren:aNode];
-        }
+        [self.rootNode insertLeftChildren:itemsFromPasteboard atIndexes:[self indexesForItems:itemsFromPasteboard atIndex:self.rootNode.countOfLeftChildren]];
     }];
 }
 
 - (void)appendItemsFromPBoard:(NSPasteboard *)pasteboard asPreviousSiblingToItem:(QMNode *)item {
     // mind the root node
     [self processNodesFromPasteboard:pasteboard usingBlock:^(NSArray *itemsFromPBoard) {
-        QMNode *parent = item.parent;
-        NSUInteger indexOfItem;
+        NSIndexSet *indexes = [self indexesForItems:itemsFromPBoard atIndex:item.indexWithinParent];
 
         if ([self isNodeLeft:item]) {
-            indexOfItem = [self.rootNode.leftChildren indexOfObject:item];
-            for (QMNode *aNode in itemsFromPBoard) {
-                [self.rootNode insertObject:aNode inLeftChildrenAtIndex:indexOfItem];
-                indexOfItem++;
-            }
-
+            [self.rootNode insertLeftChildren:itemsFromPBoard atIndexes:indexes];
             return;
         }
 
-        indexOfItem = [parent.children indexOfObject:item];
-        for (QMNode *aNode in itemsFromPBoard) {
-            [parent insertObject:aNode inChildrenAtIndex:indexOfItem];
-            indexOfItem++;
-        }
+        [item.parent insertChildren:itemsFromPBoard atIndexes:indexes];
     }];
 }
 
 - (void)appendItemsFromPBoard:(NSPasteboard *)pasteboard asNextSiblingToItem:(QMNode *)item {
     // mind the root node
     [self processNodesFromPasteboard:pasteboard usingBlock:^(NSArray *itemsToPaste) {
-        QMNode *parent = item.parent;
-        NSUInteger indexOfItem;
+        NSIndexSet *indexes = [self indexesForItems:itemsToPaste atIndex:item.indexWithinParent + 1];
 
         if ([self isNodeLeft:item]) {
-            indexOfItem = [self.rootNode.leftChildren indexOfObject:item];
-            for (QMNode *aNode in itemsToPaste) {
-                [self.rootNode insertObject:aNode inLeftChildrenAtIndex:indexOfItem + 1];
-                indexOfItem++;
-            }
-
+            [self.rootNode insertLeftChildren:itemsToPaste atIndexes:indexes];
             return;
         }
 
-        indexOfItem = [parent.children indexOfObject:item];
-        for (QMNode *aNode in itemsToPaste) {
-            [parent insertObject:aNode inChildrenAtIndex:indexOfItem + 1];
-            indexOfItem++;
-        }
+        [item.parent insertChildren:itemsToPaste atIndexes:indexes];
     }];
 }
 
@@ -169,155 +160,21 @@ TB_MANUALWIRE(mindmapWriter)
 }
 
 - (void)moveItems:(NSArray *)itemsToMove toItem:(QMNode *)targetItem inDirection:(QMDirection)direction {
-    for (QMNode *node in itemsToMove) {
-        if ([self item:targetItem isDescendantOfItem:node]) {
-            return;
-        }
-    }
-
-    if ([targetItem isRoot]) {
-        if (direction == QMDirectionRight) {
-            for (QMNode *node in itemsToMove) {
-                [self deleteItem:node];
-                [targetItem insertObject:node inChildrenAtIndex:[targetItem countOfChildren]];
-            }
-
-            return;
-        }
-
-        if (direction == QMDirectionLeft) {
-            for (QMNode *node in itemsToMove) {
-                [self deleteItem:node];
-                [self.rootNode insertObject:node inLeftChildrenAtIndex:[self.rootNode countOfLeftChildren]];
-            }
-
-            return;
-        }
-
-        return;
-    }
-
-    for (QMNode *node in itemsToMove) {
-        [self deleteItem:node];
-    }
-
-    if (direction == QMDirectionRight || direction == QMDirectionLeft) {
-        for (QMNode *node in itemsToMove) {
-            [targetItem insertObject:node inChildrenAtIndex:[targetItem countOfChildren]];
-        }
-
+    if (![self canSpliceItems:itemsToMove toItem:targetItem inDirection:direction]) {
         return;
     }
 
-    BOOL targetIsLeftAndChildOfRoot = [self isNodeLeft:targetItem] && targetItem.parent == self.rootNode;
-    NSUInteger indexOfTargetItem;
-
-    if (targetIsLeftAndChildOfRoot) {
-        indexOfTargetItem = [self.rootNode.leftChildren indexOfObject:targetItem];
-    } else {
-        indexOfTargetItem = [targetItem.parent.children indexOfObject:targetItem];
-    }
-
-    if (direction == QMDirectionTop) {
-        if (targetIsLeftAndChildOfRoot) {
-            for (QMNode *node in [itemsToMove reverseObjectEnumerator]) {
-                [self.rootNode insertObject:node inLeftChildrenAtIndex:indexOfTargetItem];
-            }
-        } else {
-            for (QMNode *node in [itemsToMove reverseObjectEnumerator]) {
-                [targetItem.parent insertObject:node inChildrenAtIndex:indexOfTargetItem];
-            }
-        }
-
-        return;
-    }
-
-    if (direction == QMDirectionBottom) {
-        if (targetIsLeftAndChildOfRoot) {
-            for (QMNode *node in [itemsToMove reverseObjectEnumerator]) {
-                [self.rootNode insertObject:node inLeftChildrenAtIndex:indexOfTargetItem + 1];
-            }
-        } else {
-            for (QMNode *node in [itemsToMove reverseObjectEnumerator]) {
-                [targetItem.parent insertObject:node inChildrenAtIndex:indexOfTargetItem + 1];
-            }
-        }
-
-        return;
-    }
+    [self removeItems:itemsToMove];
+    [self spliceItems:itemsToMove toItem:targetItem inDirection:direction];
 }
 
 - (void)copyItems:(NSArray *)itemsToMove toItem:(QMNode *)targetItem inDirection:(QMDirection)direction {
-    for (QMNode *node in itemsToMove) {
-        if ([self item:targetItem isDescendantOfItem:node]) {
-            return;
-        }
-    }
-
-    if ([targetItem isRoot]) {
-        if (direction == QMDirectionRight) {
-            for (QMNode *node in itemsToMove) {
-                [targetItem insertObject:[node copy] inChildrenAtIndex:[targetItem countOfChildren]];
-            }
-
-            return;
-        }
-
-        if (direction == QMDirectionLeft) {
-            for (QMNode *node in itemsToMove) {
-                [self.rootNode insertObject:[node copy] inLeftChildrenAtIndex:[self.rootNode countOfLeftChildren]];
-            }
-
-            return;
-        }
-
-        return;
-    }
-
-    if (direction == QMDirectionRight || direction == QMDirectionLeft) {
-        for (QMNode *node in itemsToMove) {
-            [targetItem insertObject:[node copy] inChildrenAtIndex:[targetItem countOfChildren]];
-        }
-
+    if (![self canSpliceItems:itemsToMove toItem:targetItem inDirection:direction]) {
         return;
     }
 
-    BOOL targetIsLeftAndChildOfRoot = [self isNodeLeft:targetItem] && targetItem.parent == self.rootNode;
-    NSUInteger indexOfTargetItem;
-
-    if (targetIsLeftAndChildOfRoot) {
-        indexOfTargetItem = [self.rootNode.leftChildren indexOfObject:targetItem];
-    } else {
-        indexOfTargetItem = [targetItem.parent.children indexOfObject:targetItem];
-    }
-
-    if (direction == QMDirectionTop) {
-        if (targetIsLeftAndChildOfRoot) {
-            for (QMNode *node in [itemsToMove reverseObjectEnumerator]) {
-                [self.rootNode insertObject:[node copy] inLeftChildrenAtIndex:indexOfTargetItem];
-            }
-        } else {
-            for (QMNode *node in [itemsToMove reverseObjectEnumerator]) {
-                [targetItem.parent insertObject:[node copy] inChildrenAtIndex:indexOfTargetItem];
-            }
-        }
-
-        return;
-    }
-
-    if (direction == QMDirectionBottom) {
-        if (targetIsLeftAndChildOfRoot) {
-            for (QMNode *node in [itemsToMove reverseObjectEnumerator]) {
-                [self.rootNode insertObject:[node copy] inLeftChildrenAtIndex:indexOfTargetItem + 1];
-            }
-        } else {
-            for (QMNode *node in [itemsToMove reverseObjectEnumerator]) {
-                [targetItem.parent insertObject:[node copy] inChildrenAtIndex:indexOfTargetItem + 1];
-            }
-        }
-
-        return;
-    }
+    NSArray *copiedItems = [[NSArray alloc] initWithArray:itemsToMove copyItems:YES];
+    [self spliceItems:copiedItems toItem:targetItem inDirection:direction];
 }
 
 - (QMNode *)preparedNewNode {
@@ -346,11 +203,11 @@ TB_MANUALWIRE(mindmapWriter)
     QMNode *parent = item.parent;
 
     if ([parent isRoot] && [self isNodeLeft:item]) {
-        [self.rootNode insertObject:node inLeftChildrenAtIndex:[self.rootNode.leftChildren indexOfObject:item] + 1];
+        [self.rootNode insertObject:node inLeftChildrenAtIndex:item.indexWithinParent + 1];
         return;
     }
 
-    [parent insertObject:node inChildrenAtIndex:[parent.children indexOfObject:item] + 1];
+    [parent insertObject:node inChildrenAtIndex:item.indexWithinParent + 1];
 }
 
 - (void)addNewPreviousSiblingToItem:(QMNode *)item {
@@ -358,31 +215,30 @@ TB_MANUALWIRE(mindmapWriter)
     QMNode *parent = item.parent;
 
     if ([parent isRoot] && [self isNodeLeft:item]) {
-        [self.rootNode insertObject:node inLeftChildrenAtIndex:[self.rootNode.leftChildren indexOfObject:item]];
+        [self.rootNode insertObject:node inLeftChildrenAtIndex:item.indexWithinParent];
         return;
     }
 
-    [parent insertObject:node inChildrenAtIndex:[parent.children indexOfObject:item]];
+    [parent insertObject:node inChildrenAtIndex:item.indexWithinParent];
 }
 
 - (void)deleteItem:(QMNode *)item {
     QMNode *parent = item.parent;
-    NSArray *children;
-    NSUInteger indexOfItemToDel;
+    NSUInteger indexOfItemToDel = item.indexWithinParent;
 
     if (parent.isRoot && [self isNodeLeft:item]) {
-        children = self.rootNode.leftChildren;
-        indexOfItemToDel = [children indexOfObject:item];
         [self.rootNode removeObjectFromLeftChildrenAtIndex:indexOfItemToDel];
 
         return;
     }
 
-    children = parent.children;
-    indexOfItemToDel = [children indexOfObject:item];
     [parent removeObjectFromChildrenAtIndex:indexOfItemToDel];
 }
 
+- (void)deleteItems:(NSArray *)items {
+    [self removeItems:items];
+}
+
 - (void)toggleFoldingForItem:(QMNode *)item {
     if (item.root) {
         return;
@@ -396,12 +252,111 @@ TB_MANUALWIRE(mindmapWriter)
     item.folded = !oldValue;
 }
 
+- (BOOL)unfoldAncestorsOfItem:(QMNode *)item {
+    BOOL unfolded = NO;
+
+    for (QMNode *ancestor = item.parent; ancestor != nil; ancestor = ancestor.parent) {
+        if (ancestor.folded) {
+            ancestor.folded = NO;
+            unfolded = YES;
+        }
+    }
+
+    return unfolded;
+}
+
+- (void)foldSubtreeOfItem:(QMNode *)item {
+    [self foldInBulkInFamilyOfItem:item anchorItem:item usingBlock:^{
+        BOOL changed = NO;
+
+        QMStack *nodeStack = [[NSMutableArray alloc] initWithCapacity:15];
+        [nodeStack push:item];
+
+        while (nodeStack.count > 0) {
+            QMNode *node = [nodeStack pop];
+
+            changed |= [self setFolded:YES ofNode:node];
+            [nodeStack pushArray:node.allChildren];
+        }
+
+        return changed;
+    }];
+}
+
+- (void)unfoldSubtreeOfItem:(QMNode *)item toDepth:(NSUInteger)depth {
+    [self foldInBulkInFamilyOfItem:item anchorItem:item usingBlock:^{
+        BOOL changed = NO;
+
+        NSArray *nodesOfLevel = @[item];
+        for (NSUInteger level = 0; nodesOfLevel.count > 0; level++) {
+            if (level == depth) {
+                // the nodes below are not visible anyway, thus, we keep their folding
+                for (QMNode *node in nodesOfLevel) {
+                    changed |= [self setFolded:YES ofNode:node];
+                }
+
+                break;
+            }
+
+            NSMutableArray *nodesOfNextLevel = [[NSMutableArray alloc] init];
+            for (QMNode *node in nodesOfLevel) {
+                changed |= [self setFolded:NO ofNode:node];
+                [nodesOfNextLevel addObjectsFromArray:node.allChildren];
+            }
+
+            nodesOfLevel = nodesOfNextLevel;
+        }
+
+        return changed;
+    }];
+}
+
+- (void)foldSiblingsOfItem:(QMNode *)item {
+    QMNode *parent = item.parent;
+    if (parent == nil) {
+        return;
+    }
+
+    NSArray *siblings = (parent.isRoot && item.left) ? self.rootNode.leftChildren : parent.children;
+
+    [self foldInBulkInFamilyOfItem:parent anchorItem:item usingBlock:^{
+        BOOL changed = NO;
+
+        for (QMNode *sibling in siblings) {
+            if (sibling != item) {
+                changed |= [self setFolded:YES ofNode:sibling];
+            }
+        }
+
+        return changed;
+    }];
+}
+
+- (BOOL)unfoldItem:(QMNode *)item {
+    __block BOOL unfolded = NO;
+
+    [self foldInBulkInFamilyOfItem:item anchorItem:item usingBlock:^{
+        unfolded = [self setFolded:NO ofNode:item];
+        return unfolded;
+    }];
+
+    return unfolded;
+}
+
+- (NSArray *)itemsWithPrefix:(NSString *)prefix {
+    return [self.searchIndex nodesWithPrefix:prefix];
+}
+
+- (NSArray *)itemsContainingString:(NSString *)string {
+    return [self.searchIndex nodesContainingString:string];
+}
+
 - (BOOL)isNodeLeft:(QMNode *)item {
     if (item == nil || item.root) {
         return NO;
     }
 
-    return [self isNodeLeftInternal:item];
+    return item.left;
 }
 
 - (NSInteger)numberOfChildrenOfNode:(id)item {
@@ -487,6 +442,8 @@ TB_MANUALWIRE(mindmapWriter)
 }
 
 - (void)initRootNodeProperties {
+    _searchIndex = nil;
+
     self.rootNode.undoManager = self.undoManager;
     [self.rootNode addObserver:self forKeyPath:qNodeStringValueKey];
     [self.rootNode addObserver:self forKeyPath:qNodeFontKey];
@@ -528,7 +485,11 @@ TB_MANUALWIRE(mindmapWriter)
 - (BOOL)readFromFileWrapper:(NSFileWrapper *)fileWrapper ofType:(NSString *)typeName error:(NSError **)outError {
     [self.undoManager disableUndoRegistration];
 
-    _rootNode = [self.mindmapReader rootNodeForFileUrl:[self fileURL]];
+    if ([self isOutlineType:typeName]) {
+        _rootNode = [self rootNodeForOutlineData:fileWrapper.regularFileContents ofType:typeName];
+    } else {
+        _rootNode = [self.mindmapReader rootNodeForFileUrl:[self fileURL]];
+    }
 
     if (_rootNode == nil) {
         log4Warn(@"Error reading the file %@", [[self fileURL] path]);
@@ -572,17 +533,24 @@ TB_MANUALWIRE(mindmapWriter)
 
 #pragma mark NSKeyValueChangeObserving
 - (void)observeValueForKeyPath:(NSString *)keyPath ofObject:(id)object change:(NSDictionary *)change context:(void *)context {
+    QM_TRACE_SCOPE("kvo notification");
+    QM_TRACE_COUNT("kvo notifications", 1);
 
     if (![object isKindOfClass:[QMNode class]]) {
         return;
     }
 
     if ([keyPath isEqualToString:qNodeFoldingKey]) {
+        if (_foldingInBulk) {
+            return;
+        }
+
         [self.windowController updateCellFoldingWithIdentifier:object];
         return;
     }
 
     if ([keyPath isEqualToString:qNodeStringValueKey]) {
+        [_searchIndex updateNode:object];
         [self.windowController updateCellWithIdentifier:object];
         return;
     }
@@ -599,6 +567,10 @@ TB_MANUALWIRE(mindmapWriter)
             return;
         }
 
+        for (QMNode *node in [change objectForKey:NSKeyValueChangeOldKey]) {
+            [_searchIndex removeNode:node];
+        }
+
         if ([keyPath isEqualToString:qNodeChildrenKey]) {
             [self.windowController updateCellForChildRemovalWithIdentifier:object];
             return;
@@ -618,7 +590,12 @@ TB_MANUALWIRE(mindmapWriter)
             return;
         }
 
-        QMNode *insertedNode = [[change objectForKey:NSKeyValueChangeNewKey] lastObject];
+        NSArray *insertedNodes = [change objectForKey:NSKeyValueChangeNewKey];
+        QMNode *insertedNode = insertedNodes.lastObject;
+
+        for (QMNode *node in insertedNodes) {
+            [_searchIndex addNode:node];
+        }
 
         if ([keyPath isEqualToString:qNodeChildrenKey]) {
 
@@ -645,15 +622,59 @@ TB_MANUALWIRE(mindmapWriter)
 }
 
 #pragma mark Private
+- (QMSearchIndex *)searchIndex {
+    if (_searchIndex == nil) {
+        _searchIndex = [[QMSearchIndex alloc] initWithRootNode:self.rootNode];
+    }
+
+    return _searchIndex;
+}
+
 - (void)initSingletons {
     [[TBContext sharedContext] autowireSeed:self];
     _pasteboard = [NSPasteboard pasteboardWithName:NSGeneralPboard];
+
+    // bounds the memory of long editing sessions: each group retains the subtrees it removed
+    [self.undoManager setLevelsOfUndo:[[self.settings settingForKey:qSettingMaxUndoLevels] unsignedIntegerValue]];
+}
+
+- (void)writeNodesToPasteboard:(NSArray *)nodes {
+    [self.pasteboard clearContents];
+    [self.pasteboard writeObjects:nodes];
+
+    @synchronized ([QMDocument class]) {
+        qNodesOnPasteboard = nodes;
+        qNameOfPasteboard = self.pasteboard.name;
+        qChangeCountOfPasteboard = self.pasteboard.changeCount;
+    }
+}
+
+/**
+* Copying the nodes is O(1), unarchiving is O(n), see -[QMNode copyWithZone:].
+*/
+- (NSArray *)copiesOfNodesOnPasteboard:(NSPasteboard *)pasteboard {
+    @synchronized ([QMDocument class]) {
+        if (qNodesOnPasteboard == nil || ![pasteboard.name isEqualToString:qNameOfPasteboard]) {
+            return nil;
+        }
+
+        if (pasteboard.changeCount != qChangeCountOfPasteboard) {
+            qNodesOnPasteboard = nil;
+            return nil;
+        }
+
+        return [[NSArray alloc] initWithArray:qNodesOnPasteboard copyItems:YES];
+    }
 }
 
 - (void)processNodesFromPasteboard:(NSPasteboard *)pasteboard usingBlock:(void (^)(NSArray *itemsFromPasteboard))block {
-    NSArray *classes = @[[QMNode class], [NSString class]];
-    NSDictionary *options = [NSDictionary dictionary];
-    NSArray *itemsFromPb = [pasteboard readObjectsForClasses:classes options:options];
+    NSArray *itemsFromPb = [self copiesOfNodesOnPasteboard:pasteboard];
+
+    if (itemsFromPb == nil) {
+        NSArray *classes = @[[QMNode class], [NSString class]];
+        NSDictionary *options = [NSDictionary dictionary];
+        itemsFromPb = [pasteboard readObjectsForClasses:classes options:options];
+    }
 
     if (itemsFromPb == nil) {
         return;
@@ -677,21 +698,195 @@ TB_MANUALWIRE(mindmapWriter)
         return;
     }
 
-    // isText
-    QMNode *nodeToInsert = [[QMNode alloc] init];
-    nodeToInsert.stringValue = itemsFromPb.lastObject;
+    // isText: an outline becomes a whole subtree
+    NSArray *nodesToInsert = [[[QMOutlineReader alloc] init] nodesFromString:itemsFromPb.lastObject];
+    if (nodesToInsert.count == 0) {
+        return;
+    }
+
+    block(nodesToInsert);
+}
+
+- (BOOL)isOutlineType:(NSString *)typeName {
+    return [typeName isEqualToString:qPlainTextUti] || [typeName isEqualToString:qMarkdownUti]
+            || [typeName isEqualToString:qOpmlUti];
+}
+
+/**
+* A single top level node of the outline becomes the root node, otherwise the top level nodes become the children of a
+* root node named after the file. Children marked as left become left children of the root node.
+*/
+- (QMRootNode *)rootNodeForOutlineData:(NSData *)data ofType:(NSString *)typeName {
+    if (data == nil) {
+        return nil;
+    }
+
+    QMOutlineReader *outlineReader = [[QMOutlineReader alloc] init];
+
+    NSArray *nodes;
+    if ([typeName isEqualToString:qOpmlUti]) {
+        nodes = [outlineReader nodesFromOpmlData:data];
+    } else {
+        NSString *string = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
+        if (string == nil) {
+            return nil;
+        }
+
+        nodes = [outlineReader nodesFromString:string];
+    }
+
+    NSArray *children = nodes;
+    NSString *rootText = self.fileURL.lastPathComponent.stringByDeletingPathExtension ?: @"";
+    if (nodes.count == 1) {
+        children = [nodes.lastObject children];
+        rootText = [nodes.lastObject stringValue];
+    }
+
+    NSMutableArray *rightChildren = [[NSMutableArray alloc] initWithCapacity:children.count];
+    NSMutableArray *leftChildren = [[NSMutableArray alloc] init];
+    for (QMNode *child in children) {
+        if ([outlineReader isLeftNode:child]) {
+            [leftChildren addObject:child];
+        } else {
+            [rightChildren addObject:child];
+        }
+    }
+
+    QMRootNode *rootNode = [[QMRootNode alloc] initWithAttributes:@{qNodeTextAttributeKey : rootText}];
+    [rootNode insertChildren:rightChildren atIndexes:[self indexesForItems:rightChildren atIndex:0]];
+    [rootNode insertLeftChildren:leftChildren atIndexes:[self indexesForItems:leftChildren atIndex:0]];
+
+    return rootNode;
+}
+
+/**
+* The block returns whether any node has been (un)folded. When so, the cells of the family of the item are updated
+* in one pass keeping the anchor item in place.
+*/
+- (void)foldInBulkInFamilyOfItem:(QMNode *)item anchorItem:(QMNode *)anchorItem usingBlock:(BOOL (^)())block {
+    _foldingInBulk = YES;
+    BOOL changed = block();
+    _foldingInBulk = NO;
+
+    if (changed) {
+        [self.windowController updateCellFoldingInFamilyWithIdentifier:item anchorIdentifier:anchorItem];
+    }
+}
+
+/**
+* Returns YES when the folding of the node has changed. The root node and leaves are not folded.
+*/
+- (BOOL)setFolded:(BOOL)folded ofNode:(QMNode *)node {
+    if (node.root || node.leaf || node.folded == folded) {
+        return NO;
+    }
+
+    node.folded = folded;
+    return YES;
+}
+
+- (BOOL)canSpliceItems:(NSArray *)items toItem:(QMNode *)targetItem inDirection:(QMDirection)direction {
+    if (items.count == 0) {
+        return NO;
+    }
+
+    if ([targetItem isRoot] && direction != QMDirectionRight && direction != QMDirectionLeft) {
+        return NO;
+    }
+
+    for (QMNode *node in items) {
+        if (node == targetItem || [self item:targetItem isDescendantOfItem:node]) {
+            return NO;
+        }
+    }
+
+    return YES;
+}
+
+/**
+* Removes the given items with one batch removal per sibling array.
+*/
+- (void)removeItems:(NSArray *)items {
+    NSHashTable *parents = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+    for (QMNode *node in items) {
+        if (node.parent != nil) {
+            [parents addObject:node.parent];
+        }
+    }
+
+    for (QMNode *parent in parents.allObjects) {
+        NSIndexSet *indexes = [self indexesOfItems:items withParent:parent inLeftChildren:NO];
+        if (indexes.count > 0) {
+            [parent removeChildrenAtIndexes:indexes];
+        }
+
+        if (!parent.isRoot) {
+            continue;
+        }
+
+        NSIndexSet *leftIndexes = [self indexesOfItems:items withParent:self.rootNode inLeftChildren:YES];
+        if (leftIndexes.count > 0) {
+            [self.rootNode removeLeftChildrenAtIndexes:leftIndexes];
+        }
+    }
+}
+
+/**
+* Inserts the given detached items as one contiguous block at the position defined by the target item and the direction.
+*/
+- (void)spliceItems:(NSArray *)items toItem:(QMNode *)targetItem inDirection:(QMDirection)direction {
+    if ([targetItem isRoot]) {
+        if (direction == QMDirectionRight) {
+            [targetItem insertChildren:items atIndexes:[self indexesForItems:items atIndex:targetItem.countOfChildren]];
+            return;
+        }
+
+        if (direction == QMDirectionLeft) {
+            [self.rootNode insertLeftChildren:items atIndexes:[self indexesForItems:items atIndex:self.rootNode.countOfLeftChildren]];
+        }
+
+        return;
+    }
+
+    if (direction == QMDirectionRight || direction == QMDirectionLeft) {
+        [targetItem insertChildren:items atIndexes:[self indexesForItems:items atIndex:targetItem.countOfChildren]];
+        return;
+    }
+
+    if (direction != QMDirectionTop && direction != QMDirectionBottom) {
+        return;
+    }
+
+    QMNode *parent = targetItem.parent;
+    BOOL targetIsLeftAndChildOfRoot = parent == self.rootNode && [self isNodeLeft:targetItem];
+
+    NSUInteger indexOfTargetItem = targetItem.indexWithinParent;
+    NSUInteger indexToInsert = (direction == QMDirectionTop) ? indexOfTargetItem : indexOfTargetItem + 1;
 
-    block(@[nodeToInsert]);
+    if (targetIsLeftAndChildOfRoot) {
+        [self.rootNode insertLeftChildren:items atIndexes:[self indexesForItems:items atIndex:indexToInsert]];
+    } else {
+        [parent insertChildren:items atIndexes:[self indexesForItems:items atIndex:indexToInsert]];
+    }
+}
+
+- (NSIndexSet *)indexesForItems:(NSArray *)items atIndex:(NSUInteger)index {
+    return [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(index, items.count)];
 }
 
-- (BOOL)isNodeLeftInternal:(QMNode *)node {
-    if (node.parent.isRoot) {
-        QMRootNode *rootNode = (QMRootNode *) node.parent;
+/**
+* Indexes of those items which are in the children or, if inLeftChildren is YES, in the left children of the parent.
+*/
+- (NSIndexSet *)indexesOfItems:(NSArray *)items withParent:(QMNode *)parent inLeftChildren:(BOOL)inLeftChildren {
+    NSMutableIndexSet *indexes = [[NSMutableIndexSet alloc] init];
 
-        return [rootNode.leftChildren containsObject:node];
+    for (QMNode *item in items) {
+        if (item.parent == parent && (parent.isRoot && item.left) == inLeftChildren) {
+            [indexes addIndex:item.indexWithinParent];
+        }
     }
 
-    return [self isNodeLeftInternal:node.parent];
+    return indexes;
 }
 
 - (QMNode *)nodeFromItem:(id)item {
@@ -31,6 +31,8 @@ static CGFloat const qZoomOutStep = 0.9;
 
 - (void)updateCellFoldingWithIdentifier:(id)identifier;
 
+- (void)updateCellFoldingInFamilyWithIdentifier:(id)identifier anchorIdentifier:(id)anchorIdentifier;
+
 - (void)updateCellWithIdentifier:(id)identifier;
 
 - (void)updateCellForChildRemovalWithIdentifier:(id)identifier;
@@ -45,6 +47,11 @@ static CGFloat const qZoomOutStep = 0.9;
 
 - (void)updateCellWithIdentifier:(id)identifier withNewLeftChild:(id)childIdentifier;
 
+/**
+* Unfolds the ancestors of the item, eg a search hit, selects its cell and scrolls to it.
+*/
+- (void)revealItem:(id)item;
+
 - (IBAction)zoomByMode:(id)sender;
 
 - (IBAction)zoomToActualSize:(id)sender;
@@ -77,6 +84,17 @@ static CGFloat const qZoomOutStep = 0.9;
 
 - (IBAction)collapseNodeAction:(id)sender;
 
+- (IBAction)foldAllAction:(id)sender;
+
+/**
+* Unfolds the subtree of the selected node to the depth given by the tag of the sender.
+*/
+- (IBAction)unfoldToDepthAction:(id)sender;
+
+- (IBAction)foldSiblingsAction:(id)sender;
+
+- (IBAction)selectChildrenAction:(id)sender;
+
 - (IBAction)deleteSelectedNodes:(id)sender;
 
 - (IBAction)clearSelection:(id)sender;
@@ -18,6 +18,7 @@
 #import "QMRootCell.h"
 #import "QMIconsPaneView.h"
 #import "QMIcon.h"
+#import "QMLayoutContext.h"
 
 static CGFloat const qMinimumIconsPaneWidth = 48;
 static CGFloat const qMaxIconsPaneWidth = 250;
@@ -34,9 +35,7 @@ static NSInteger const qIconsPaneMenuItemTag = 301;
 
     id<QMMindmapViewDataSource> _dataSource;
 
-    CGSize _oldClipviewSize;
     NSPoint _oldClipviewOrigin;
-    NSPoint _oldCenterInView;
     CGFloat _lastIconsPaneWidth;
 }
 
@@ -59,6 +58,10 @@ TB_MANUALWIRE(iconManager)
     [_mindmapView updateCellFoldingWithIdentifier:identifier];
 }
 
+- (void)updateCellFoldingInFamilyWithIdentifier:(id)identifier anchorIdentifier:(id)anchorIdentifier {
+    [_mindmapView updateCellFoldingInFamilyWithIdentifier:identifier anchorIdentifier:anchorIdentifier];
+}
+
 - (void)updateCellWithIdentifier:(id)identifier {
     [_mindmapView updateCellWithIdentifier:identifier];
 }
@@ -87,6 +90,14 @@ TB_MANUALWIRE(iconManager)
     [_mindmapView updateLeftCellFamily:identifier forNewCell:childIdentifier];
 }
 
+- (void)revealItem:(id)item {
+    if ([_doc unfoldAncestorsOfItem:item]) {
+        [_doc updateChangeCount:NSChangeDone];
+    }
+
+    [_mindmapView selectCellWithIdentifier:item];
+}
+
 #pragma mark IBActions
 - (IBAction)zoomByMode:(id)sender {
     NSInteger clickedSegment = [sender selectedSegment];
@@ -132,6 +143,35 @@ TB_MANUALWIRE(iconManager)
     [_mindmapView toggleFoldingOfSelectedCell];
 }
 
+- (IBAction)foldAllAction:(id)sender {
+    id item = [self selectedItemOrRootItem];
+
+    [_doc foldSubtreeOfItem:item];
+    [_doc updateChangeCount:NSChangeDone];
+}
+
+- (IBAction)unfoldToDepthAction:(id)sender {
+    id item = [self selectedItemOrRootItem];
+    NSInteger depth = MAX([sender tag], 1);
+
+    [_doc unfoldSubtreeOfItem:item toDepth:(NSUInteger) depth];
+    [_doc updateChangeCount:NSChangeDone];
+}
+
+- (IBAction)foldSiblingsAction:(id)sender {
+    [_doc foldSiblingsOfItem:[_mindmapView.selectedCells.lastObject identifier]];
+    [_doc updateChangeCount:NSChangeDone];
+}
+
+- (IBAction)selectChildrenAction:(id)sender {
+    QMCell *selCell = _mindmapView.selectedCells.lastObject;
+    if ([_doc unfoldItem:selCell.identifier]) {
+        [_doc updateChangeCount:NSChangeDone];
+    }
+
+    [_mindmapView selectChildrenOfSelectedCell];
+}
+
 - (IBAction)deleteSelectedNodes:(id)sender {
     if (!_mindmapView.hasSelectedCells) {
         return;
@@ -325,14 +365,10 @@ TB_MANUALWIRE(iconManager)
     [self storeCurrentWidthOfIconsPane];
 
     /**
-    * In order not to scroll when window-resizing, we have to store the following before-resizing-values
-    * - to mindmap view converted clip view bounds origin
-    * - to mindmap view converted clip view frame size
-    * - the old center point of the visible portion of the mindmap
-    *
-    * With the above three values combined with new origin and size, we can compute the new scroll point of the mindmap
-    * such that it does not scroll when we resize the window,
-    * cf. -updateCanvasWithOldClipViewOrigin:oldClipViewSize:oldCenterInView of QMMindmapView.
+    * In order not to scroll when window-resizing, we store the to mindmap view converted clip view bounds origin before
+    * resizing. The cells do not move in the coordinates of the mindmap view, thus, scrolling back to this point after
+    * the margin around the map has been adapted keeps the map in place, cf. -updateCanvasWithOldClipViewOrigin: of
+    * QMMindmapView.
     *
     * This delegate method gets called when either the split view changed its size or the divider is shifted. It is
     * invoked before -splitView:resizeSubviewsWithOldSize:
@@ -520,6 +556,26 @@ TB_MANUALWIRE(iconManager)
         }
     }
 
+    if (selector == @selector(foldAllAction:) || selector == @selector(unfoldToDepthAction:)) {
+        return [selectedCells count] <= 1;
+    }
+
+    if (selector == @selector(foldSiblingsAction:)) {
+        if ([_mindmapView rootCellSelected]) {
+            return NO;
+        }
+
+        return [selectedCells count] == 1;
+    }
+
+    if (selector == @selector(selectChildrenAction:)) {
+        if ([selectedCells count] != 1) {
+            return NO;
+        }
+
+        return ![[selectedCells lastObject] isLeaf];
+    }
+
     if (selector == @selector(collapseNodeAction:)) {
         if ([_mindmapView rootCellSelected]) {
             return NO;
@@ -534,6 +590,14 @@ TB_MANUALWIRE(iconManager)
 }
 
 #pragma mark Private
+- (id)selectedItemOrRootItem {
+    if ([_mindmapView hasSelectedCells]) {
+        return [_mindmapView.selectedCells.lastObject identifier];
+    }
+
+    return _mindmapView.rootCell.identifier;
+}
+
 - (void)doInsideUndoGroup:(NSString *)undoGroupName usingBlock:(void (^)())block {
     NSUndoManager *const undoManager = [_doc undoManager];
 
@@ -548,8 +612,9 @@ TB_MANUALWIRE(iconManager)
 - (void)initAvailableIcons {
     _availableIconsArray = [[NSMutableArray alloc] initWithCapacity:75];
 
+    QMLayoutContext *layoutContext = _mindmapView.layoutContext ?: [[QMLayoutContext alloc] init];
     [_iconManager.iconCodes enumerateObjectsUsingBlock:^(NSString *code, NSUInteger index, BOOL* stop) {
-        [_availableIconsArrayController addObject:[[QMIcon alloc] initWithCode:code]];
+        [_availableIconsArrayController addObject:[[QMIcon alloc] initWithCode:code layoutContext:layoutContext]];
     }];
 
     [_availableIconsArrayController setSelectionIndexes:[NSIndexSet indexSet]];
@@ -599,12 +664,10 @@ TB_MANUALWIRE(iconManager)
 - (void)storeCurrentPositionValuesForMindmapView {
     NSClipView *clipView = _mindmapView.enclosingScrollView.contentView;
     _oldClipviewOrigin = [_mindmapView convertPoint:clipView.bounds.origin fromView:clipView];
-    _oldClipviewSize = [_mindmapView convertSize:clipView.frame.size fromView:clipView];
-    _oldCenterInView = [_mindmapView middlePointOfVisibleRect];
 }
 
 - (void)updateMindmapViewCanvasSize {
-    [_mindmapView updateCanvasWithOldClipViewOrigin:_oldClipviewOrigin oldClipViewSize:_oldClipviewSize oldCenterInView:_oldCenterInView];
+    [_mindmapView updateCanvasWithOldClipViewOrigin:_oldClipviewOrigin];
 }
 
 - (NSScrollView *)iconsPane {
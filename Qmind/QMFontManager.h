@@ -24,12 +24,13 @@
 @property (readonly) NSFont *fontawesomeFont;
 
 /**
-* Returns an NSFont out of FreeMind font attributes in form of a dictionary.
+* Returns an NSFont out of FreeMind font attributes in form of a dictionary. The fonts are cached by name, size, bold
+* and italic since maps usually contain only a handful of distinct fonts.
 */
 - (NSFont *)fontFromFontAttrDict:(NSDictionary *)fontAttrDict;
 
 /**
-* Returns FreeMind font attributes in form of a dictionary out of an NSFont
+* Returns FreeMind font attributes in form of a dictionary out of an NSFont. The dictionaries are cached per font.
 */
 - (NSDictionary *)fontAttrDictFromFont:(NSFont *)font;
 
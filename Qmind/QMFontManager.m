@@ -10,6 +10,7 @@
 #import "QMFontManager.h"
 #import <Qkit/Qkit.h>
 #import "QMAppSettings.h"
+#import "QMTrace.h"
 
 static NSString *const qNameKey = @"NAME";
 static NSString *const qSizeKey = @"SIZE";
@@ -26,7 +27,10 @@ static NSString *const qTimesFontName = @"Times";
 
 @end
 
-@implementation QMFontManager
+@implementation QMFontManager {
+    NSMutableDictionary *_fontCache;
+    NSMutableDictionary *_fontAttrDictCache;
+}
 
 TB_AUTOWIRE(settings)
 TB_AUTOWIRE(fontManager)
@@ -38,6 +42,64 @@ TB_AUTOWIRE(fontManager)
     NSNumber *boldObj = [fontAttrDict objectForKey:qBoldKey];
     NSNumber *italicObj = [fontAttrDict objectForKey:qItalicKey];
 
+    NSString *cacheKey = [NSString stringWithFormat:@"%@|%@|%d|%d", fontName, fontSizeObj, boldObj != nil, italicObj != nil];
+    @synchronized (_fontCache) {
+        NSFont *cachedFont = _fontCache[cacheKey];
+        if (cachedFont != nil) {
+            QM_TRACE_COUNT("font cache hits", 1);
+            return cachedFont;
+        }
+    }
+
+    QM_TRACE_COUNT("font cache misses", 1);
+
+    NSFont *font = [self fontWithName:fontName sizeObj:fontSizeObj bold:boldObj != nil italic:italicObj != nil];
+    if (font == nil) {
+        return nil;
+    }
+
+    @synchronized (_fontCache) {
+        _fontCache[cacheKey] = font;
+    }
+
+    return font;
+}
+
+- (NSDictionary *)fontAttrDictFromFont:(NSFont *)font {
+    if (font == nil || [font isEqual:self.defaultFont]) {
+        return nil;
+    }
+
+    @synchronized (_fontAttrDictCache) {
+        NSDictionary *cachedAttrDict = _fontAttrDictCache[font];
+        if (cachedAttrDict != nil) {
+            QM_TRACE_COUNT("font cache hits", 1);
+            return cachedAttrDict;
+        }
+    }
+
+    QM_TRACE_COUNT("font cache misses", 1);
+
+    NSDictionary *attrDict = [self computeFontAttrDictFromFont:font];
+
+    @synchronized (_fontAttrDictCache) {
+        _fontAttrDictCache[font] = attrDict;
+    }
+
+    return attrDict;
+}
+
+#pragma mark TBInitializingBean
+- (void)postConstruct {
+    _defaultFont = [self.settings settingForKey:qSettingDefaultFont];
+    _fontawesomeFont = [self.settings settingForKey:qSettingLinkIconFont];
+
+    _fontCache = [[NSMutableDictionary alloc] init];
+    _fontAttrDictCache = [[NSMutableDictionary alloc] init];
+}
+
+#pragma mark Private
+- (NSFont *)fontWithName:(NSString *)fontName sizeObj:(NSNumber *)fontSizeObj bold:(BOOL)bold italic:(BOOL)italic {
     CGFloat fontSize = fontSizeObj.floatValue;
 
     if (fontName == nil || [fontName isEqualToString:qDefaultSansSerifFontName]) {
@@ -58,22 +120,18 @@ TB_AUTOWIRE(fontManager)
         font = [NSFont fontWithName:[self.defaultFont familyName] size:fontSize];
     }
 
-    if (boldObj != nil) {
+    if (bold) {
         font = [self.fontManager convertFont:font toHaveTrait:NSBoldFontMask];
     }
 
-    if (italicObj != nil) {
+    if (italic) {
         font = [self.fontManager convertFont:font toHaveTrait:NSItalicFontMask];
     }
 
     return font;
 }
 
-- (NSDictionary *)fontAttrDictFromFont:(NSFont *)font {
-    if ([font isEqual:self.defaultFont]) {
-        return nil;
-    }
-
+- (NSDictionary *)computeFontAttrDictFromFont:(NSFont *)font {
     NSMutableDictionary *attrDict = [[NSMutableDictionary allocWithZone:nil] initWithCapacity:4];
 
     NSString *fontName = font.familyName;
@@ -82,11 +140,12 @@ TB_AUTOWIRE(fontManager)
     }
 
     NSInteger fontSize = (NSInteger) font.pointSize;
-    if ([self.fontManager traitsOfFont:font] & NSFontBoldTrait) {
+    NSFontTraitMask traits = [self.fontManager traitsOfFont:font];
+    if (traits & NSFontBoldTrait) {
         [attrDict setObject:qTrueValue forKey:qBoldKey];
     }
 
-    if ([self.fontManager traitsOfFont:font] & NSFontItalicTrait) {
+    if (traits & NSFontItalicTrait) {
         [attrDict setObject:qTrueValue forKey:qItalicKey];
     }
 
@@ -94,14 +153,7 @@ TB_AUTOWIRE(fontManager)
         [attrDict setObject:[NSString stringWithFormat:@"%li", fontSize] forKey:qSizeKey];
     }
 
-    return attrDict;
-}
-
-#pragma mark TBInitializingBean
-- (void)postConstruct {
-    _defaultFont = [self.settings settingForKey:qSettingDefaultFont];
-    _fontawesomeFont = [self.settings settingForKey:qSettingLinkIconFont];
-
+    return [attrDict copy];
 }
 
 @end
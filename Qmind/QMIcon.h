@@ -14,6 +14,7 @@
 @class QMTextDrawer;
 @class QMTextLayoutManager;
 @class QMFontManager;
+@class QMLayoutContext;
 
 @interface QMIcon : NSObject <NSCopying>
 
@@ -24,6 +25,11 @@
 @property (weak) QMFontManager *fontManager;
 @property (assign) NSFontManager *systemFontManager;    // it is not allowed to weakly reference to NSFontManager?
 
+/**
+* The context the beans were taken from. Copies share it.
+*/
+@property (readonly) QMLayoutContext *layoutContext;
+
 @property (readonly) QMIconKind kind;
 @property (readonly) NSString *code;
 @property (readonly) NSString *unicode;
@@ -42,8 +48,14 @@
 
 @property (readonly) NSRect frame;
 
+/**
+* Convenience initializers which create a new QMLayoutContext. Prefer the ones with a context when creating many icons.
+*/
 - (id)initWithCode:(NSString *)aCode;
 - (id)initAsLink;
+
+- (id)initWithCode:(NSString *)aCode layoutContext:(QMLayoutContext *)layoutContext;
+- (id)initAsLinkWithLayoutContext:(QMLayoutContext *)layoutContext;
 - (void)drawRect:(NSRect)dirtyRect;
 
 @end
@@ -14,6 +14,7 @@
 #import "QMTextDrawer.h"
 #import "QMTextLayoutManager.h"
 #import "QMFontManager.h"
+#import "QMLayoutContext.h"
 
 
 @interface QMIcon ()
@@ -35,7 +36,7 @@
 
 #pragma mark NSCopying
 - (id)copyWithZone:(NSZone *)zone {
-    QMIcon *copy = [[QMIcon alloc] initWithCode:self.code];
+    QMIcon *copy = [[QMIcon alloc] initWithCode:self.code layoutContext:self.layoutContext];
     copy.origin = self.origin;
     copy.size = self.size;
 
@@ -44,9 +45,17 @@
 
 #pragma mark Initializer
 - (id)initWithCode:(NSString *)aCode {
+    return [self initWithCode:aCode layoutContext:[[QMLayoutContext alloc] init]];
+}
+
+- (id)initAsLink {
+    return [self initAsLinkWithLayoutContext:[[QMLayoutContext alloc] init]];
+}
+
+- (id)initWithCode:(NSString *)aCode layoutContext:(QMLayoutContext *)layoutContext {
     self = [super init];
     if (self) {
-        [self initBeans];
+        [self initBeansWithLayoutContext:layoutContext];
 
         _code = aCode;
         _kind = [_iconManager kindForCode:_code];
@@ -56,10 +65,10 @@
 
             NSFont *iconFont = [self.settings settingForKey:qSettingIconFont];
             NSDictionary *attrDict = [self.textLayoutManager stringAttributesDictWithFont:iconFont];
-            _attrStr = [[NSAttributedString alloc] initWithString:self.unicode attributes:attrDict];
+            _attrStr = [_iconManager attributedStringWithString:self.unicode attributes:attrDict];
         } else if (_kind == QMIconKindImage) {
             _image = [_iconManager iconRepresentationForCode:_code];
-            [self initFlippedImage];
+            _flippedImage = [_iconManager flippedImageForCode:_code size:_image.size];
         }
 
         CGFloat iconSize = [_settings floatForKey:qSettingIconDrawSize];
@@ -69,10 +78,10 @@
     return self;
 }
 
-- (id)initAsLink {
+- (id)initAsLinkWithLayoutContext:(QMLayoutContext *)layoutContext {
     self = [super init];
     if (self) {
-        [self initBeans];
+        [self initBeansWithLayoutContext:layoutContext];
 
         _unicode = @"\\u%f023";
         _kind = QMIconKindFontawesome;
@@ -81,7 +90,7 @@
         // TODO: we should set the font for links in app settings and use it here
         [self.systemFontManager convertFont:fontawesome toSize:16];
         NSDictionary *attrDict = [self.textLayoutManager stringAttributesDictWithFont:fontawesome];
-        _attrStr = [[NSAttributedString alloc] initWithString:self.unicode attributes:attrDict];
+        _attrStr = [self.iconManager attributedStringWithString:self.unicode attributes:attrDict];
 
         CGFloat iconSize = [_settings floatForKey:qSettingLinkIconDrawSize];
         _size = NewSize(iconSize, iconSize);
@@ -117,15 +126,15 @@
     [self.textDrawer drawAttributedString:self.attrStr inRect:rect range:NSMakeRange(0, 1)];
 }
 
-- (void)initBeans {
-    TBContext *context = [TBContext sharedContext];
+- (void)initBeansWithLayoutContext:(QMLayoutContext *)layoutContext {
+    _layoutContext = layoutContext;
 
-    _iconManager = [context beanWithClass:[QMIconManager class]];
-    _settings = [context beanWithClass:[QMAppSettings class]];
-    _textDrawer = [context beanWithClass:[QMTextDrawer class]];
-    _textLayoutManager = [context beanWithClass:[QMTextLayoutManager class]];
-    _fontManager = [context beanWithClass:[QMFontManager class]];
-    _systemFontManager = [context beanWithClass:[NSFontManager class]];
+    _iconManager = layoutContext.iconManager;
+    _settings = layoutContext.settings;
+    _textDrawer = layoutContext.textDrawer;
+    _textLayoutManager = layoutContext.textLayoutManager;
+    _fontManager = layoutContext.fontManager;
+    _systemFontManager = layoutContext.systemFontManager;
 }
 
 - (void)drawStringIconInRect:(NSRect)frame {
@@ -135,17 +144,4 @@
     [self.textDrawer drawAttributedString:self.attrStr inRect:tempRect range:NSMakeRange(0, 1)];
 }
 
-- (void)initFlippedImage {
-    NSSize imgSize = [_image size];
-    _flippedImage = [[NSImage alloc] initWithSize:imgSize];
-
-    [_flippedImage lockFocus];
-    NSAffineTransform *transform = [NSAffineTransform transform];
-    [transform translateXBy:0 yBy:imgSize.height];
-    [transform scaleXBy:1 yBy:-1];
-    [transform concat];
-    [_image drawAtPoint:NSZeroPoint fromRect:NewRect(0, 0, imgSize.width, imgSize.height) operation:NSCompositeSourceOver fraction:1];
-    [_flippedImage unlockFocus];
-}
-
 @end
@@ -16,7 +16,36 @@
 */
 @property (readonly) NSArray *iconCodes;
 
+/**
+* Number of requests served from the icon caches and number of requests which had to load or create the
+* representation. For diagnostics only.
+*/
+@property (readonly) NSUInteger cacheHitCount;
+@property (readonly) NSUInteger cacheMissCount;
+
+/**
+* cacheHitCount / (cacheHitCount + cacheMissCount) or 0 when nothing has been requested yet.
+*/
+@property (readonly) CGFloat cacheHitRate;
+
+/**
+* Returns an NSString for unicode icons and an NSImage for PDF icons. The PDF is loaded only once; all callers share
+* the same NSImage instance, thus do not modify it.
+*/
 - (id)iconRepresentationForCode:(NSString *)iconCode;
 - (QMIconKind)kindForCode:(NSString *)iconCode;
 
+/**
+* Returns a vertically flipped bitmap of the icon image of the given size. It is rendered once per code and size and
+* shared afterwards.
+*/
+- (NSImage *)flippedImageForCode:(NSString *)iconCode size:(NSSize)size;
+
+/**
+* Returns an interned NSAttributedString for the string and the attributes.
+*/
+- (NSAttributedString *)attributedStringWithString:(NSString *)string attributes:(NSDictionary *)attributes;
+
+- (void)clearCache;
+
 @end
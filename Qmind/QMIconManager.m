@@ -9,6 +9,7 @@
 #import "QMIconManager.h"
 #import <Qkit/Qkit.h>
 #import <TBCacao/TBCacao.h>
+#import "QMTrace.h"
 
 static NSString * const KindKey = @"kind";
 static NSString * const UnicodeValue = @"unicode";
@@ -18,14 +19,160 @@ static NSString * const PdfValue = @"pdf";
 @implementation QMIconManager {
     NSDictionary *_conversionDict;
     NSArray *_iconCodes;
+
+    NSMutableDictionary *_representationCache;
+    NSMutableDictionary *_flippedImageCache;
+    NSMutableDictionary *_attributedStringCache;
+
+    NSUInteger _cacheHitCount;
+    NSUInteger _cacheMissCount;
 }
 
 TB_BEAN
 
 @synthesize iconCodes = _iconCodes;
+@dynamic cacheHitCount;
+@dynamic cacheMissCount;
+@dynamic cacheHitRate;
 
 #pragma mark Public
+- (NSUInteger)cacheHitCount {
+    @synchronized (self) {
+        return _cacheHitCount;
+    }
+}
+
+- (NSUInteger)cacheMissCount {
+    @synchronized (self) {
+        return _cacheMissCount;
+    }
+}
+
+- (CGFloat)cacheHitRate {
+    @synchronized (self) {
+        NSUInteger total = _cacheHitCount + _cacheMissCount;
+        if (total == 0) {
+            return 0.0;
+        }
+
+        return (CGFloat) _cacheHitCount / total;
+    }
+}
+
 - (id)iconRepresentationForCode:(NSString *)iconCode {
+    @synchronized (self) {
+        id cachedRepresentation = _representationCache[iconCode];
+        if (cachedRepresentation != nil) {
+            _cacheHitCount++;
+            QM_TRACE_COUNT("icon cache hits", 1);
+            return cachedRepresentation;
+        }
+
+        _cacheMissCount++;
+        QM_TRACE_COUNT("icon cache misses", 1);
+
+        id representation = [self loadIconRepresentationForCode:iconCode];
+        if (representation != nil && iconCode != nil) {
+            _representationCache[iconCode] = representation;
+        }
+
+        return representation;
+    }
+}
+
+- (NSImage *)flippedImageForCode:(NSString *)iconCode size:(NSSize)size {
+    @synchronized (self) {
+        NSString *key = [NSString stringWithFormat:@"%@@%.1fx%.1f", iconCode, size.width, size.height];
+
+        NSImage *cachedImage = _flippedImageCache[key];
+        if (cachedImage != nil) {
+            _cacheHitCount++;
+            QM_TRACE_COUNT("icon cache hits", 1);
+            return cachedImage;
+        }
+
+        _cacheMissCount++;
+        QM_TRACE_COUNT("icon cache misses", 1);
+
+        NSImage *image = _representationCache[iconCode] ?: [self iconRepresentationForCode:iconCode];
+        if (![image isKindOfClass:[NSImage class]]) {
+            return nil;
+        }
+
+        NSImage *flippedImage = [self flippedImageOfImage:image size:size];
+        _flippedImageCache[key] = flippedImage;
+
+        return flippedImage;
+    }
+}
+
+- (NSAttributedString *)attributedStringWithString:(NSString *)string attributes:(NSDictionary *)attributes {
+    if (string == nil) {
+        return nil;
+    }
+
+    @synchronized (self) {
+        NSArray *key = @[string, attributes ?: @{}];
+
+        NSAttributedString *cachedAttrStr = _attributedStringCache[key];
+        if (cachedAttrStr != nil) {
+            _cacheHitCount++;
+            QM_TRACE_COUNT("icon cache hits", 1);
+            return cachedAttrStr;
+        }
+
+        _cacheMissCount++;
+        QM_TRACE_COUNT("icon cache misses", 1);
+
+        NSAttributedString *attrStr = [[NSAttributedString alloc] initWithString:string attributes:attributes];
+        _attributedStringCache[key] = attrStr;
+
+        return attrStr;
+    }
+}
+
+- (void)clearCache {
+    @synchronized (self) {
+        [_representationCache removeAllObjects];
+        [_flippedImageCache removeAllObjects];
+        [_attributedStringCache removeAllObjects];
+
+        _cacheHitCount = 0;
+        _cacheMissCount = 0;
+    }
+}
+
+- (QMIconKind)kindForCode:(NSString *)iconCode {
+    NSDictionary *iconDesc = [_conversionDict objectForKey:iconCode];
+    NSString *kind = [iconDesc objectForKey:KindKey];
+
+    if ([kind isEqualToString:UnicodeValue]) {
+        return QMIconKindString;
+    }
+
+    if ([kind isEqualToString:PdfValue]) {
+        return QMIconKindImage;
+    }
+    
+    return QMIconKindNone;
+}
+
+#pragma mark Private
+- (NSImage *)flippedImageOfImage:(NSImage *)image size:(NSSize)size {
+    NSImage *flippedImage = [[NSImage alloc] initWithSize:size];
+
+    [flippedImage lockFocus];
+    NSAffineTransform *transform = [NSAffineTransform transform];
+    [transform translateXBy:0 yBy:size.height];
+    [transform scaleXBy:1 yBy:-1];
+    [transform concat];
+    [image drawInRect:NewRect(0, 0, size.width, size.height) fromRect:NSZeroRect operation:NSCompositeSourceOver fraction:1];
+    [flippedImage unlockFocus];
+
+    return flippedImage;
+}
+
+- (id)loadIconRepresentationForCode:(NSString *)iconCode {
     NSDictionary *iconDesc = [_conversionDict objectForKey:iconCode];
 
     if (iconDesc == nil) {
@@ -59,21 +206,6 @@ TB_BEAN
     return nil;
 }
 
-- (QMIconKind)kindForCode:(NSString *)iconCode {
-    NSDictionary *iconDesc = [_conversionDict objectForKey:iconCode];
-    NSString *kind = [iconDesc objectForKey:KindKey];
-
-    if ([kind isEqualToString:UnicodeValue]) {
-        return QMIconKindString;
-    }
-
-    if ([kind isEqualToString:PdfValue]) {
-        return QMIconKindImage;
-    }
-    
-    return QMIconKindNone;
-}
-
 #pragma mark NSObject
 - (id)init {
     if ((self = [super init])) {
@@ -90,6 +222,10 @@ TB_BEAN
         }];
         [tempIconArray sortUsingSelector:@selector(compare:)];
         _iconCodes = [[NSArray alloc] initWithArray:tempIconArray];
+
+        _representationCache = [[NSMutableDictionary alloc] initWithCapacity:_conversionDict.count];
+        _flippedImageCache = [[NSMutableDictionary alloc] init];
+        _attributedStringCache = [[NSMutableDictionary alloc] init];
     }
 
     return self;
@@ -0,0 +1,42 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import <Cocoa/Cocoa.h>
+
+@class QMCellSizeManager;
+@class QMCellLayoutManager;
+@class QMCellDrawer;
+@class QMTextLayoutManager;
+@class QMTextDrawer;
+@class QMIconManager;
+@class QMAppSettings;
+@class QMFontManager;
+
+/**
+* Bundles the beans every cell and icon needs. The beans are looked up once per view (or per Quick Look
+* rendering) and the context is handed to all cells and icons, since TBContext lookups are too expensive to be done
+* per cell.
+*/
+@interface QMLayoutContext : NSObject
+
+@property (readonly, weak) QMCellSizeManager *cellSizeManager;
+@property (readonly, weak) QMCellLayoutManager *cellLayoutManager;
+@property (readonly, weak) QMCellDrawer *cellDrawer;
+@property (readonly, weak) QMTextLayoutManager *textLayoutManager;
+@property (readonly, weak) QMTextDrawer *textDrawer;
+@property (readonly, weak) QMIconManager *iconManager;
+@property (readonly, weak) QMAppSettings *settings;
+@property (readonly, weak) QMFontManager *fontManager;
+@property (readonly, assign) NSFontManager *systemFontManager;
+
+/**
+* Resolves all beans from the shared TBContext.
+*/
+- (id)init;
+
+@end
@@ -0,0 +1,42 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import <TBCacao/TBCacao.h>
+#import "QMLayoutContext.h"
+#import "QMCellSizeManager.h"
+#import "QMCellLayoutManager.h"
+#import "QMCellDrawer.h"
+#import "QMTextLayoutManager.h"
+#import "QMTextDrawer.h"
+#import "QMIconManager.h"
+#import "QMAppSettings.h"
+#import "QMFontManager.h"
+
+@implementation QMLayoutContext
+
+#pragma mark Initializer
+- (id)init {
+    self = [super init];
+    if (self) {
+        TBContext *context = [TBContext sharedContext];
+
+        _cellSizeManager = [context beanWithClass:[QMCellSizeManager class]];
+        _cellLayoutManager = [context beanWithClass:[QMCellLayoutManager class]];
+        _cellDrawer = [context beanWithClass:[QMCellDrawer class]];
+        _textLayoutManager = [context beanWithClass:[QMTextLayoutManager class]];
+        _textDrawer = [context beanWithClass:[QMTextDrawer class]];
+        _iconManager = [context beanWithClass:[QMIconManager class]];
+        _settings = [context beanWithClass:[QMAppSettings class]];
+        _fontManager = [context beanWithClass:[QMFontManager class]];
+        _systemFontManager = [context beanWithClass:[NSFontManager class]];
+    }
+
+    return self;
+}
+
+@end
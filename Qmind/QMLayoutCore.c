@@ -0,0 +1,405 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include "QMLayoutCore.h"
+
+static QMLayoutSize const qLayoutZeroSize = {0, 0};
+
+static QMLayoutSize layoutSize(double width, double height) {
+    QMLayoutSize size = {width, height};
+    return size;
+}
+
+static QMLayoutPoint layoutPoint(double x, double y) {
+    QMLayoutPoint point = {x, y};
+    return point;
+}
+
+static QMLayoutRect layoutRect(double x, double y, double width, double height) {
+    QMLayoutRect rect = {x, y, width, height};
+    return rect;
+}
+
+/**
+* The cell is vertically centered in its family when the family is taller.
+*/
+static double originYInFamily(QMLayoutSize size, QMLayoutSize familySize, QMLayoutPoint familyOrigin) {
+    if (size.height < familySize.height) {
+        return familyOrigin.y + familySize.height / 2 - size.height / 2;
+    }
+
+    return familyOrigin.y;
+}
+
+QMLayoutSize QMLayoutSizeOfIcons(const QMLayoutMetrics *metrics, size_t countOfIcons) {
+    if (countOfIcons == 0) {
+        return qLayoutZeroSize;
+    }
+
+    double iconWidth = countOfIcons * (metrics->iconDrawSize + metrics->interIconDistance) - metrics->interIconDistance;
+
+    return layoutSize(iconWidth, metrics->iconDrawSize);
+}
+
+QMLayoutSize QMLayoutSizeOfCell(const QMLayoutMetrics *metrics, QMLayoutCellKind kind, QMLayoutSize textSize,
+        QMLayoutSize iconSize, size_t countOfIcons, bool hasText, bool hasLink) {
+
+    QMLayoutSize result = textSize;
+
+    if (countOfIcons > 0) {
+        result.width += iconSize.width + (hasText ? metrics->iconTextDistance : 0);
+
+        if (iconSize.height > result.height) {
+            result.height = iconSize.height;
+        }
+    }
+
+    if (hasLink) {
+        result.width += metrics->linkIconDrawSize + metrics->linkIconHorizontalMargin;
+        result.height = fmax(metrics->linkIconDrawSize, result.height);
+    }
+
+    if (!hasText && countOfIcons == 0) {
+        result.width = metrics->nodeMinWidth;
+        result.height = metrics->nodeMinHeight;
+    }
+
+    result.width += 2 * metrics->cellHorizontalPadding;
+    result.height += 2 * metrics->cellVerticalPadding;
+
+    if (kind == QMLayoutCellKindRoot) {
+        return QMLayoutSizeOfRootEllipse(result);
+    }
+
+    return result;
+}
+
+QMLayoutSize QMLayoutSizeOfRootEllipse(QMLayoutSize sizeOfCell) {
+    double x0 = sizeOfCell.width / 2;
+    double y0 = sizeOfCell.height / 2;
+    double s = y0 / x0;
+    double a = sqrt(pow(x0, 2.0) + (pow(x0, 4.0 / 3.0) * pow(y0, 2.0 / 3.0)) / pow(s, 2.0 / 3.0));
+    double b = sqrt(pow(a, 2.0) * pow(y0, 2.0) / (pow(a, 2.0) - pow(x0, 2.0)));
+
+    return layoutSize(2 * a, 2 * b);
+}
+
+QMLayoutSize QMLayoutSizeOfChildrenFamilyAddingChild(const QMLayoutMetrics *metrics, QMLayoutSize childrenFamilySize,
+        size_t indexOfChild, QMLayoutSize familySizeOfChild) {
+
+    QMLayoutSize result = childrenFamilySize;
+
+    result.width = fmax(result.width, familySizeOfChild.width);
+    result.height += familySizeOfChild.height;
+
+    if (indexOfChild > 0) {
+        result.height += metrics->internodeVerticalDistance;
+    }
+
+    return result;
+}
+
+QMLayoutSize QMLayoutSizeOfFamily(const QMLayoutMetrics *metrics, QMLayoutCellKind kind, QMLayoutSize size,
+        bool leafOrFolded, size_t countOfChildren, QMLayoutSize childrenFamilySize,
+        size_t countOfLeftChildren, QMLayoutSize leftChildrenFamilySize) {
+
+    if (leafOrFolded) {
+        return size;
+    }
+
+    double horDistance = metrics->internodeHorizontalDistance;
+
+    double familyWidth = size.width;
+    double familyHeight = 0.0;
+
+    QMLayoutSize result = layoutSize(familyWidth, familyHeight);
+    if (countOfChildren > 0) {
+        familyWidth += horDistance + childrenFamilySize.width;
+        familyHeight = fmax(size.height, childrenFamilySize.height);
+
+        result = layoutSize(familyWidth, familyHeight);
+    }
+
+    if (kind != QMLayoutCellKindRoot || countOfLeftChildren == 0) {
+        return result;
+    }
+
+    familyWidth += horDistance + leftChildrenFamilySize.width;
+
+    double heightToCompare = fmax(size.height, familyHeight);
+    familyHeight = fmax(heightToCompare, leftChildrenFamilySize.height);
+
+    return layoutSize(familyWidth, familyHeight);
+}
+
+QMLayoutPoint QMLayoutOriginOfCell(const QMLayoutMetrics *metrics, QMLayoutCellKind kind, QMLayoutSize size,
+        QMLayoutSize familySize, QMLayoutPoint familyOrigin, QMLayoutPoint parentOrigin,
+        size_t countOfLeftChildren, QMLayoutSize leftChildrenFamilySize) {
+
+    double horDistance = metrics->internodeHorizontalDistance;
+    double y = originYInFamily(size, familySize, familyOrigin);
+
+    switch (kind) {
+        case QMLayoutCellKindRoot:
+            if (countOfLeftChildren == 0) {
+                return layoutPoint(familyOrigin.x, y);
+            }
+
+            return layoutPoint(familyOrigin.x + leftChildrenFamilySize.width + horDistance, y);
+
+        case QMLayoutCellKindLeft:
+            return layoutPoint(parentOrigin.x - horDistance - size.width, y);
+
+        default:
+            return layoutPoint(familyOrigin.x, y);
+    }
+}
+
+QMLayoutPoint QMLayoutFamilyOriginOfChild(const QMLayoutMetrics *metrics, double x, double middleYOfParent,
+        size_t countOfChildren, QMLayoutSize childrenFamilySize, size_t index, QMLayoutSize familySizeOfChild,
+        QMLayoutPoint familyOriginOfPreviousChild, QMLayoutSize familySizeOfPreviousChild) {
+
+    if (countOfChildren == 1) {
+        return layoutPoint(x, middleYOfParent - familySizeOfChild.height / 2);
+    }
+
+    if (index == 0) {
+        return layoutPoint(x, middleYOfParent - childrenFamilySize.height / 2);
+    }
+
+    double y = familyOriginOfPreviousChild.y + familySizeOfPreviousChild.height + metrics->internodeVerticalDistance;
+    return layoutPoint(x, y);
+}
+
+QMLayoutPoint QMLayoutTextOriginOfCell(const QMLayoutMetrics *metrics, QMLayoutCellKind kind, QMLayoutRect frame,
+        QMLayoutSize textSize, QMLayoutSize iconSize, size_t countOfIcons, bool hasText) {
+
+    double horPadding = metrics->cellHorizontalPadding;
+    double iconTextDistance = countOfIcons > 0 ? metrics->iconTextDistance : 0;
+
+    if (!hasText) {
+        return layoutPoint(frame.x + horPadding, frame.y + metrics->cellVerticalPadding);
+    }
+
+    double y = frame.y + (frame.height - textSize.height) / 2;
+
+    switch (kind) {
+        case QMLayoutCellKindRoot: {
+            double middleX = frame.x + frame.width / 2;
+            double contentWidth = iconSize.width + iconTextDistance + textSize.width;
+
+            return layoutPoint(middleX - contentWidth / 2 + iconSize.width + iconTextDistance, y);
+        }
+
+        case QMLayoutCellKindLeft:
+            return layoutPoint(frame.x + horPadding, y);
+
+        default:
+            return layoutPoint(frame.x + horPadding + iconSize.width + iconTextDistance, y);
+    }
+}
+
+QMLayoutRect QMLayoutRegionFrameOfCell(QMLayoutCellKind kind, QMLayoutRect frame, QMLayoutRegion region) {
+    double x = frame.x;
+    double y = frame.y;
+    double width = frame.width;
+    double height = frame.height;
+
+    QMLayoutRect zeroRect = {0, 0, 0, 0};
+
+    if (kind == QMLayoutCellKindRoot) {
+        switch (region) {
+            case QMLayoutRegionEast:
+                return layoutRect(x + width / 2, y, width / 2, height);
+            case QMLayoutRegionWest:
+                return layoutRect(x, y, width / 2, height);
+            default:
+                return zeroRect;
+        }
+    }
+
+    if (kind == QMLayoutCellKindLeft) {
+        switch (region) {
+            case QMLayoutRegionWest:
+                return layoutRect(x, y, width / 2, height);
+            case QMLayoutRegionSouth:
+                return layoutRect(x + width / 2, y + height / 2, width / 2, height / 2);
+            case QMLayoutRegionNorth:
+                return layoutRect(x + width / 2, y, width / 2, height / 2);
+            default:
+                return zeroRect;
+        }
+    }
+
+    switch (region) {
+        case QMLayoutRegionEast:
+            return layoutRect(x + width / 2, y, width / 2, height);
+        case QMLayoutRegionSouth:
+            return layoutRect(x, y + height / 2, width / 2, height / 2);
+        case QMLayoutRegionNorth:
+            return layoutRect(x, y, width / 2, height / 2);
+        default:
+            return zeroRect;
+    }
+}
+
+static bool hasText(const QMLayoutNode *node) {
+    return node->text != NULL && node->text[0] != '\0';
+}
+
+static bool isLeafOrFolded(const QMLayoutNode *node) {
+    return node->folded || node->countOfChildren + node->countOfLeftChildren == 0;
+}
+
+static void computeSizesOfNode(QMLayoutNode *node, const QMLayoutMetrics *metrics,
+        QMLayoutMeasureText measureText, void *context) {
+
+    double maxTextWidth = node->kind == QMLayoutCellKindRoot ? metrics->maxRootCellTextWidth : metrics->maxTextNodeWidth;
+
+    node->iconSize = QMLayoutSizeOfIcons(metrics, node->countOfIcons);
+    node->textSize = hasText(node) ? measureText(context, node, maxTextWidth) : qLayoutZeroSize;
+    node->size = QMLayoutSizeOfCell(metrics, node->kind, node->textSize, node->iconSize, node->countOfIcons,
+            hasText(node), node->hasLink);
+
+    // like -[QMCell childrenFamilySize], the size of the children family of a folded node is empty
+    node->childrenFamilySize = qLayoutZeroSize;
+    node->leftChildrenFamilySize = qLayoutZeroSize;
+    if (!isLeafOrFolded(node)) {
+        for (size_t i = 0; i < node->countOfChildren; i++) {
+            node->childrenFamilySize = QMLayoutSizeOfChildrenFamilyAddingChild(metrics, node->childrenFamilySize, i,
+                    node->children[i]->familySize);
+        }
+
+        for (size_t i = 0; i < node->countOfLeftChildren; i++) {
+            node->leftChildrenFamilySize = QMLayoutSizeOfChildrenFamilyAddingChild(metrics,
+                    node->leftChildrenFamilySize, i, node->leftChildren[i]->familySize);
+        }
+    }
+
+    node->familySize = QMLayoutSizeOfFamily(metrics, node->kind, node->size, isLeafOrFolded(node),
+            node->countOfChildren, node->childrenFamilySize, node->countOfLeftChildren, node->leftChildrenFamilySize);
+}
+
+static void computeFamilyOriginsOfChildren(QMLayoutNode **children, size_t countOfChildren,
+        QMLayoutSize childrenFamilySize, double x, double middleYOfParent, const QMLayoutMetrics *metrics) {
+
+    for (size_t i = 0; i < countOfChildren; i++) {
+        QMLayoutNode *child = children[i];
+        QMLayoutNode *previousChild = i > 0 ? children[i - 1] : child;
+
+        child->familyOrigin = QMLayoutFamilyOriginOfChild(metrics, x, middleYOfParent, countOfChildren,
+                childrenFamilySize, i, child->familySize, previousChild->familyOrigin, previousChild->familySize);
+    }
+}
+
+static void computeOriginsOfNode(QMLayoutNode *node, const QMLayoutMetrics *metrics) {
+    QMLayoutPoint parentOrigin = node->parent != NULL ? node->parent->origin : layoutPoint(0, 0);
+
+    node->origin = QMLayoutOriginOfCell(metrics, node->kind, node->size, node->familySize, node->familyOrigin,
+            parentOrigin, node->countOfLeftChildren, node->leftChildrenFamilySize);
+
+    QMLayoutRect frame = layoutRect(node->origin.x, node->origin.y, node->size.width, node->size.height);
+    node->textOrigin = QMLayoutTextOriginOfCell(metrics, node->kind, frame, node->textSize, node->iconSize,
+            node->countOfIcons, hasText(node));
+
+    // the children of folded nodes are not laid out, see QMLayoutComputeGeometry()
+    if (isLeafOrFolded(node)) {
+        return;
+    }
+
+    double middleY = node->origin.y + node->size.height / 2;
+
+    if (node->kind == QMLayoutCellKindLeft) {
+        computeFamilyOriginsOfChildren(node->children, node->countOfChildren, node->childrenFamilySize,
+                node->familyOrigin.x, middleY, metrics);
+        return;
+    }
+
+    double x = node->origin.x + node->size.width + metrics->internodeHorizontalDistance;
+    computeFamilyOriginsOfChildren(node->children, node->countOfChildren, node->childrenFamilySize, x, middleY,
+            metrics);
+
+    if (node->kind == QMLayoutCellKindRoot) {
+        computeFamilyOriginsOfChildren(node->leftChildren, node->countOfLeftChildren, node->leftChildrenFamilySize,
+                node->familyOrigin.x, middleY, metrics);
+    }
+}
+
+static void setParentOfChildren(QMLayoutNode *parent, QMLayoutNode **children, size_t count, QMLayoutCellKind kind) {
+    for (size_t i = 0; i < count; i++) {
+        children[i]->parent = parent;
+        children[i]->kind = kind;
+        children[i]->indexWithinParent = i;
+    }
+}
+
+bool QMLayoutComputeGeometry(QMLayoutNode *rootNode, const QMLayoutMetrics *metrics,
+        QMLayoutMeasureText measureText, void *context) {
+
+    size_t capacity = 64;
+    size_t countOfNodes = 0;
+    QMLayoutNode **nodesInLevelOrder = malloc(capacity * sizeof(QMLayoutNode *));
+    if (nodesInLevelOrder == NULL) {
+        return false;
+    }
+
+    rootNode->parent = NULL;
+    rootNode->kind = QMLayoutCellKindRoot;
+    rootNode->indexWithinParent = 0;
+    nodesInLevelOrder[countOfNodes++] = rootNode;
+
+    // the array is at the same time the queue of the breadth first walk, thus, parents are before their children
+    for (size_t i = 0; i < countOfNodes; i++) {
+        QMLayoutNode *node = nodesInLevelOrder[i];
+
+        // the descendants of folded nodes are not visible and do not contribute to the family size
+        if (node->folded) {
+            continue;
+        }
+
+        QMLayoutCellKind kindOfChildren = node->kind == QMLayoutCellKindLeft ? QMLayoutCellKindLeft : QMLayoutCellKindRight;
+        setParentOfChildren(node, node->children, node->countOfChildren, kindOfChildren);
+        setParentOfChildren(node, node->leftChildren, node->countOfLeftChildren, QMLayoutCellKindLeft);
+
+        size_t countOfChildren = node->countOfChildren + node->countOfLeftChildren;
+        if (countOfNodes + countOfChildren > capacity) {
+            while (countOfNodes + countOfChildren > capacity) {
+                capacity *= 2;
+            }
+
+            QMLayoutNode **enlargedNodes = realloc(nodesInLevelOrder, capacity * sizeof(QMLayoutNode *));
+            if (enlargedNodes == NULL) {
+                free(nodesInLevelOrder);
+                return false;
+            }
+            nodesInLevelOrder = enlargedNodes;
+        }
+
+        for (size_t j = 0; j < node->countOfChildren; j++) {
+            nodesInLevelOrder[countOfNodes++] = node->children[j];
+        }
+        for (size_t j = 0; j < node->countOfLeftChildren; j++) {
+            nodesInLevelOrder[countOfNodes++] = node->leftChildren[j];
+        }
+    }
+
+    // children before their parents
+    for (size_t i = countOfNodes; i > 0; i--) {
+        computeSizesOfNode(nodesInLevelOrder[i - 1], metrics, measureText, context);
+    }
+
+    // parents before their children
+    for (size_t i = 0; i < countOfNodes; i++) {
+        computeOriginsOfNode(nodesInLevelOrder[i], metrics);
+    }
+
+    free(nodesInLevelOrder);
+    return true;
+}
@@ -0,0 +1,176 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#ifndef QM_LAYOUT_CORE_H
+#define QM_LAYOUT_CORE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+* Platform independent geometry of mindmap cells: plain C without Cocoa such that the layout can be profiled and tested
+* headless, eg on Linux. QMCellSizeManager and QMCellLayoutManager use the per-cell functions for QMCell;
+* QMLayoutComputeGeometry() lays out a whole tree of QMLayoutNode using a text measurement callback.
+*
+* The coordinate system is flipped like the one of QMMindmapView, ie y grows downwards.
+*/
+
+typedef struct {
+    double width;
+    double height;
+} QMLayoutSize;
+
+typedef struct {
+    double x;
+    double y;
+} QMLayoutPoint;
+
+typedef struct {
+    double x;
+    double y;
+    double width;
+    double height;
+} QMLayoutRect;
+
+/**
+* The distances and sizes of QMAppSettings the geometry depends on.
+*/
+typedef struct {
+    double cellHorizontalPadding;
+    double cellVerticalPadding;
+    double iconDrawSize;
+    double interIconDistance;
+    double iconTextDistance;
+    double linkIconDrawSize;
+    double linkIconHorizontalMargin;
+    double nodeMinWidth;
+    double nodeMinHeight;
+    double internodeHorizontalDistance;
+    double internodeVerticalDistance;
+    double maxTextNodeWidth;
+    double maxRootCellTextWidth;
+} QMLayoutMetrics;
+
+typedef enum {
+    QMLayoutCellKindRight = 0,
+    QMLayoutCellKindLeft,
+    QMLayoutCellKindRoot,
+} QMLayoutCellKind;
+
+/**
+* Same order as QMCellRegion.
+*/
+typedef enum {
+    QMLayoutRegionNone = 0,
+    QMLayoutRegionEast,
+    QMLayoutRegionWest,
+    QMLayoutRegionSouth,
+    QMLayoutRegionNorth,
+} QMLayoutRegion;
+
+// cell
+
+QMLayoutSize QMLayoutSizeOfIcons(const QMLayoutMetrics *metrics, size_t countOfIcons);
+
+/**
+* Returns the complete size of the cell, ie including icons, text, link icon and paddings. The root cell is an ellipse
+* containing all that.
+*/
+QMLayoutSize QMLayoutSizeOfCell(const QMLayoutMetrics *metrics, QMLayoutCellKind kind, QMLayoutSize textSize,
+        QMLayoutSize iconSize, size_t countOfIcons, bool hasText, bool hasLink);
+
+QMLayoutSize QMLayoutSizeOfRootEllipse(QMLayoutSize sizeOfCell);
+
+/**
+* Returns the size of the children family after adding the child with the given family size. Start with an empty size
+* and add the children in order.
+*/
+QMLayoutSize QMLayoutSizeOfChildrenFamilyAddingChild(const QMLayoutMetrics *metrics, QMLayoutSize childrenFamilySize,
+        size_t indexOfChild, QMLayoutSize familySizeOfChild);
+
+/**
+* The left children are only relevant for the root cell: pass 0 otherwise.
+*/
+QMLayoutSize QMLayoutSizeOfFamily(const QMLayoutMetrics *metrics, QMLayoutCellKind kind, QMLayoutSize size,
+        bool leafOrFolded, size_t countOfChildren, QMLayoutSize childrenFamilySize,
+        size_t countOfLeftChildren, QMLayoutSize leftChildrenFamilySize);
+
+/**
+* Returns the origin of the cell itself within its family frame. The parent origin is only used for left cells and the
+* left children family size only for the root cell.
+*/
+QMLayoutPoint QMLayoutOriginOfCell(const QMLayoutMetrics *metrics, QMLayoutCellKind kind, QMLayoutSize size,
+        QMLayoutSize familySize, QMLayoutPoint familyOrigin, QMLayoutPoint parentOrigin,
+        size_t countOfLeftChildren, QMLayoutSize leftChildrenFamilySize);
+
+/**
+* Returns the family origin of the child at the given index, children being stacked vertically and centered at the
+* middle of the parent. The previous child is only used for an index > 0.
+*/
+QMLayoutPoint QMLayoutFamilyOriginOfChild(const QMLayoutMetrics *metrics, double x, double middleYOfParent,
+        size_t countOfChildren, QMLayoutSize childrenFamilySize, size_t index, QMLayoutSize familySizeOfChild,
+        QMLayoutPoint familyOriginOfPreviousChild, QMLayoutSize familySizeOfPreviousChild);
+
+QMLayoutPoint QMLayoutTextOriginOfCell(const QMLayoutMetrics *metrics, QMLayoutCellKind kind, QMLayoutRect frame,
+        QMLayoutSize textSize, QMLayoutSize iconSize, size_t countOfIcons, bool hasText);
+
+QMLayoutRect QMLayoutRegionFrameOfCell(QMLayoutCellKind kind, QMLayoutRect frame, QMLayoutRegion region);
+
+// tree
+
+typedef struct QMLayoutNode QMLayoutNode;
+
+/**
+* Returns the size of the text of the node when wrapped at the given width.
+*/
+typedef QMLayoutSize (*QMLayoutMeasureText)(void *context, const QMLayoutNode *node, double maxWidth);
+
+struct QMLayoutNode {
+    // input
+    const char *text;
+    void *userData;
+    size_t countOfIcons;
+    bool hasLink;
+    bool folded;
+
+    QMLayoutNode **children;
+    size_t countOfChildren;
+
+    /**
+    * Only for the root node.
+    */
+    QMLayoutNode **leftChildren;
+    size_t countOfLeftChildren;
+
+    // output
+    QMLayoutSize textSize;
+    QMLayoutSize iconSize;
+    QMLayoutSize size;
+    QMLayoutSize childrenFamilySize;
+    QMLayoutSize leftChildrenFamilySize;
+    QMLayoutSize familySize;
+    QMLayoutPoint origin;
+    QMLayoutPoint familyOrigin;
+    QMLayoutPoint textOrigin;
+
+    // set by QMLayoutComputeGeometry()
+    QMLayoutNode *parent;
+    QMLayoutCellKind kind;
+    size_t indexWithinParent;
+};
+
+/**
+* Computes all sizes and origins of the tree like -[QMCell computeGeometry] does for cells. The family origin of the
+* root node has to be set beforehand. Does not recurse, thus, the depth of the tree is only limited by the memory.
+* The descendants of folded nodes are skipped, ie neither measured nor laid out. Returns false when the memory for the
+* traversal could not be allocated.
+*/
+bool QMLayoutComputeGeometry(QMLayoutNode *rootNode, const QMLayoutMetrics *metrics,
+        QMLayoutMeasureText measureText, void *context);
+
+#endif
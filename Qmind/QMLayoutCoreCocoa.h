@@ -0,0 +1,50 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import <Cocoa/Cocoa.h>
+#import "QMLayoutCore.h"
+#import "QMCell.h"
+
+/**
+* Conversions between the geometry types of Cocoa and of the layout core.
+*/
+
+static inline QMLayoutSize QMLayoutSizeFromNSSize(NSSize size) {
+    QMLayoutSize result = {size.width, size.height};
+    return result;
+}
+
+static inline NSSize NSSizeFromQMLayoutSize(QMLayoutSize size) {
+    return NSMakeSize((CGFloat) size.width, (CGFloat) size.height);
+}
+
+static inline QMLayoutPoint QMLayoutPointFromNSPoint(NSPoint point) {
+    QMLayoutPoint result = {point.x, point.y};
+    return result;
+}
+
+static inline NSPoint NSPointFromQMLayoutPoint(QMLayoutPoint point) {
+    return NSMakePoint((CGFloat) point.x, (CGFloat) point.y);
+}
+
+static inline QMLayoutRect QMLayoutRectFromNSRect(NSRect rect) {
+    QMLayoutRect result = {rect.origin.x, rect.origin.y, rect.size.width, rect.size.height};
+    return result;
+}
+
+static inline NSRect NSRectFromQMLayoutRect(QMLayoutRect rect) {
+    return NSMakeRect((CGFloat) rect.x, (CGFloat) rect.y, (CGFloat) rect.width, (CGFloat) rect.height);
+}
+
+static inline QMLayoutCellKind QMLayoutCellKindOfCell(QMCell *cell) {
+    if (cell.isRoot) {
+        return QMLayoutCellKindRoot;
+    }
+
+    return cell.isLeft ? QMLayoutCellKindLeft : QMLayoutCellKindRight;
+}
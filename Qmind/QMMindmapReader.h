@@ -15,7 +15,7 @@
 
 /**
 * A mindmap document model which uses the Node class to internally represent the mindmap node. Reads the mindmap XML file
-* event-driven and builds up the rootNode.
+* event-driven and builds up the rootNode. The depth of the map is not limited, see QMXmlParser.
 *
 * @implements NSXMLParserDelegate
 */
@@ -11,6 +11,8 @@
 #import "QMNode.h"
 #import "QMProxyNode.h"
 #import "QMRootNode.h"
+#import "QMTrace.h"
+#import "QMXmlParser.h"
 
 static NSString * const qMapKey = @"map";
 static NSString * const qDefaultsVersionKey = @"version";
@@ -25,14 +27,27 @@ static NSString * const qNodeKey = @"node";
 
 #pragma mark Public
 - (QMRootNode *)rootNodeForFileUrl:(NSURL *)fileUrl {
+    QM_TRACE_SCOPE("read mindmap");
+
     _fileUrl = fileUrl;
 
+    // the reader is a singleton: do not return the root node of the previously read file
+    _rootNode = nil;
+    _proxyRoot = nil;
+
     if (![[NSFileManager defaultManager] fileExistsAtPath:[fileUrl path]]) {
         log4Warn(@"File %@ does not exist!", [fileUrl path]);
         return nil;
     }
 
-    NSXMLParser *xmlParser = [[NSXMLParser alloc] initWithContentsOfURL:_fileUrl];
+    NSData *data = [NSData dataWithContentsOfURL:_fileUrl options:NSDataReadingMappedIfSafe error:NULL];
+    if (data == nil) {
+        log4Warn(@"File %@ could not be read!", [fileUrl path]);
+        return nil;
+    }
+
+    // NSXMLParser refuses maps deeper than 256 levels
+    NSXMLParser *xmlParser = [[QMXmlParser alloc] initWithData:data];
 
     [xmlParser setDelegate:self];
     [xmlParser setShouldResolveExternalEntities:NO];
@@ -20,6 +20,9 @@
 @class QMCellEditor;
 @class QMCellLayoutManager;
 @class QMUiDrawer;
+@class QMLayoutContext;
+@class QMCellPool;
+@class QMDamageTracker;
 
 static const NSSize qUnitSize = {1.0, 1.0};
 static const CGFloat qMinZoomFactor = 0.01;
@@ -40,6 +43,21 @@ static const int qDeleteAllIconsMenuItemTag = 1100;
 @property (weak, readonly) id<QMMindmapViewDataSource> dataSource;
 @property (readonly) QMRootCell *rootCell;
 
+/**
+* Shared by all cells and icons of this view.
+*/
+@property (readonly) QMLayoutContext *layoutContext;
+
+/**
+* The cells of the old tree are recycled in this pool when the view is rebuilt.
+*/
+@property (readonly) QMCellPool *cellPool;
+
+/**
+* Changes which do not move any cell, eg selecting or editing, repaint only the rects collected in this tracker.
+*/
+@property (readonly) QMDamageTracker *damageTracker;
+
 #pragma mark Public
 - (void)updateCanvasSize;
 
@@ -55,17 +73,34 @@ static const int qDeleteAllIconsMenuItemTag = 1100;
 
 - (void)toggleFoldingOfSelectedCell;
 
+/**
+* Replaces the selection with all children of the selected cell; the left children when the root cell without right
+* children is selected.
+*/
+- (void)selectChildrenOfSelectedCell;
+
 - (BOOL)hasSelectedCells;
 - (BOOL)cellIsSelected:(QMCell *)cell;
 - (BOOL)cellIsCurrentlyEdited:(QMCell *)cell;
 
 - (NSArray *)selectedCells;
 - (void)clearSelection;
+
+/**
+* Replaces the selection with the cell of the given identifier and scrolls to make it visible.
+*/
+- (void)selectCellWithIdentifier:(id)identifier;
 - (BOOL)rootCellSelected;
 
 - (void)updateFontOfSelectedCellsToFont:(NSFont *)newFont;
 - (void)updateCellWithIdentifier:(id)identifier;
 - (void)updateCellFoldingWithIdentifier:(id)identifier;
+
+/**
+* Updates the folding of the cell of the given identifier and all its descendants in one pass and then the canvas
+* once, keeping the cell of the anchor identifier in place when visible.
+*/
+- (void)updateCellFoldingInFamilyWithIdentifier:(id)identifier anchorIdentifier:(id)anchorIdentifier;
 - (void)updateCellFamilyForRemovalWithIdentifier:(id)identifier;
 - (void)updateLeftCellFamilyForRemovalWithIdentifier:(id)identifier;
 - (void)updateCellFamilyForInsertionWithIdentifier:(id)identifier;
@@ -75,7 +110,12 @@ static const int qDeleteAllIconsMenuItemTag = 1100;
 
 -(void)endEditing;
 -(NSPoint)middlePointOfVisibleRect;
-- (void)updateCanvasWithOldClipViewOrigin:(NSPoint)oldClipViewOrigin oldClipViewSize:(NSSize)oldClipViewSize oldCenterInView:(NSPoint)oldCenterInView;
+
+/**
+* Adapts the margin around the map to the resized clip view and keeps the map where it was. The cells are not laid out
+* again.
+*/
+- (void)updateCanvasWithOldClipViewOrigin:(NSPoint)oldClipViewOrigin;
 
 #pragma mark QMCellEditorDelegate
 - (void)editingEndedWithString:(NSAttributedString *)newAttrStr forCell:(QMCell *)editedCell byChar:(unichar)character;
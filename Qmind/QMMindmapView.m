@@ -23,6 +23,10 @@
 #import "QMIcon.h"
 #import "QMCellPropertiesManager.h"
 #import "QMBorderedView.h"
+#import "QMLayoutContext.h"
+#import "QMTrace.h"
+#import "QMCellPool.h"
+#import "QMDamageTracker.h"
 
 
 static const CGFloat qZoomScrollWheelStep = 0.25;
@@ -165,6 +169,15 @@ TB_MANUALWIRE(cellSelector)
   [self.cellStateManager clearSelection];
 }
 
+- (void)selectCellWithIdentifier:(id)identifier {
+  QMCell *cell = [self.cellSelector cellWithIdentifier:identifier fromParentCell:self.rootCell];
+  if (cell == nil) {
+    return;
+  }
+
+  [self replaceSelectionWithCellAndRedisplay:cell];
+}
+
 - (BOOL)rootCellSelected {
   if (![self.cellStateManager hasSelectedCells]) {
     return NO;
@@ -187,24 +200,18 @@ TB_MANUALWIRE(cellSelector)
     [self.cellEditor endEditing];
   }
 
-  [self setFrameSize:[self scaledBoundsSizeWithParentSize:self.superview.frame.size]];
+  [self layoutCells];
+  [self updateCanvasBoundsWithParentSize:self.superview.frame.size];
   [self setNeedsDisplay:YES];
 }
 
-- (void)updateCanvasWithOldClipViewOrigin:(NSPoint)oldClipViewOrigin oldClipViewSize:(NSSize)oldClipViewSize oldCenterInView:(NSPoint)oldCenterInView {
-  NSPoint oldMapOrigin = [self rootCellOriginForParentSize:oldClipViewSize];
-  NSSize oldDist = NewSize(oldCenterInView.x - oldClipViewOrigin.x, oldCenterInView.y - oldClipViewOrigin.y);
-
-  [self updateCanvasSize];
-
-  NSClipView *clipView = self.enclosingScrollView.contentView;
-  NSSize newParentSize = [self convertSize:clipView.frame.size fromView:clipView];
-  NSPoint newMapOrigin = [self rootCellOriginForParentSize:newParentSize];
+- (void)updateCanvasWithOldClipViewOrigin:(NSPoint)oldClipViewOrigin {
+  QM_TRACE_SCOPE("resize canvas");
 
-  NSSize deltaMapOrigin = NewSize(oldMapOrigin.x - newMapOrigin.x, oldMapOrigin.y - newMapOrigin.y);
-  NSPoint newScrollPt = NewPoint(oldCenterInView.x - deltaMapOrigin.width - oldDist.width, oldCenterInView.y - deltaMapOrigin.height - oldDist.height);
+  [self updateCanvasBoundsWithParentSize:self.superview.frame.size];
 
-  [self scrollPoint:newScrollPt];
+  // the cells do not move in the coordinates of the view when the clip view is resized
+  [self scrollPoint:oldClipViewOrigin];
   [self setNeedsDisplay:YES];
 }
 
@@ -229,6 +236,28 @@ TB_MANUALWIRE(cellSelector)
   [self.dataSource mindmapView:self toggleFoldingForItem:[[self.cellStateManager selectedCells][0] identifier]];
 }
 
+- (void)selectChildrenOfSelectedCell {
+  QMCell *selCell = self.cellStateManager.selectedCells.lastObject;
+
+  NSArray *children = selCell.children;
+  if (children.count == 0 && selCell.isRoot) {
+    children = [(QMRootCell *) selCell leftChildren];
+  }
+
+  if (children.count == 0) {
+    return;
+  }
+
+  [self.damageTracker addCells:self.cellStateManager.selectedCells];
+
+  [self.cellStateManager clearSelection];
+  [self.cellStateManager addCellToSelection:children[0] modifier:0];
+  [self.cellStateManager addCellToSelection:children.lastObject modifier:NSShiftKeyMask];
+
+  [self.damageTracker addCells:self.cellStateManager.selectedCells];
+  [self.damageTracker invalidateView:self];
+}
+
 - (BOOL)hasSelectedCells {
   return self.cellStateManager.hasSelectedCells;
 }
@@ -244,6 +273,9 @@ TB_MANUALWIRE(cellSelector)
 - (void)updateCellWithIdentifier:(id)identifier {
   QMCell *cellToUpdate = [self.cellSelector cellWithIdentifier:identifier fromParentCell:self.rootCell];
 
+  NSSize oldSize = cellToUpdate.size;
+  [self.damageTracker addCell:cellToUpdate];
+
   NSString *const stringValueOfItem = [self.dataSource mindmapView:self stringValueOfItem:identifier];
   if (![cellToUpdate.stringValue isEqualToString:stringValueOfItem]) {
     cellToUpdate.stringValue = stringValueOfItem;
@@ -260,6 +292,18 @@ TB_MANUALWIRE(cellSelector)
   }
   [self.cellPropertiesManager fillIconsOfCell:cellToUpdate];
 
+  // the family sizes and thus all other cells only move when the size of the cell changes
+  if (NSEqualSizes(oldSize, cellToUpdate.size)) {
+    [cellToUpdate computeGeometry];
+
+    [self.damageTracker addCell:cellToUpdate];
+    [self.damageTracker invalidateView:self];
+
+    return;
+  }
+
+  [self.damageTracker reset];
+
   [self updateCanvasSize];
   [self setNeedsDisplay:YES];
 }
@@ -269,57 +313,29 @@ TB_MANUALWIRE(cellSelector)
   BOOL folded = [self.dataSource mindmapView:self isItemFolded:identifier];
   [cellToUpdate setFolded:folded];
 
-  NSRect visibleRect = [self visibleRect];
-  BOOL cellVisible = NO;
-  if (NSIntersectsRect(visibleRect, cellToUpdate.frame)) {
-    cellVisible = YES;
-  }
-
-  if (cellVisible) {
-    NSPoint cellOrigin = cellToUpdate.origin;
-    NSPoint visibleOrigin = visibleRect.origin;
-    NSSize distFromVisibleRect = NewSize(cellOrigin.x - visibleOrigin.x, cellOrigin.y - visibleOrigin.y);
-
-    [self updateCanvasSize];
-    QMCell *const newCell = [self.cellSelector cellWithIdentifier:identifier fromParentCell:self.rootCell];
-
-    NSPoint newCellOrigin = newCell.origin;
-    NSPoint newVisibleRectOrigin = NewPoint(newCellOrigin.x - distFromVisibleRect.width, newCellOrigin.y - distFromVisibleRect.height);
+  [self updateCanvasSizeKeepingCell:cellToUpdate withIdentifier:identifier];
+}
 
-    // [self scrollPoint:newVisibleRectOrigin] animates the scrolling, we don't want that
-    NSPoint newVisibleRectOriginInClipView = [self convertPoint:newVisibleRectOrigin toView:self.superview];
-    [self.enclosingScrollView.contentView setBoundsOrigin:newVisibleRectOriginInClipView];
-    [self setNeedsDisplay:YES];
+- (void)updateCellFoldingInFamilyWithIdentifier:(id)identifier anchorIdentifier:(id)anchorIdentifier {
+  QMCell *familyCell = [self.cellSelector cellWithIdentifier:identifier fromParentCell:self.rootCell];
 
-    return;
+  QMStack *cellStack = [[NSMutableArray alloc] initWithCapacity:15];
+  [cellStack push:familyCell];
+  while (cellStack.count > 0) {
+    QMCell *cell = [cellStack pop];
+    cell.folded = [self.dataSource mindmapView:self isItemFolded:cell.identifier];
+    [cellStack pushArray:cell.allChildren];
   }
 
-  [self updateCanvasSize];
-  QMCell *const newCell = [self.cellSelector cellWithIdentifier:identifier fromParentCell:self.rootCell];
-
-  [self scrollRectToVisible:newCell.familyFrame];
-  [self scrollRectToVisible:newCell.frame];
-
-  [self setNeedsDisplay:YES];
+  QMCell *anchorCell = [self.cellSelector cellWithIdentifier:anchorIdentifier fromParentCell:familyCell];
+  [self updateCanvasSizeKeepingCell:anchorCell withIdentifier:anchorIdentifier];
 }
 
 - (void)updateCellFamilyForRemovalWithIdentifier:(id)identifier {
   NSArray *idArray = [self allChildrenIdentifierOfIdentifier:identifier];
-
   QMCell *parentCell = [self.cellSelector cellWithIdentifier:identifier fromParentCell:self.rootCell];
-  QMCell *cellToDel;
-  if (idArray.count == 0) {
-    cellToDel = parentCell.children.lastObject;
-  } else {
-    for (QMCell *cell in parentCell.children) {
-      if (![idArray containsObject:cell.identifier]) {
-        cellToDel = cell;
-        break;
-      }
-    }
-  }
 
-  [parentCell removeChild:cellToDel];
+  [self removeCells:parentCell.children ofParentCell:parentCell notContainedInIdentifiers:idArray];
 
   [self updateCanvasSize];
   [self setNeedsDisplay:YES];
@@ -328,19 +344,7 @@ TB_MANUALWIRE(cellSelector)
 - (void)updateLeftCellFamilyForRemovalWithIdentifier:(id)identifier {
   NSArray *idArray = [self leftChildrenIdentifierOfRootCell];
 
-  QMCell *cellToDel;
-  if (idArray.count == 0) {
-    cellToDel = [self.rootCell.leftChildren lastObject];
-  } else {
-    for (QMCell *cell in self.rootCell.leftChildren) {
-      if (![idArray containsObject:cell.identifier]) {
-        cellToDel = cell;
-        break;
-      }
-    }
-  }
-
-  [self.rootCell removeChild:cellToDel];
+  [self removeCells:self.rootCell.leftChildren ofParentCell:self.rootCell notContainedInIdentifiers:idArray];
 
   [self updateCanvasSize];
   [self setNeedsDisplay:YES];
@@ -375,40 +379,9 @@ we only test the begin edit part... We are being to lazy here...
 - (void)updateCellFamilyForInsertionWithIdentifier:(id)parentId {
   NSArray *idArray = [self leftChildrenIdentifierOfIdentifier:parentId];
   QMCell *parentCell = [self.cellSelector cellWithIdentifier:parentId fromParentCell:self.rootCell];
-  NSUInteger maxIndex = [idArray count] - 1;
-
-  __block NSUInteger indexToInsert;
-  __block id itemToInsert;
-
-  if (parentCell.countOfChildren == 0) {
-    indexToInsert = 0;
-    itemToInsert = [idArray lastObject];
-  } else {
-    [idArray enumerateObjectsUsingBlock:^(id item, NSUInteger index, BOOL *stop) {
-      if (index == maxIndex) {
-        indexToInsert = index;
-        itemToInsert = item;
-        *stop = YES;
-        return;
-      }
-
-      if ([[parentCell objectInChildrenAtIndex:index] identifier] != item) {
-        indexToInsert = index;
-        itemToInsert = item;
-        *stop = YES;
-        return;
-      }
-    }];
-  }
-
   const BOOL parentIsLeft = [self.dataSource mindmapView:self isItemLeft:parentId];
 
-  QMCell *cellToInsert = [[QMCell alloc] initWithView:self];
-  cellToInsert.left = parentIsLeft;
-  [self.cellPropertiesManager fillCellPropertiesWithIdentifier:itemToInsert cell:cellToInsert];
-  [self.cellPropertiesManager fillAllChildrenWithIdentifier:itemToInsert cell:cellToInsert];
-
-  [parentCell insertObject:cellToInsert inChildrenAtIndex:indexToInsert];
+  [self insertCellsForIdentifiers:idArray intoParentCell:parentCell left:parentIsLeft];
 
   [self updateCanvasSize];
   [self setNeedsDisplay:YES];
@@ -417,39 +390,7 @@ we only test the begin edit part... We are being to lazy here...
 - (void)updateLeftCellFamilyForInsertionWithIdentifier:(id)identifier {
   NSArray *leftIdArray = [self leftChildrenIdentifierOfRootCell];
 
-  NSUInteger maxIndex = [leftIdArray count] - 1;
-
-  __block NSUInteger indexToInsert;
-  __block id itemToInsert;
-
-  if (self.rootCell.countOfChildren == 0) {
-    indexToInsert = 0;
-    itemToInsert = [leftIdArray lastObject];
-  } else {
-    [leftIdArray enumerateObjectsUsingBlock:^(id item, NSUInteger index, BOOL *stop) {
-      if (index == maxIndex) {
-        indexToInsert = index;
-        itemToInsert = item;
-        *stop = YES;
-        return;
-      }
-
-      if ([[self.rootCell objectInLeftChildrenAtIndex:index] identifier] != item) {
-        indexToInsert = index;
-        itemToInsert = item;
-        *stop = YES;
-        return;
-      }
-    }];
-  }
-
-  QMCell *cellToInsert = [[QMCell alloc] initWithView:self];
-  cellToInsert.left = YES;
-
-  [self.cellPropertiesManager fillCellPropertiesWithIdentifier:itemToInsert cell:cellToInsert];
-  [self.cellPropertiesManager fillAllChildrenWithIdentifier:itemToInsert cell:cellToInsert];
-
-  [self.rootCell insertObject:cellToInsert inLeftChildrenAtIndex:indexToInsert];
+  [self insertCellsForIdentifiers:leftIdArray intoParentCell:self.rootCell left:YES];
 
   [self updateCanvasSize];
   [self setNeedsDisplay:YES];
@@ -458,14 +399,15 @@ we only test the begin edit part... We are being to lazy here...
 - (void)initMindmapViewWithDataSource:(id <QMMindmapViewDataSource>)aDataSource {
   _currentScale = NewSize(1, 1);
   _dataSource = aDataSource;
+  [self recycleCells];
   _cellPropertiesManager = [[QMCellPropertiesManager alloc] initWithMindmapView:self];
 
   _rootCell = (QMRootCell *) [self.cellPropertiesManager cellWithParent:nil itemOfParent:nil];
-  [self registerForDraggedTypes:@[qNodeUti]];
-
-  NSSize parentSize = self.superview.frame.size;
+  [self.cellPool trimToSizeOfTreeOfCell:_rootCell];
+  [self registerForDraggedTypes:@[qNodeReferenceUti]];
 
-  [self setFrameSize:[self scaledBoundsSizeWithParentSize:parentSize]];
+  [self layoutCells];
+  [self updateCanvasBoundsWithParentSize:self.superview.frame.size];
   [self scrollToCenter];
   [self setNeedsDisplay:YES];
 }
@@ -523,9 +465,9 @@ we only test the begin edit part... We are being to lazy here...
   if (oldDragTargetCell != newDragTargetCell) {
     oldDragTargetCell.dragRegion = QMCellRegionNone;
 
-    // We don't do the following, since we scroll during dragging
-    //[self displayRect:oldDragTargetCell.nodeCellFrame];
-    [self setNeedsDisplay:YES];
+    // We don't use -displayRect:, since we scroll during dragging
+    [self.damageTracker addCell:oldDragTargetCell];
+    [self.damageTracker invalidateView:self];
   }
 
   self.cellStateManager.dragTargetCell = newDragTargetCell;
@@ -544,8 +486,8 @@ we only test the begin edit part... We are being to lazy here...
 - (BOOL)performDragOperation:(id <NSDraggingInfo>)sender {
   NSPasteboard *pasteboard = [sender draggingPasteboard];
 
-  // As of now we only accept our own Node as drag & drop item
-  if ([[pasteboard types] containsObject:qNodeUti] == NO) {
+  // As of now we only accept references of our own nodes as drag & drop item: the cells carry the identities
+  if ([[pasteboard types] containsObject:qNodeReferenceUti] == NO) {
     return NO;
   }
 
@@ -877,6 +819,9 @@ we only test the begin edit part... We are being to lazy here...
   if ((self = [super initWithFrame:frame])) {
     [[TBContext sharedContext] autowireSeed:self];
 
+    _layoutContext = [[QMLayoutContext alloc] init];
+    _cellPool = [[QMCellPool alloc] initWithView:self layoutContext:_layoutContext];
+    _damageTracker = [[QMDamageTracker alloc] init];
     _cellStateManager = [[QMCellStateManager alloc] init];
     _cellEditor = [[QMCellEditor alloc] init];
     _cellEditor.view = self;
@@ -954,6 +899,9 @@ we only test the begin edit part... We are being to lazy here...
 }
 
 - (void)drawRect:(NSRect)dirtyRect {
+  QM_TRACE_SCOPE("draw");
+  QM_TRACE_COUNT("rects drawn", 1);
+
   [super drawRect:dirtyRect];
 
   [self.rootCell drawRect:dirtyRect];
@@ -964,6 +912,57 @@ we only test the begin edit part... We are being to lazy here...
 }
 
 #pragma mark Private
+/**
+* Puts the cells of the current tree into the pool before they get replaced. The selection and the drag state refer to
+* the old cells, thus, they are cleared. When a cell is being edited, the old cells are left to ARC.
+*/
+- (void)recycleCells {
+  if (_rootCell == nil || self.cellEditor.isEditing) {
+    return;
+  }
+
+  [self.cellStateManager clearSelection];
+  [self.cellStateManager clearCellsForDrag];
+
+  [self.cellPool recycleDescendantsOfCell:_rootCell];
+  _rootCell = nil;
+}
+
+- (void)updateCanvasSizeKeepingCell:(QMCell *)cellToUpdate withIdentifier:(id)identifier {
+  NSRect visibleRect = [self visibleRect];
+  BOOL cellVisible = NO;
+  if (NSIntersectsRect(visibleRect, cellToUpdate.frame)) {
+    cellVisible = YES;
+  }
+
+  if (cellVisible) {
+    NSPoint cellOrigin = cellToUpdate.origin;
+    NSPoint visibleOrigin = visibleRect.origin;
+    NSSize distFromVisibleRect = NewSize(cellOrigin.x - visibleOrigin.x, cellOrigin.y - visibleOrigin.y);
+
+    [self updateCanvasSize];
+    QMCell *const newCell = [self.cellSelector cellWithIdentifier:identifier fromParentCell:self.rootCell];
+
+    NSPoint newCellOrigin = newCell.origin;
+    NSPoint newVisibleRectOrigin = NewPoint(newCellOrigin.x - distFromVisibleRect.width, newCellOrigin.y - distFromVisibleRect.height);
+
+    // [self scrollPoint:newVisibleRectOrigin] animates the scrolling, we don't want that
+    NSPoint newVisibleRectOriginInClipView = [self convertPoint:newVisibleRectOrigin toView:self.superview];
+    [self.enclosingScrollView.contentView setBoundsOrigin:newVisibleRectOriginInClipView];
+    [self setNeedsDisplay:YES];
+
+    return;
+  }
+
+  [self updateCanvasSize];
+  QMCell *const newCell = [self.cellSelector cellWithIdentifier:identifier fromParentCell:self.rootCell];
+
+  [self scrollRectToVisible:newCell.familyFrame];
+  [self scrollRectToVisible:newCell.frame];
+
+  [self setNeedsDisplay:YES];
+}
+
 - (void)enableDeleteAllIconsMenuItem:(NSMenuItem *)deleteAllIconsMenuItem withBlock:(void (^)(id))deleteAllIconsBlock {
   [deleteAllIconsMenuItem setEnabled:YES];
   [deleteAllIconsMenuItem setBlockAction:deleteAllIconsBlock];
@@ -1121,7 +1120,8 @@ we only test the begin edit part... We are being to lazy here...
   QMCell *mouseDownHitCell = [self.cellSelector cellContainingPoint:clickLocation inCell:self.rootCell];
   self.cellStateManager.mouseDownHitCell = mouseDownHitCell;
 
-  [self setNeedsDisplay:YES];
+  [self.damageTracker addCell:mouseDownHitCell];
+  [self.damageTracker invalidateView:self];
 }
 
 - (void)handleSingleMouseUp {
@@ -1129,6 +1129,9 @@ we only test the begin edit part... We are being to lazy here...
   BOOL mouseDownShiftKey = modifier_check(self.mouseDownModifier, NSShiftKeyMask);;
 
   QMCell *mouseDownHitCell = self.cellStateManager.mouseDownHitCell;
+
+  // the selection before and after the click
+  [self.damageTracker addCells:self.cellStateManager.selectedCells];
   if (mouseDownHitCell == nil) {
     /**
     * Even if there is no modifier pressed, we get here modifier == 256. Thus, we check whether we have the
@@ -1136,22 +1139,24 @@ we only test the begin edit part... We are being to lazy here...
     */
     if (!mouseDownShiftKey && !mouseDownCommandKey) {
       [self.cellStateManager clearSelection];
-      [self setNeedsDisplay:YES];
+      [self.damageTracker invalidateView:self];
     }
 
+    [self.damageTracker reset];
     return;
   }
 
   if (mouseDownShiftKey || mouseDownCommandKey) {
     if ([self.cellStateManager cellIsSelected:mouseDownHitCell]) {
       [self.cellStateManager removeCellFromSelection:mouseDownHitCell modifier:self.mouseDownModifier];
-      [self setNeedsDisplay:YES];
+      [self.damageTracker invalidateView:self];
 
       return;
     }
 
     [self.cellStateManager addCellToSelection:mouseDownHitCell modifier:self.mouseDownModifier];
-    [self setNeedsDisplay:YES];
+    [self.damageTracker addCells:self.cellStateManager.selectedCells];
+    [self.damageTracker invalidateView:self];
 
     return;
   }
@@ -1160,11 +1165,8 @@ we only test the begin edit part... We are being to lazy here...
   [self.cellStateManager clearSelection];
   [self.cellStateManager addCellToSelection:mouseDownHitCell modifier:0];
 
-  [self setNeedsDisplay:YES];
-}
-
-- (NSPoint)rootCellOriginForParentSize:(NSSize)parentSize {
-  return NewPoint(parentSize.width, parentSize.height);
+  [self.damageTracker addCells:self.cellStateManager.selectedCells];
+  [self.damageTracker invalidateView:self];
 }
 
 - (void)zoomByFactor:(CGFloat)factor withFixedPoint:(NSPoint)locInView {
@@ -1183,27 +1185,20 @@ we only test the begin edit part... We are being to lazy here...
     return;
   }
 
-  NSClipView *clipView = self.enclosingScrollView.contentView;
-  NSSize clipViewFrameSize = clipView.frame.size;
-
-  NSSize oldParentSize = [self convertSize:clipViewFrameSize fromView:clipView];
-  NSPoint oldMapOrigin = [self rootCellOriginForParentSize:oldParentSize];
+  QM_TRACE_SCOPE("zoom");
 
-  NSPoint oldScrollPtInClipView = clipView.bounds.origin;
-  NSPoint oldScrollPt = [self convertPoint:oldScrollPtInClipView fromView:clipView];
+  NSClipView *clipView = self.enclosingScrollView.contentView;
+  NSPoint oldScrollPt = [self convertPoint:clipView.bounds.origin fromView:clipView];
   NSSize oldDist = NewSize(locInView.x - oldScrollPt.x, locInView.y - oldScrollPt.y);
 
   [self resetScaling];
   [self scaleUnitSquareToSize:newScale];
   self.currentScale = newScale;
 
-  NSSize newParentSize = [self convertSize:clipViewFrameSize fromView:clipView];
-  NSPoint newMapOrigin = [self rootCellOriginForParentSize:newParentSize];
-  NSSize deltaMapOrigin = NewSize(oldMapOrigin.x - newMapOrigin.x, oldMapOrigin.y - newMapOrigin.y);
-
-  NSPoint newScrollPt = NewPoint(locInView.x - deltaMapOrigin.width - oldDist.width / factor, locInView.y - deltaMapOrigin.height - oldDist.height / factor);
+  // the geometry of the cells does not depend on the scale: only the margin around the map changes
+  [self updateCanvasBoundsWithParentSize:self.superview.frame.size];
 
-  [self updateCanvasSize];
+  NSPoint newScrollPt = NewPoint(locInView.x - oldDist.width / factor, locInView.y - oldDist.height / factor);
   [self scrollPoint:newScrollPt];
   [self setNeedsDisplay:YES];
 }
@@ -1212,19 +1207,77 @@ we only test the begin edit part... We are being to lazy here...
   [self scaleUnitSquareToSize:[self convertSize:qUnitSize fromView:nil]];
 }
 
-- (NSSize)scaledBoundsSizeWithParentSize:(NSSize)unconvertedParentSize {
+/**
+* The cells are laid out in map-local coordinates, ie the family frame of the root cell starts at (0, 0).
+*/
+- (void)layoutCells {
+  self.rootCell.familyOrigin = NewPoint(0, 0);
+  [self.rootCell computeGeometry];
+}
+
+/**
+* Around the map there is a margin of the size of the clip view such that every cell can be scrolled to the center. The
+* margin is only the bounds origin of the view, thus, zooming and resizing do not touch the geometry of the cells.
+*/
+- (void)updateCanvasBoundsWithParentSize:(NSSize)unconvertedParentSize {
   NSSize rootFamilySize = self.rootCell.familySize;
 
   NSSize parentSize = [self convertSize:unconvertedParentSize fromView:nil];
   NSSize newBoundsSize = NewSize(rootFamilySize.width + 2 * parentSize.width, rootFamilySize.height + 2 * parentSize.height);
-  NSPoint newMapOrigin = [self rootCellOriginForParentSize:parentSize];
-  NSSize newBoundsSizeInParent = [self convertSize:newBoundsSize toView:nil];
 
-  // TODO: maybe we only have to shift the origins of all cells and their lines.
-  self.rootCell.familyOrigin = newMapOrigin;
-  [self.rootCell computeGeometry];
+  [self setFrameSize:[self convertSize:newBoundsSize toView:nil]];
+  [self setBoundsOrigin:NewPoint(-parentSize.width, -parentSize.height)];
+}
+
+/**
+* Removes all cells whose identifiers are not in the given array. Handles single removals as well as batch removals of
+* the document.
+*/
+- (void)removeCells:(NSArray *)cells ofParentCell:(QMCell *)parentCell notContainedInIdentifiers:(NSArray *)identifiers {
+  NSHashTable *idSet = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+  for (id identifier in identifiers) {
+    [idSet addObject:identifier];
+  }
+
+  NSMutableArray *cellsToDel = [[NSMutableArray alloc] init];
+  for (QMCell *cell in cells) {
+    if (![idSet containsObject:cell.identifier]) {
+      [cellsToDel addObject:cell];
+    }
+  }
 
-  return newBoundsSizeInParent;
+  for (QMCell *cellToDel in cellsToDel) {
+    [parentCell removeChild:cellToDel];
+  }
+}
+
+/**
+* The existing child cells are a subsequence of the given identifiers since only insertions happened. We walk both in
+* one pass and create cells for all identifiers missing in between, ie also for batch insertions of the document.
+*/
+- (void)insertCellsForIdentifiers:(NSArray *)identifiers intoParentCell:(QMCell *)parentCell left:(BOOL)left {
+  BOOL leftOfRoot = left && parentCell.isRoot;
+
+  [identifiers enumerateObjectsUsingBlock:^(id item, NSUInteger index, BOOL *stop) {
+    NSUInteger countOfChildren = leftOfRoot ? [(QMRootCell *) parentCell countOfLeftChildren] : parentCell.countOfChildren;
+    if (index < countOfChildren) {
+      QMCell *existingCell = leftOfRoot ? [(QMRootCell *) parentCell objectInLeftChildrenAtIndex:index] : [parentCell objectInChildrenAtIndex:index];
+      if (existingCell.identifier == item) {
+        return;
+      }
+    }
+
+    QMCell *cellToInsert = [self.cellPool cell];
+    cellToInsert.left = left;
+    [self.cellPropertiesManager fillCellPropertiesWithIdentifier:item cell:cellToInsert];
+    [self.cellPropertiesManager fillAllChildrenWithIdentifier:item cell:cellToInsert];
+
+    if (leftOfRoot) {
+      [(QMRootCell *) parentCell insertObject:cellToInsert inLeftChildrenAtIndex:index];
+    } else {
+      [parentCell insertObject:cellToInsert inChildrenAtIndex:index];
+    }
+  }];
 }
 
 - (NSArray *)allChildrenIdentifierOfIdentifier:(id)identifier {
@@ -1310,25 +1363,46 @@ we only test the begin edit part... We are being to lazy here...
 }
 
 - (void)replaceSelectionWithCellAndRedisplay:(QMCell *)cell {
+  [self.damageTracker addCells:self.cellStateManager.selectedCells];
+
   [self.cellStateManager clearSelection];
   [self.cellStateManager addCellToSelection:cell modifier:0];
   [self scrollToMakeVisibleCell:cell];
-  [self setNeedsDisplay:YES];
+
+  [self.damageTracker addCell:cell];
+  [self.damageTracker invalidateView:self];
 }
 
+/**
+* Siblings are laid out from top to bottom without overlapping families, ie the cells are sorted by their middle point.
+* Thus, we binary search the first cell below the given cell and compare it with its predecessor.
+*/
 - (QMCell *)verticallyNearestCellFromCells:(NSArray *)cellsToChooseFrom withCell:(QMCell *)cellToCompare {
-  QMCell *chosenChildCell = cellsToChooseFrom[0];
   CGFloat midYToCompare = cellToCompare.middlePoint.y;
-  CGFloat minVertDist = MAX_CGFLOAT;
 
-  for (QMCell *childCell in cellsToChooseFrom) {
-    CGFloat vertDist = ABS(childCell.middlePoint.y - midYToCompare);
-    if (vertDist < minVertDist) {
-      minVertDist = vertDist;
-      chosenChildCell = childCell;
+  NSUInteger low = 0;
+  NSUInteger high = cellsToChooseFrom.count - 1;
+  while (low < high) {
+    NSUInteger mid = low + (high - low) / 2;
+
+    if ([cellsToChooseFrom[mid] middlePoint].y < midYToCompare) {
+      low = mid + 1;
+    } else {
+      high = mid;
     }
   }
 
+  QMCell *chosenChildCell = cellsToChooseFrom[low];
+  if (low == 0) {
+    return chosenChildCell;
+  }
+
+  // on equal distance, the upper cell wins
+  QMCell *previousCell = cellsToChooseFrom[low - 1];
+  if (ABS(previousCell.middlePoint.y - midYToCompare) <= ABS(chosenChildCell.middlePoint.y - midYToCompare)) {
+    return previousCell;
+  }
+
   return chosenChildCell;
 }
 
@@ -16,11 +16,23 @@
 #import "QMMindmapViewDataSourceImpl.h"
 #import "QMRootCell.h"
 #import "QMIcon.h"
+#import "QMLayoutContext.h"
+#import "QMNode.h"
+
+@interface QMMindmapViewDataSourceImpl () <NSPasteboardItemDataProvider>
+@end
 
 @implementation QMMindmapViewDataSourceImpl {
     __weak QMDocument *_doc;
     __weak NSUndoManager *_undoManager;
     __weak QMMindmapView *_view;
+
+    QMLayoutContext *_layoutContext;
+
+    /**
+    * The dragged nodes of the pasteboard items whose serialized data we provide on demand.
+    */
+    NSMapTable *_draggedNodesByPasteboardItem;
 }
 
 TB_MANUALWIRE(settings)
@@ -68,7 +80,7 @@ TB_MANUALWIRE(iconManager)
     NSMutableArray *result = [[NSMutableArray alloc] initWithCapacity:iconCodes.count];
 
     for (NSString *code in iconCodes) {
-        [result addObject:[[QMIcon alloc] initWithCode:code]];
+        [result addObject:[[QMIcon alloc] initWithCode:code layoutContext:_layoutContext]];
     }
 
     return result;
@@ -177,9 +189,7 @@ TB_MANUALWIRE(iconManager)
     [_undoManager beginUndoGrouping];
     [_undoManager setActionName:NSLocalizedString(@"undo.node.deletion", @"Deletion of Node(s)")];
 
-    for (id item in items) {
-        [_doc deleteItem:item];
-    }
+    [_doc deleteItems:items];
 
     [_undoManager endUndoGrouping];
 }
@@ -193,9 +203,22 @@ TB_MANUALWIRE(iconManager)
     NSPasteboard *board = [NSPasteboard pasteboardWithName:NSDragPboard];
     [board clearContents];
 
+    /**
+    * Within the view, only the identities of the dragged cells are used, thus, we only write references. The archive
+    * and the outline of the subtree are provided when the nodes are dropped somewhere else.
+    */
+    [_draggedNodesByPasteboardItem removeAllObjects];
+
     NSMutableArray *items = [[NSMutableArray alloc] initWithCapacity:[draggedCells count]];
     for (QMCell *cell in draggedCells) {
-        [items addObject:cell.identifier];
+        QMNode *node = cell.identifier;
+
+        NSPasteboardItem *item = [[NSPasteboardItem alloc] init];
+        [item setPropertyList:[self referenceOfNode:node] forType:qNodeReferenceUti];
+        [item setDataProvider:self forTypes:@[qNodeUti, NSPasteboardTypeString]];
+
+        [_draggedNodesByPasteboardItem setObject:node forKey:item];
+        [items addObject:item];
     }
 
     [board writeObjects:items];
@@ -247,12 +270,42 @@ TB_MANUALWIRE(iconManager)
         _undoManager = _doc.undoManager;
 
         [[TBContext sharedContext] autowireSeed:self];
+
+        // in Quick Look there is no view
+        _layoutContext = view.layoutContext ?: [[QMLayoutContext alloc] init];
+        _draggedNodesByPasteboardItem = [NSMapTable strongToStrongObjectsMapTable];
     }
 
     return self;
 }
 
+#pragma mark NSPasteboardItemDataProvider
+- (void)pasteboard:(NSPasteboard *)pasteboard item:(NSPasteboardItem *)item provideDataForType:(NSString *)type {
+    QMNode *node = [_draggedNodesByPasteboardItem objectForKey:item];
+    if (node == nil) {
+        return;
+    }
+
+    id propertyList = [node pasteboardPropertyListForType:type];
+    if ([propertyList isKindOfClass:[NSData class]]) {
+        [item setData:propertyList forType:type];
+        return;
+    }
+
+    [item setPropertyList:propertyList forType:type];
+}
+
+- (void)pasteboardFinishedWithDataProvider:(NSPasteboard *)pasteboard {
+    [_draggedNodesByPasteboardItem removeAllObjects];
+}
+
 #pragma mark Private
+- (NSDictionary *)referenceOfNode:(QMNode *)node {
+    return @{
+        qNodeReferenceNodeIdKey : node.nodeId ?: @"",
+    };
+}
+
 - (void)doInsideUndoGroup:(NSString *)undoGroupName usingBlock:(void (^)())block {
     if (_undoManager.groupingLevel == 0) {
         [_undoManager beginUndoGrouping];
@@ -14,6 +14,10 @@
 
 /**
 * Converts the internal node structure to NSData such that you can write it down. The result will be a mm file.
+*
+* Like FreeMind, one element per line without indentation is written, thus, the size of the file does not grow with the
+* depth of the map. The nodes are visited with an explicit stack and the elements are appended to one buffer, which is
+* flushed regularly when writing to a stream, see QMOutlineWriter.
 */
 @interface QMMindmapWriter : NSObject <TBBean>
 
@@ -24,4 +28,9 @@
 */
 - (NSData *)dataForRootNode:(QMRootNode *)rootNode;
 
+/**
+* Writes the whole mindmap to the opened stream. Returns NO when the stream failed.
+*/
+- (BOOL)writeRootNode:(QMRootNode *)rootNode toStream:(NSOutputStream *)stream;
+
 @end
@@ -7,88 +7,214 @@
  */
 
 #import <TBCacao/TBCacao.h>
+#import <Qkit/Qkit.h>
 #import "QMMindmapWriter.h"
 #import "QMNode.h"
 #import "QMDocument.h"
 #import "QMFontManager.h"
 #import "QMRootNode.h"
+#import "QMTrace.h"
 
-@implementation QMMindmapWriter
+/**
+* Number of characters after which the buffer is written to the stream.
+*/
+static const NSUInteger qFlushLength = 64 * 1024;
+
+@implementation QMMindmapWriter {
+    NSMutableString *_buffer;
+    NSOutputStream *_stream;
+
+    BOOL _streamFailed;
+}
 
 TB_AUTOWIRE(fontConverter)
 
 #pragma mark Public
 - (NSData *)dataForRootNode:(QMRootNode *)rootNode {
-    NSXMLElement *mapElement = [[NSXMLElement allocWithZone:nil] initWithName:@"map"];
-    NSXMLNode *versionNode = [NSXMLNode attributeWithName:@"version" stringValue:qMindmapVersion];
-
-    [mapElement addAttribute:versionNode];
-    [mapElement addChild:[self nodeToXmlNode:rootNode left:NO]];
-
-    NSXMLDocument *xmlDoc = [[NSXMLDocument allocWithZone:nil] initWithRootElement:mapElement];
-    /**
-    * NSXMLNodePrettyPrint will destroy characters in HTML element, for example, from
-    *
-    * a <b>b c<u>d e</u> f g</b> h i
-    *
-    * NSXMLNodePrettyPrint will make
-    *
-    *  a <b>b c<u>d e</u>
-    *                                f g</b>
-    *                            h i
-    */
-    NSData *xmlData = [xmlDoc XMLDataWithOptions:NSXMLNodePrettyPrint | NSXMLDocumentTidyXML | NSXMLNodeCompactEmptyElement];
-
-    return xmlData;
+    QM_TRACE_SCOPE("write mindmap");
+
+    NSOutputStream *stream = [NSOutputStream outputStreamToMemory];
+    [stream open];
+
+    [self writeRootNode:rootNode toStream:stream];
+
+    NSData *data = [stream propertyForKey:NSStreamDataWrittenToMemoryStreamKey];
+    [stream close];
+
+    return data;
+}
+
+- (BOOL)writeRootNode:(QMRootNode *)rootNode toStream:(NSOutputStream *)stream {
+    QM_TRACE_SCOPE("write mindmap to stream");
+
+    _buffer = [[NSMutableString alloc] initWithCapacity:qFlushLength];
+    _stream = stream;
+    _streamFailed = NO;
+
+    [_buffer appendFormat:@"<map version=\"%@\">\n", qMindmapVersion];
+    [self appendElementsOfRootNode:rootNode];
+    [_buffer appendString:@"</map>\n"];
+    [self flushBuffer];
+
+    BOOL success = !_streamFailed;
+
+    _buffer = nil;
+    _stream = nil;
+
+    return success;
 }
 
 #pragma mark Private
-- (NSXMLElement *)nodeToXmlNode:(QMNode *)node left:(BOOL)isLeft {
-    NSXMLElement *element = [[NSXMLElement alloc] initWithName:@"node"];
-    NSMutableDictionary *const attributes = [NSMutableDictionary dictionaryWithDictionary:node.attributes];
+/**
+* Appends the elements with an explicit stack such that the depth of the map is not limited by the call stack. An entry
+* with two objects starts the element of the node, the second one telling whether the node is a left child of the root
+* node; the entry with one object ends it after its children.
+*/
+- (void)appendElementsOfRootNode:(QMRootNode *)rootNode {
+    QMStack *stack = [[NSMutableArray alloc] initWithCapacity:15];
+    [stack push:@[rootNode, @NO]];
+
+    while (stack.count > 0 && !_streamFailed) {
+        NSArray *entry = [stack pop];
+        QMNode *node = entry[0];
+
+        if (entry.count == 1) {
+            [_buffer appendString:@"</node>\n"];
+            continue;
+        }
+
+        NSArray *leftChildren = [node isRoot] ? [(QMRootNode *) node leftChildren] : nil;
+        BOOL hasChildren = node.children.count > 0 || leftChildren.count > 0;
+        BOOL hasContent = [self appendStartTagOfNode:node left:[entry[1] boolValue] hasChildren:hasChildren];
+
+        if (_buffer.length >= qFlushLength) {
+            [self flushBuffer];
+        }
+
+        if (!hasContent) {
+            continue;
+        }
+
+        [stack push:@[node]];
+
+        for (QMNode *leftChildNode in leftChildren.reverseObjectEnumerator) {
+            [stack push:@[leftChildNode, @YES]];
+        }
+
+        for (QMNode *childNode in node.children.reverseObjectEnumerator) {
+            [stack push:@[childNode, @NO]];
+        }
+    }
+}
+
+/**
+* Appends the start tag and the elements of the node other than the children, ie the unsupported children, the font and
+* the icons. Returns NO when there is no content, ie the element is empty and already closed.
+*/
+- (BOOL)appendStartTagOfNode:(QMNode *)node left:(BOOL)isLeft hasChildren:(BOOL)hasChildren {
+    NSDictionary *attributes = node.attributes;
+
+    [_buffer appendString:@"<node"];
+    for (NSString *key in [attributes.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+        if (isLeft && [key isEqualToString:qNodePositionAttributeKey]) {
+            continue;
+        }
+
+        [self appendAttribute:key value:attributes[key]];
+    }
 
     if (isLeft) {
-        [attributes setObject:@"left" forKey:qNodePositionAttributeKey];
+        [self appendAttribute:qNodePositionAttributeKey value:@"left"];
     }
 
-    [element setAttributesWithDictionary:attributes];
+    NSArray *unsupportedChildren = node.unsupportedChildren;
+    NSDictionary *fontAttributes = node.font != nil ? [_fontConverter fontAttrDictFromFont:node.font] : nil;
+    NSArray *icons = node.icons;
 
-    for (NSString *iconCode in node.icons) {
-        NSXMLElement *iconXmlElement = [[NSXMLElement alloc] initWithName:@"icon"];
-        [iconXmlElement setAttributesWithDictionary:[NSDictionary dictionaryWithObject:iconCode forKey:@"BUILTIN"]];
-        [element addChild:iconXmlElement];
+    if (!hasChildren && unsupportedChildren.count == 0 && fontAttributes == nil && icons.count == 0) {
+        [_buffer appendString:@"/>\n"];
+        return NO;
     }
 
-    NSArray *children = node.children;
-    for (QMNode *childNode in children) {
-        [element addChild:[self nodeToXmlNode:childNode left:NO]];
+    [_buffer appendString:@">\n"];
+
+    for (NSString *unsupportedChildAsString in unsupportedChildren) {
+        [_buffer appendString:unsupportedChildAsString];
+        [_buffer appendString:@"\n"];
     }
 
-    if ([node isRoot]) {
-        NSArray *leftChildren = [(QMRootNode *) node leftChildren];
-        for (QMNode *leftChildNode in leftChildren) {
-            [element addChild:[self nodeToXmlNode:leftChildNode left:YES]];
+    if (fontAttributes != nil) {
+        [_buffer appendString:@"<font"];
+        for (NSString *key in [fontAttributes.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+            [self appendAttribute:key value:fontAttributes[key]];
         }
+        [_buffer appendString:@"/>\n"];
     }
 
-    NSFont *font = node.font;
-    if (font != nil) {
-        NSDictionary *attrDictFromFont = [_fontConverter fontAttrDictFromFont:font];
+    for (NSString *iconCode in icons) {
+        [_buffer appendString:@"<icon"];
+        [self appendAttribute:@"BUILTIN" value:iconCode];
+        [_buffer appendString:@"/>\n"];
+    }
 
-        if (attrDictFromFont != nil) {
-            NSXMLElement *fontElement = [[NSXMLElement allocWithZone:nil] initWithName:@"font"];
-            [fontElement setAttributesWithDictionary:attrDictFromFont];
-            [element addChild:fontElement];
-        }
+    return YES;
+}
+
+- (void)appendAttribute:(NSString *)name value:(NSString *)value {
+    [_buffer appendString:@" "];
+    [_buffer appendString:name];
+    [_buffer appendString:@"=\""];
+    [_buffer appendString:[self escapedAttributeValueOfString:value]];
+    [_buffer appendString:@"\""];
+}
+
+/**
+* Line breaks and tabs are written as character references, otherwise, the reader would get spaces.
+*/
+- (NSString *)escapedAttributeValueOfString:(NSString *)string {
+    static NSCharacterSet *charactersToEscape = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        charactersToEscape = [NSCharacterSet characterSetWithCharactersInString:@"&<>\"\n\r\t"];
+    });
+
+    if ([string rangeOfCharacterFromSet:charactersToEscape].location == NSNotFound) {
+        return string;
     }
 
-    NSArray *unsupportedChildren = node.unsupportedChildren;
-    for (NSString *unsupportedChildAsString in unsupportedChildren) {
-        NSXMLElement *xmlElement = [[NSXMLElement allocWithZone:nil] initWithXMLString:unsupportedChildAsString error:nil];
-        [element addChild:xmlElement];
+    NSMutableString *result = [string mutableCopy];
+    [result replaceOccurrencesOfString:@"&" withString:@"&amp;" options:0 range:NSMakeRange(0, result.length)];
+    [result replaceOccurrencesOfString:@"<" withString:@"&lt;" options:0 range:NSMakeRange(0, result.length)];
+    [result replaceOccurrencesOfString:@">" withString:@"&gt;" options:0 range:NSMakeRange(0, result.length)];
+    [result replaceOccurrencesOfString:@"\"" withString:@"&quot;" options:0 range:NSMakeRange(0, result.length)];
+    [result replaceOccurrencesOfString:@"\n" withString:@"&#xa;" options:0 range:NSMakeRange(0, result.length)];
+    [result replaceOccurrencesOfString:@"\r" withString:@"&#xd;" options:0 range:NSMakeRange(0, result.length)];
+    [result replaceOccurrencesOfString:@"\t" withString:@"&#x9;" options:0 range:NSMakeRange(0, result.length)];
+
+    return result;
+}
+
+- (void)flushBuffer {
+    if (_buffer.length == 0 || _streamFailed) {
+        return;
     }
 
-    return element;
+    @autoreleasepool {
+        NSData *data = [_buffer dataUsingEncoding:NSUTF8StringEncoding];
+        [_buffer setString:@""];
+
+        const uint8_t *bytes = data.bytes;
+        NSUInteger countOfWrittenBytes = 0;
+        while (countOfWrittenBytes < data.length) {
+            NSInteger result = [_stream write:bytes + countOfWrittenBytes maxLength:data.length - countOfWrittenBytes];
+            if (result <= 0) {
+                _streamFailed = YES;
+                return;
+            }
+
+            countOfWrittenBytes += result;
+        }
+    }
 }
 
 @end
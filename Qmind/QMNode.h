@@ -22,19 +22,35 @@ extern NSString *const qNodeAttributesArchiveKey;
 extern NSString *const qNodeUnsupportedChildrenArchiveKey;
 extern NSString *const qNodeFontArchiveKey;
 extern NSString *const qNodeIconsArchiveKey;
+extern NSString *const qNodeCountOfChildrenArchiveKey;
 
 extern NSString *const qNodeUti;
 
+/**
+* Lightweight reference of a node on the drag pasteboard: the property list contains the ID of the node. Drops within
+* the view use the dragged cells themselves, drops elsewhere the archive or the outline.
+*/
+extern NSString *const qNodeReferenceUti;
+extern NSString *const qNodeReferenceNodeIdKey;
+
 extern NSString *const qNodeStringValueKey;
 extern NSString *const qNodeChildrenKey;
 extern NSString *const qNodeFontKey;
 extern NSString *const qNodeIconsKey;
 extern NSString *const qNodeFoldingKey;
 
+extern NSString *const qTrueStringValue;
+
 
 /**
 * Model representation of a Mindmap's node.
 *
+* Observers added by -addObserver:forKeyPath: are registered only at the receiver, but they get notified of the changes
+* of the receiver and of all its descendants: the mutators publish each change to the observers of the node and of all
+* its ancestors, see -publishChange:ofKey:. Thus, the observers of the root node, ie the document, form the change bus
+* of the whole mindmap and neither inserting nor removing subtrees has to register or unregister observers. The
+* observers get the usual -observeValueForKeyPath:ofObject:change:context: message with the changed node as the object.
+*
 * @implements NSCoding, NSPasteboardReading, NSPasteboardWriting, NSKeyValueCoding, NSKeyValueObserving
 */
 @interface QMNode : QObservedObject <NSCopying, NSCoding, NSPasteboardWriting, NSPasteboardReading>
@@ -69,6 +85,18 @@ extern NSString *const qNodeFoldingKey;
 
 @property(readonly, weak) NSArray *allChildren;
 
+/**
+* YES, when the node is a left child of the root node or a descendant of it. Maintained by the mutators of the parent
+* and only meaningful as long as the node has a parent.
+*/
+@property(getter=isLeft) BOOL left;
+
+/**
+* Index of the node within the array of its parent containing it, ie for left children of the root node within
+* leftChildren. Maintained by the mutators of the parent.
+*/
+@property NSUInteger indexWithinParent;
+
 /**
 * Returns the children on the RIGHT side. If the node is not a direct child of the root, then this will give you
 * all children of the node.
@@ -121,6 +149,16 @@ extern NSString *const qNodeFoldingKey;
 
 - (void)removeObjectFromChildrenAtIndex:(NSUInteger)index;
 
+/**
+* Inserts all nodes at once. Registers one undo action and triggers one KVO notification for children.
+*/
+- (void)insertChildren:(NSArray *)childNodes atIndexes:(NSIndexSet *)indexes;
+
+/**
+* Removes all nodes at once. Registers one undo action and triggers one KVO notification for children.
+*/
+- (void)removeChildrenAtIndexes:(NSIndexSet *)indexes;
+
 - (NSUInteger)countOfIcons;
 
 - (NSString *)objectInIconsAtIndex:(NSUInteger)index;
@@ -129,4 +167,37 @@ extern NSString *const qNodeFoldingKey;
 
 - (void)removeObjectFromIconsAtIndex:(NSUInteger)index;
 
+/**
+* Copies of nodes share the content of their source until they are accessed, see -copyWithZone:. Every mutator calls
+* this before it mutates the node, such that pending copies of the node and its ancestors get their own content.
+*/
+- (void)prepareForMutation;
+
+/**
+* Notifies the observers of the key of the receiver and of all its ancestors. The change dictionary has the same keys
+* as the one of KVO, eg NSKeyValueChangeKindKey and for insertions NSKeyValueChangeNewKey.
+*/
+- (void)publishChange:(NSDictionary *)change ofKey:(NSString *)key;
+
+- (void)publishSettingOfKey:(NSString *)key;
+- (void)publishInsertionOfObjects:(NSArray *)objects atIndexes:(NSIndexSet *)indexes ofKey:(NSString *)key;
+- (void)publishRemovalOfObjects:(NSArray *)objects atIndexes:(NSIndexSet *)indexes ofKey:(NSString *)key;
+
+/**
+* Sets the index within parent of the given nodes starting from the given index. Every mutator of the children calls
+* this for the part of the array it shifted.
+*/
+- (void)updateIndexesOfChildren:(NSArray *)childNodes fromIndex:(NSUInteger)index;
+
+/**
+* Encodes the given nodes and their descendants as flat list of dictionaries in pre-order, each with the number of its
+* children, such that neither archiving nor unarchiving recurses once per level.
+*/
+- (NSArray *)archiveRecordsOfNodes:(NSArray *)nodes;
+
+/**
+* Returns the nodes of -archiveRecordsOfNodes: as children of the receiver, ie with the receiver as parent.
+*/
+- (NSMutableArray *)nodesOfArchiveRecords:(NSArray *)records;
+
 @end
@@ -7,6 +7,7 @@
  */
 
 #import "QMNode.h"
+#import "QMOutlineWriter.h"
 
 NSString *const qNodeIdAttributeKey = @"ID";
 NSString *const qNodeTextAttributeKey = @"TEXT";
@@ -21,9 +22,13 @@ NSString *const qNodeAttributesArchiveKey = @"attributes";
 NSString *const qNodeUnsupportedChildrenArchiveKey = @"unsupportedChildren";
 NSString *const qNodeFontArchiveKey = @"font";
 NSString *const qNodeIconsArchiveKey = @"icons";
+NSString *const qNodeCountOfChildrenArchiveKey = @"countOfChildren";
 
 NSString *const qNodeUti = @"com.qvacua.mindmap.node";
 
+NSString *const qNodeReferenceUti = @"com.qvacua.mindmap.node-reference";
+NSString *const qNodeReferenceNodeIdKey = @"nodeId";
+
 NSString *const qNodeStringValueKey = @"stringValue";
 NSString *const qNodeChildrenKey = @"children";
 NSString *const qNodeFontKey = @"font";
@@ -33,12 +38,21 @@ NSString *const qNodeFoldingKey = @"folded";
 NSString *const qNonTextualNodeText = @"NON TEXTUAL NODE";
 NSString *const qTrueStringValue = @"true";
 
+/**
+* Key of the thread dictionary for the arrays of children which are released by the outermost -dealloc, see there.
+*/
+static NSString *const qNodeGraveyardKey = @"com.qvacua.qmind.node-graveyard";
+
 @interface QMNode ()
 
 @property(readonly) NSMutableArray *mutableChildren;
 @property(readonly) NSMutableArray *mutableIcons;
 @property(readonly) NSMutableDictionary *mutableAttributes;
 
+@property(readonly, getter=isPendingCopy) BOOL pendingCopy;
+@property(readonly, getter=isInCopiedSubtree) BOOL inCopiedSubtree;
+@property(readonly) QMNode *observedNode;
+
 @end
 
 @implementation QMNode {
@@ -47,8 +61,30 @@ NSString *const qTrueStringValue = @"true";
     NSMutableArray *_children;
     NSMutableArray *_icons;
 
+    NSMutableArray *_unsupportedChildren;
+
     NSFont *_font;
     __weak NSUndoManager *_undoManager;
+
+    QMNode *_copySource;
+    NSHashTable *_pendingCopies;
+
+    /**
+    * YES when the node or one of its ancestors may be the source of pending copies. Set for the whole subtree when a
+    * node gets copied and inherited from the parent; mutations of nodes without it do not look for pending copies.
+    */
+    BOOL _inCopiedSubtree;
+    __weak QMNode *_parent;
+
+    /**
+    * The nearest node, the node itself or one of its ancestors, which has observers, see -publishChange:ofKey:.
+    * Maintained for the whole subtree when the parent or the observers change.
+    */
+    __weak QMNode *_observedNode;
+    BOOL _observed;
+
+    BOOL _left;
+    NSUInteger _indexWithinParent;
 }
 
 @dynamic allChildren;
@@ -63,6 +99,11 @@ NSString *const qTrueStringValue = @"true";
 @dynamic mutableChildren;
 @dynamic mutableAttributes;
 @dynamic link;
+@dynamic pendingCopy;
+@dynamic inCopiedSubtree;
+@dynamic observedNode;
+@dynamic left;
+@dynamic indexWithinParent;
 
 #pragma mark Public
 - (NSUndoManager *)undoManager {
@@ -72,18 +113,48 @@ NSString *const qTrueStringValue = @"true";
 }
 
 - (void)setUndoManager:(NSUndoManager *)anUndoManager {
+    QMStack *stack = [[NSMutableArray alloc] initWithCapacity:15];
+    [stack push:self];
+
+    while (stack.count > 0) {
+        QMNode *node = [stack pop];
+
+        // the mutators hand the undo manager over to the whole subtree, thus, a node having it has all its descendants
+        // having it, like -setLeft:; this keeps inserting a subtree into a detached node O(1)
+        @synchronized (node) {
+            if (node->_undoManager == anUndoManager) {
+                continue;
+            }
+
+            node->_undoManager = anUndoManager;
+        }
+
+        // a pending copy hands the undo manager over to its children when they get copied
+        if (node.pendingCopy || node.leaf) {
+            continue;
+        }
+
+        // using all children here, we've covered also the root node
+        [stack pushArray:node.allChildren];
+    }
+}
+
+- (QMNode *)parent {
     @synchronized (self) {
-        _undoManager = anUndoManager;
+        return _parent;
     }
+}
 
-    if (self.leaf) {
-        return;
+- (void)setParent:(QMNode *)parent {
+    @synchronized (self) {
+        _parent = parent;
+    }
+
+    if (parent.inCopiedSubtree) {
+        [self markSubtreeAsCopied];
     }
 
-    // using all children here, we've covered also the root node
-    [self.allChildren enumerateObjectsUsingBlock:^(QMNode *childNode, NSUInteger index, BOOL *stop) {
-        childNode.undoManager = anUndoManager;
-    }];
+    [self updateObservedNodeOfSubtree];
 }
 
 - (NSString *)link {
@@ -98,23 +169,183 @@ NSString *const qTrueStringValue = @"true";
     return NO;
 }
 
+- (BOOL)isLeft {
+    @synchronized (self) {
+        return _left;
+    }
+}
+
+- (void)setLeft:(BOOL)left {
+    QMStack *stack = [[NSMutableArray alloc] initWithCapacity:15];
+    [stack push:self];
+
+    while (stack.count > 0) {
+        QMNode *node = [stack pop];
+
+        @synchronized (node) {
+            if (node->_left == left) {
+                continue;
+            }
+
+            node->_left = left;
+        }
+
+        // a pending copy hands the side over to its children when they get copied
+        if (node.pendingCopy) {
+            continue;
+        }
+
+        [stack pushArray:node.allChildren];
+    }
+}
+
+- (NSUInteger)indexWithinParent {
+    @synchronized (self) {
+        return _indexWithinParent;
+    }
+}
+
+- (void)setIndexWithinParent:(NSUInteger)index {
+    @synchronized (self) {
+        _indexWithinParent = index;
+    }
+}
+
+- (void)updateIndexesOfChildren:(NSArray *)childNodes fromIndex:(NSUInteger)index {
+    for (NSUInteger i = index; i < childNodes.count; i++) {
+        [childNodes[i] setIndexWithinParent:i];
+    }
+}
+
+/**
+* Only the nodes with observers are visited, thus, publishing a change of a node without observed ancestors is O(1)
+* independent of the depth of the node.
+*/
+- (void)publishChange:(NSDictionary *)change ofKey:(NSString *)key {
+    for (QMNode *node = self.observedNode; node != nil; node = node.parent.observedNode) {
+        NSSet *observerInfos = node.observerInfos;
+        if (observerInfos.count == 0) {
+            continue;
+        }
+
+        // the observers may add or remove observers
+        for (QObserverInfo *info in observerInfos.allObjects) {
+            if ([info.keyPath isEqualToString:key]) {
+                [info.observer observeValueForKeyPath:key ofObject:self change:change context:NULL];
+            }
+        }
+    }
+}
+
+- (void)publishSettingOfKey:(NSString *)key {
+    [self publishChange:@{NSKeyValueChangeKindKey : @(NSKeyValueChangeSetting)} ofKey:key];
+}
+
+- (void)publishInsertionOfObjects:(NSArray *)objects atIndexes:(NSIndexSet *)indexes ofKey:(NSString *)key {
+    [self publishChange:@{
+            NSKeyValueChangeKindKey : @(NSKeyValueChangeInsertion),
+            NSKeyValueChangeNewKey : [objects copy],
+            NSKeyValueChangeIndexesKey : [indexes copy],
+    } ofKey:key];
+}
+
+- (void)publishRemovalOfObjects:(NSArray *)objects atIndexes:(NSIndexSet *)indexes ofKey:(NSString *)key {
+    [self publishChange:@{
+            NSKeyValueChangeKindKey : @(NSKeyValueChangeRemoval),
+            NSKeyValueChangeOldKey : [objects copy],
+            NSKeyValueChangeIndexesKey : [indexes copy],
+    } ofKey:key];
+}
+
 - (NSArray *)allChildren {
+    return self.children;
+}
+
+- (NSArray *)children {
+    [self copyFromSourceIfNeeded];
+
     @synchronized (self) {
         return _children;
     }
 }
 
+- (NSDictionary *)attributes {
+    [self copyFromSourceIfNeeded];
+
+    @synchronized (self) {
+        return _attributes;
+    }
+}
+
+- (NSArray *)icons {
+    [self copyFromSourceIfNeeded];
+
+    @synchronized (self) {
+        return _icons;
+    }
+}
+
+- (NSMutableArray *)unsupportedChildren {
+    [self copyFromSourceIfNeeded];
+
+    @synchronized (self) {
+        return _unsupportedChildren;
+    }
+}
+
+- (void)setUnsupportedChildren:(NSMutableArray *)unsupportedChildren {
+    [self prepareForMutation];
+
+    @synchronized (self) {
+        _unsupportedChildren = unsupportedChildren;
+    }
+}
+
 - (NSFont *)font {
+    [self copyFromSourceIfNeeded];
+
     @synchronized (self) {
         return _font;
     }
 }
 
 - (void)setFont:(NSFont *)aFont {
+    [self prepareForMutation];
+
     @synchronized (self) {
         [self.undoManager registerUndoWithTarget:self selector:@selector(setFont:) object:self.font];
         _font = aFont;
     }
+
+    [self publishSettingOfKey:qNodeFontKey];
+}
+
+- (void)prepareForMutation {
+    [self copyFromSourceIfNeeded];
+
+    if (!self.inCopiedSubtree) {
+        return;
+    }
+
+    // A pending copy of an ancestor would see the mutation when it copies its children later. Thus, starting from the
+    // top, we let all pending copies along the path copy one level, which in turn makes their children pending copies
+    // of the next node on the path.
+    NSMutableArray *path = [[NSMutableArray alloc] init];
+    for (QMNode *node = self; node != nil; node = node.parent) {
+        [path addObject:node];
+    }
+
+    for (QMNode *node in path.reverseObjectEnumerator) {
+        [node resolvePendingCopies];
+    }
+
+    // No node on the path is a source anymore. Resetting the whole path keeps the flag of each parent implying the one
+    // of its children, which -markSubtreeAsCopied relies on.
+    for (QMNode *node in path) {
+        @synchronized (node) {
+            node->_inCopiedSubtree = NO;
+        }
+    }
 }
 
 - (BOOL)isLeaf {
@@ -133,12 +364,12 @@ NSString *const qTrueStringValue = @"true";
     [[self.undoManager prepareWithInvocationTarget:self] removeObjectFromChildrenAtIndex:index];
 
     childNode.parent = self;
+    childNode.left = self.left;
     childNode.undoManager = self.undoManager;
     [self.mutableChildren insertObject:childNode atIndex:index];
+    [self updateIndexesOfChildren:self.children fromIndex:index];
 
-    [self.observerInfos enumerateObjectsUsingBlock:^(QObserverInfo *info, BOOL *stop) {
-        [childNode addObserver:info.observer forKeyPath:info.keyPath];
-    }];
+    [self publishInsertionOfObjects:@[childNode] atIndexes:[NSIndexSet indexSetWithIndex:index] ofKey:qNodeChildrenKey];
 }
 
 - (void)removeObjectFromChildrenAtIndex:(NSUInteger)index {
@@ -147,8 +378,37 @@ NSString *const qTrueStringValue = @"true";
     [[self.undoManager prepareWithInvocationTarget:self] insertObject:nodeToDel inChildrenAtIndex:index];
 
     [self.mutableChildren removeObjectAtIndex:index];
+    [self updateIndexesOfChildren:self.children fromIndex:index];
 
-    [nodeToDel removeObserver:[self.observerInfos.anyObject observer]];
+    [self publishRemovalOfObjects:@[nodeToDel] atIndexes:[NSIndexSet indexSetWithIndex:index] ofKey:qNodeChildrenKey];
+}
+
+- (void)insertChildren:(NSArray *)childNodes atIndexes:(NSIndexSet *)indexes {
+    [[self.undoManager prepareWithInvocationTarget:self] removeChildrenAtIndexes:[indexes copy]];
+
+    for (QMNode *childNode in childNodes) {
+        childNode.parent = self;
+        childNode.left = self.left;
+        childNode.undoManager = self.undoManager;
+    }
+    [self.mutableChildren insertObjects:childNodes atIndexes:indexes];
+    [self updateIndexesOfChildren:self.children fromIndex:indexes.firstIndex];
+
+    [self publishInsertionOfObjects:childNodes atIndexes:indexes ofKey:qNodeChildrenKey];
+}
+
+- (void)removeChildrenAtIndexes:(NSIndexSet *)indexes {
+    NSArray *nodesToDel = [self.children objectsAtIndexes:indexes];
+    [[self.undoManager prepareWithInvocationTarget:self] insertChildren:nodesToDel atIndexes:[indexes copy]];
+
+    [self.mutableChildren removeObjectsAtIndexes:indexes];
+    [self updateIndexesOfChildren:self.children fromIndex:indexes.firstIndex];
+
+    for (QMNode *nodeToDel in nodesToDel) {
+        nodeToDel.parent = nil;
+    }
+
+    [self publishRemovalOfObjects:nodesToDel atIndexes:indexes ofKey:qNodeChildrenKey];
 }
 
 - (void)addObjectInChildren:(QMNode *)childNode {
@@ -170,6 +430,8 @@ NSString *const qTrueStringValue = @"true";
 - (void)insertObject:(NSString *)iconCode inIconsAtIndex:(NSUInteger)index {
     [[self.undoManager prepareWithInvocationTarget:self] removeObjectFromIconsAtIndex:index];
     [self.mutableIcons insertObject:iconCode atIndex:index];
+
+    [self publishInsertionOfObjects:@[iconCode] atIndexes:[NSIndexSet indexSetWithIndex:index] ofKey:qNodeIconsKey];
 }
 
 - (void)removeObjectFromIconsAtIndex:(NSUInteger)index {
@@ -177,6 +439,8 @@ NSString *const qTrueStringValue = @"true";
 
     [[self.undoManager prepareWithInvocationTarget:self] insertObject:iconToDel inIconsAtIndex:index];
     [self.mutableIcons removeObjectAtIndex:index];
+
+    [self publishRemovalOfObjects:@[iconToDel] atIndexes:[NSIndexSet indexSetWithIndex:index] ofKey:qNodeIconsKey];
 }
 
 - (NSString *)nodeId {
@@ -197,6 +461,8 @@ NSString *const qTrueStringValue = @"true";
     // if we use just strValue and not [strValue copy], sometimes, the string gets changed unexpectedly.
     // TODO: do NOT use attributes...
     self.mutableAttributes[qNodeTextAttributeKey] = strValue.copy;
+
+    [self publishSettingOfKey:qNodeStringValueKey];
 }
 
 - (BOOL)isFolded {
@@ -213,6 +479,79 @@ NSString *const qTrueStringValue = @"true";
     } else {
         [self.mutableAttributes removeObjectForKey:qNodeFoldedAttributeKey];
     }
+
+    [self publishSettingOfKey:qNodeFoldingKey];
+}
+
+- (NSArray *)archiveRecordsOfNodes:(NSArray *)nodes {
+    NSMutableArray *records = [[NSMutableArray alloc] init];
+
+    QMStack *stack = [[NSMutableArray alloc] initWithCapacity:15];
+    for (QMNode *node in nodes.reverseObjectEnumerator) {
+        [stack push:node];
+    }
+
+    while (stack.count > 0) {
+        QMNode *node = [stack pop];
+        NSArray *children = node.children;
+
+        NSMutableDictionary *record = [[NSMutableDictionary alloc] initWithCapacity:5];
+        record[qNodeAttributesArchiveKey] = node.attributes;
+        record[qNodeUnsupportedChildrenArchiveKey] = node.unsupportedChildren;
+        record[qNodeIconsArchiveKey] = node.icons;
+        record[qNodeCountOfChildrenArchiveKey] = @(children.count);
+        if (node.font != nil) {
+            record[qNodeFontArchiveKey] = node.font;
+        }
+
+        [records addObject:record];
+
+        // the records are in pre-order, ie the first child has to be popped first
+        for (QMNode *child in children.reverseObjectEnumerator) {
+            [stack push:child];
+        }
+    }
+
+    return records;
+}
+
+/**
+* Rebuilds the nodes from the records of -archiveRecordsOfNodes: as children of the receiver. The stack contains the
+* nodes whose children are not yet complete.
+*/
+- (NSMutableArray *)nodesOfArchiveRecords:(NSArray *)records {
+    NSMutableArray *result = [[NSMutableArray alloc] initWithCapacity:5];
+
+    QMStack *stack = [[NSMutableArray alloc] initWithCapacity:15];
+    NSMutableArray *remainingCounts = [[NSMutableArray alloc] initWithCapacity:15];
+
+    for (NSDictionary *record in records) {
+        while (stack.count > 0 && [remainingCounts.lastObject unsignedIntegerValue] == 0) {
+            [stack pop];
+            [remainingCounts removeLastObject];
+        }
+
+        QMNode *node = [[QMNode alloc] initWithArchiveRecord:record];
+
+        QMNode *parent = stack.count > 0 ? stack.lastObject : self;
+        NSMutableArray *siblings = stack.count > 0 ? parent->_children : result;
+
+        node.parent = parent;
+        node.indexWithinParent = siblings.count;
+        [siblings addObject:node];
+
+        if (stack.count > 0) {
+            remainingCounts[remainingCounts.count - 1] = @([remainingCounts.lastObject unsignedIntegerValue] - 1);
+        }
+
+        NSUInteger countOfChildren = [record[qNodeCountOfChildrenArchiveKey] unsignedIntegerValue];
+        if (countOfChildren > 0) {
+            [stack push:node];
+            [remainingCounts addObject:@(countOfChildren)];
+        }
+    }
+
+    return result;
 }
 
 #pragma mark NSObject
@@ -220,13 +559,45 @@ NSString *const qTrueStringValue = @"true";
     return self.stringValue.stringByCropping;
 }
 
+/**
+* Releasing the children in -dealloc would release their children in turn, ie the call stack would grow with the depth
+* of the subtree. Thus, the outermost -dealloc collects the arrays of children of all nodes being deallocated within it
+* and releases them one after another.
+*/
+- (void)dealloc {
+    if (_children.count == 0) {
+        return;
+    }
+
+    NSMutableDictionary *threadDict = [NSThread currentThread].threadDictionary;
+    NSMutableArray *graveyard = threadDict[qNodeGraveyardKey];
+    if (graveyard != nil) {
+        [graveyard addObject:_children];
+        _children = nil;
+
+        return;
+    }
+
+    graveyard = [[NSMutableArray alloc] initWithObjects:_children, nil];
+    _children = nil;
+    threadDict[qNodeGraveyardKey] = graveyard;
+
+    while (graveyard.count > 0) {
+        // the last reference to the children is released outside of the graveyard since their -dealloc adds to it
+        NSArray *children = graveyard.lastObject;
+        [graveyard removeLastObject];
+        children = nil;
+    }
+
+    [threadDict removeObjectForKey:qNodeGraveyardKey];
+}
+
 #pragma mark NSPasteboardWriting
 - (NSArray *)writableTypesForPasteboard:(NSPasteboard *)pasteboard {
     static NSArray *writableTypes = nil;
 
     if (writableTypes == nil) {
-        // UTF-8 string is cheaper to create.
-        // The full node object will be lazily created.
+        // Both are promised: the outline and the archive of the subtree are only created when a consumer asks for them.
         writableTypes = @[NSPasteboardTypeString, qNodeUti];
     }
 
@@ -234,7 +605,7 @@ NSString *const qTrueStringValue = @"true";
 }
 
 - (NSPasteboardWritingOptions)writingOptionsForType:(NSString *)type pasteboard:(NSPasteboard *)pasteboard {
-    if ([type isEqualToString:qNodeUti]) {
+    if ([type isEqualToString:qNodeUti] || [type isEqualToString:NSPasteboardTypeString]) {
         return NSPasteboardWritingPromised;
     }
 
@@ -243,7 +614,7 @@ NSString *const qTrueStringValue = @"true";
 
 - (id)pasteboardPropertyListForType:(NSString *)type {
     if ([type isEqualToString:NSPasteboardTypeString]) {
-        return self.stringValue;
+        return [[[QMOutlineWriter alloc] init] plainTextOutlineOfNode:self];
     }
 
     if ([type isEqualToString:qNodeUti]) {
@@ -273,9 +644,13 @@ NSString *const qTrueStringValue = @"true";
 }
 
 #pragma mark NSCoding
+/**
+* The descendants are not encoded as objects since the archiver would encode them recursively. Instead, they are
+* encoded as flat list of records in pre-order, see -archiveRecordsOfNodes:.
+*/
 - (void)encodeWithCoder:(NSCoder *)coder {
     [coder encodeConditionalObject:self.parent forKey:qNodeParentArchiveKey];
-    [coder encodeObject:self.children forKey:qNodeChildrenArchiveKey];
+    [coder encodeObject:[self archiveRecordsOfNodes:self.children] forKey:qNodeChildrenArchiveKey];
     [coder encodeObject:self.attributes forKey:qNodeAttributesArchiveKey];
     [coder encodeObject:self.unsupportedChildren forKey:qNodeUnsupportedChildrenArchiveKey];
     [coder encodeObject:self.font forKey:qNodeFontArchiveKey];
@@ -285,77 +660,65 @@ NSString *const qTrueStringValue = @"true";
 - (id)initWithCoder:(NSCoder *)decoder {
     if ((self = [super init])) {
         _parent = [decoder decodeObjectForKey:qNodeParentArchiveKey];
-        _children = [decoder decodeObjectForKey:qNodeChildrenArchiveKey];
         _attributes = [decoder decodeObjectForKey:qNodeAttributesArchiveKey];
         _unsupportedChildren = [decoder decodeObjectForKey:qNodeUnsupportedChildrenArchiveKey];
         _font = [decoder decodeObjectForKey:qNodeFontArchiveKey];
         _icons = [decoder decodeObjectForKey:qNodeIconsArchiveKey];
-    }
-
-    return self;
-}
 
-#pragma mark NSKeyValueObservingCustomization
-+ (BOOL)automaticallyNotifiesObserversForKey:(NSString *)key {
-    if ([key isEqualToString:qNodeStringValueKey]
-            || [key isEqualToString:qNodeChildrenKey]
-            || [key isEqualToString:qNodeIconsKey]
-            || [key isEqualToString:qNodeFontKey]
-            || [key isEqualToString:qNodeFoldingKey]) {
-        return YES;
+        _children = [self nodesOfArchiveRecords:[decoder decodeObjectForKey:qNodeChildrenArchiveKey]];
     }
 
-    return NO;
-}
-
-#pragma mark NSCopying
-- (id)copyWithZone:(NSZone *)zone {
-    QMNode *copy = [[QMNode alloc] init];
-    copy.stringValue = self.stringValue;
-    copy.folded = self.folded;
-    copy.unsupportedChildren = [[NSMutableArray alloc] initWithArray:self.unsupportedChildren copyItems:YES];
-    copy.font = self.font;
-
-    /**
-     * using all children here and adding all to children, ie right children because even when the root node gets copied,
-     * when pasted, it won't be a root node anymore
-     */
-    [self.allChildren enumerateObjectsUsingBlock:^(QMNode *child, NSUInteger index, BOOL *stop) {
-        [copy addObjectInChildren:child.copy];
-    }];
-
-    [self.icons enumerateObjectsUsingBlock:^(NSString *icon, NSUInteger index, BOOL *stop) {
-        [copy addObjectInIcons:icon.copy];
-    }];
-
-    return copy;
+    return self;
 }
 
 #pragma mark QObservedObject
 - (void)addObserver:(id)observer forKeyPath:(NSString *)keyPath {
     [super addObserver:observer forKeyPath:keyPath];
 
-    if (self.leaf) {
-        return;
+    @synchronized (self) {
+        _observed = YES;
     }
 
-    // using all children here, we're covered also for the root node
-    [self.allChildren enumerateObjectsUsingBlock:^(QMNode *childNode, NSUInteger index, BOOL *stop) {
-        [childNode addObserver:observer forKeyPath:keyPath];
-    }];
+    [self updateObservedNodeOfSubtree];
 }
 
 - (void)removeObserver:(id)observer {
     [super removeObserver:observer];
 
-    if (self.leaf) {
-        return;
+    @synchronized (self) {
+        _observed = self.observerInfos.count > 0;
     }
 
-    // using all children here, we're covered also for the root node
-    [self.allChildren enumerateObjectsUsingBlock:^(QMNode *childNode, NSUInteger index, BOOL *stop) {
-        [childNode removeObserver:observer];
-    }];
+    [self updateObservedNodeOfSubtree];
+}
+
+#pragma mark NSKeyValueObservingCustomization
+/**
+* The changes are published by the mutators, see -publishChange:ofKey:.
+*/
++ (BOOL)automaticallyNotifiesObserversForKey:(NSString *)key {
+    return NO;
+}
+
+#pragma mark NSCopying
+/**
+* The copy only refers to the receiver and copies the content of the receiver, when it is accessed for the first time.
+* Its children are again such copies. Thus, copying is O(1) and only the parts of the copy which are used, are copied.
+* Before the receiver or one of its descendants is mutated, pending copies copy their content, see -prepareForMutation.
+*/
+- (id)copyWithZone:(NSZone *)zone {
+    QMNode *source = self;
+    @synchronized (self) {
+        // a pending copy has the same content as its source
+        if (_copySource != nil) {
+            source = _copySource;
+        }
+    }
+
+    QMNode *copy = [[QMNode alloc] init];
+    [copy setCopySource:source];
+
+    return copy;
 }
 
 #pragma mark Initializer
@@ -386,22 +749,203 @@ NSString *const qTrueStringValue = @"true";
 }
 
 #pragma mark Private
+- (id)initWithArchiveRecord:(NSDictionary *)record {
+    if ((self = [super init])) {
+        _attributes = [record[qNodeAttributesArchiveKey] mutableCopy];
+        _unsupportedChildren = [record[qNodeUnsupportedChildrenArchiveKey] mutableCopy];
+        _font = record[qNodeFontArchiveKey];
+        _icons = [record[qNodeIconsArchiveKey] mutableCopy];
+        _children = [[NSMutableArray alloc] initWithCapacity:5];
+    }
+
+    return self;
+}
+
 - (NSMutableArray *)mutableIcons {
+    [self prepareForMutation];
+
     @synchronized (self) {
         return _icons;
     }
 }
 
 - (NSMutableArray *)mutableChildren {
+    [self prepareForMutation];
+
     @synchronized (self) {
         return _children;
     }
 }
 
 - (NSMutableDictionary *)mutableAttributes {
+    [self prepareForMutation];
+
     @synchronized (self) {
         return _attributes;
     }
 }
 
+- (BOOL)isPendingCopy {
+    @synchronized (self) {
+        return _copySource != nil;
+    }
+}
+
+- (void)setCopySource:(QMNode *)source {
+    @synchronized (self) {
+        _copySource = source;
+    }
+
+    @synchronized (source) {
+        if (source->_pendingCopies == nil) {
+            source->_pendingCopies = [NSHashTable weakObjectsHashTable];
+        }
+
+        [source->_pendingCopies addObject:self];
+    }
+
+    [source markSubtreeAsCopied];
+}
+
+- (BOOL)isInCopiedSubtree {
+    @synchronized (self) {
+        return _inCopiedSubtree;
+    }
+}
+
+- (QMNode *)observedNode {
+    @synchronized (self) {
+        return _observedNode;
+    }
+}
+
+/**
+* The observed node of each node only depends on the ones of its ancestors, thus, we can stop at nodes whose observed
+* node does not change, like -setUndoManager: does. Removing a subtree is O(size of the subtree); inserting one is
+* anyway, since it gets the undo manager.
+*/
+- (void)updateObservedNodeOfSubtree {
+    QMStack *stack = [[NSMutableArray alloc] initWithCapacity:15];
+    [stack push:self];
+
+    while (stack.count > 0) {
+        QMNode *node = [stack pop];
+
+        // parents are popped before their children, thus, the observed node of the parent is already up to date
+        QMNode *observedNodeOfParent = node.parent.observedNode;
+
+        @synchronized (node) {
+            QMNode *observedNode = node->_observed ? node : observedNodeOfParent;
+            if (node->_observedNode == observedNode) {
+                continue;
+            }
+
+            node->_observedNode = observedNode;
+        }
+
+        // the children of a pending copy get their observed node when they get copied and their parent is set
+        if (node.pendingCopy || node.leaf) {
+            continue;
+        }
+
+        [stack pushArray:node.allChildren];
+    }
+}
+
+/**
+* The flag of a node implies the one of all its descendants, thus, we can stop at nodes which already have it, which
+* keeps copying level by level O(1) per node.
+*/
+- (void)markSubtreeAsCopied {
+    QMStack *stack = [[NSMutableArray alloc] initWithCapacity:15];
+    [stack push:self];
+
+    while (stack.count > 0) {
+        QMNode *node = [stack pop];
+
+        @synchronized (node) {
+            if (node->_inCopiedSubtree) {
+                continue;
+            }
+
+            node->_inCopiedSubtree = YES;
+        }
+
+        // the children of a pending copy inherit the flag when they get copied and their parent is set
+        if (node.pendingCopy) {
+            continue;
+        }
+
+        [stack pushArray:node.allChildren];
+    }
+}
+
+- (void)resolvePendingCopies {
+    NSArray *pendingCopies;
+    @synchronized (self) {
+        pendingCopies = _pendingCopies.allObjects;
+    }
+
+    for (QMNode *pendingCopy in pendingCopies) {
+        [pendingCopy copyFromSourceIfNeeded];
+    }
+}
+
+/**
+* Copies one level: the content of the source and pending copies of its children. We do not use the KVC mutators
+* since the copy did not change from the outside.
+*/
+- (void)copyFromSourceIfNeeded {
+    QMNode *source;
+    @synchronized (self) {
+        if (_copySource == nil) {
+            return;
+        }
+
+        source = _copySource;
+        _copySource = nil;
+    }
+
+    @synchronized (source) {
+        [source->_pendingCopies removeObject:self];
+    }
+
+    NSMutableDictionary *attributes = [[NSMutableDictionary alloc] initWithCapacity:2];
+    attributes[qNodeTextAttributeKey] = source.stringValue;
+    if (source.folded) {
+        attributes[qNodeFoldedAttributeKey] = qTrueStringValue;
+    }
+
+    /**
+     * using all children here and adding all to children, ie right children because even when the root node gets copied,
+     * when pasted, it won't be a root node anymore
+     */
+    NSArray *sourceChildren = source.allChildren;
+    NSMutableArray *children = [[NSMutableArray alloc] initWithCapacity:MAX(sourceChildren.count, 5)];
+    for (QMNode *sourceChild in sourceChildren) {
+        [children addObject:[sourceChild copy]];
+    }
+
+    NSUndoManager *undoManager;
+    BOOL left;
+    @synchronized (self) {
+        _attributes = attributes;
+        _unsupportedChildren = [[NSMutableArray alloc] initWithArray:source.unsupportedChildren copyItems:YES];
+        _font = source.font;
+        _icons = [[NSMutableArray alloc] initWithArray:source.icons copyItems:YES];
+        _children = children;
+
+        undoManager = _undoManager;
+        left = _left;
+    }
+
+    [self updateIndexesOfChildren:children fromIndex:0];
+
+    for (QMNode *child in children) {
+        child.parent = self;
+        child.left = left;
+        child.undoManager = undoManager;
+    }
+}
+
 @end
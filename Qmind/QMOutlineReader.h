@@ -0,0 +1,51 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import <Foundation/Foundation.h>
+
+@class QMNode;
+
+/**
+* Reads outlines into detached nodes: plain text indented by tabs or spaces, Markdown headings and bullets, and OPML.
+*
+* The input is read in one pass: every line, or every outline element of OPML, becomes one node which is appended to the
+* last node of the level above. Thus, the returned nodes contain the whole subtree and can be inserted with one batch
+* insertion, ie with one undo record. Since the nodes are detached, building the subtree neither registers undo nor
+* notifies any observer.
+*
+* Use one instance per outline.
+*/
+@interface QMOutlineReader : NSObject <NSXMLParserDelegate>
+
+/**
+* Returns the top level nodes of the outline. A string starting with an XML declaration or an opml element is read as
+* OPML.
+*
+* - Each tab is one level; the number of spaces of one level is that of the first line indented by spaces.
+* - A Markdown heading is on the level of the number of its #s minus one. Lines below a heading are one level deeper.
+* - Bullets, ie -, *, + or numbers followed by . or ), are removed.
+* - A line is at most one level deeper than the preceding one. Blank lines are skipped.
+* - The markers of QMOutlineWriter are read: :code: in front of the text are icons, the HTML comments <!-- left --> and
+*   <!-- folded --> at the end mark left and folded nodes.
+*/
+- (NSArray *)nodesFromString:(NSString *)string;
+
+/**
+* Returns the nodes of the top level outline elements of the body. The text of a node is the text attribute of the
+* outline element or, if not present, its title attribute. The icons, folded and position attributes of QMOutlineWriter
+* are read.
+*/
+- (NSArray *)nodesFromOpmlData:(NSData *)data;
+
+/**
+* Returns YES when the node of the last read outline is marked as left child of the root node. Since the read nodes are
+* detached, the caller inserts them accordingly.
+*/
+- (BOOL)isLeftNode:(QMNode *)node;
+
+@end
@@ -0,0 +1,336 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import <TBCacao/TBCacao.h>
+#import "QMOutlineReader.h"
+#import "QMNode.h"
+#import "QMTrace.h"
+
+static NSString * const qOpmlOutlineKey = @"outline";
+static NSString * const qOpmlTextKey = @"text";
+static NSString * const qOpmlTitleKey = @"title";
+static NSString * const qOpmlIconsKey = @"icons";
+static NSString * const qOpmlFoldedKey = @"folded";
+static NSString * const qOpmlPositionKey = @"position";
+static NSString * const qOpmlLeftPosition = @"left";
+static NSString * const qOpmlIconSeparator = @",";
+
+static NSString * const qMarkdownLeftMarker = @"<!-- left -->";
+static NSString * const qMarkdownFoldedMarker = @"<!-- folded -->";
+
+static const NSUInteger qMaxMarkdownHeadingLevel = 6;
+
+@implementation QMOutlineReader {
+    NSMutableArray *_topLevelNodes;
+
+    /**
+    * The last read node of each level, ie the path from a top level node to the last read node.
+    */
+    NSMutableArray *_path;
+
+    NSUInteger _spacesPerLevel;
+
+    /**
+    * Level of the lines below the last Markdown heading.
+    */
+    NSUInteger _levelBelowHeading;
+
+    NSHashTable *_leftNodes;
+}
+
+#pragma mark Public
+- (NSArray *)nodesFromString:(NSString *)string {
+    if ([self isOpml:string]) {
+        return [self nodesFromOpmlData:[string dataUsingEncoding:NSUTF8StringEncoding]];
+    }
+
+    QM_TRACE_SCOPE("read outline");
+
+    [self reset];
+    [string enumerateLinesUsingBlock:^(NSString *line, BOOL *stop) {
+        [self readLine:line];
+    }];
+
+    return _topLevelNodes;
+}
+
+- (NSArray *)nodesFromOpmlData:(NSData *)data {
+    QM_TRACE_SCOPE("read opml");
+
+    [self reset];
+
+    NSXMLParser *xmlParser = [[NSXMLParser alloc] initWithData:data];
+
+    [xmlParser setDelegate:self];
+    [xmlParser setShouldResolveExternalEntities:NO];
+
+    [xmlParser parse];
+
+    return _topLevelNodes;
+}
+
+- (BOOL)isLeftNode:(QMNode *)node {
+    return [_leftNodes containsObject:node];
+}
+
+#pragma mark NSXMLParserDelegate
+- (void)parser:(NSXMLParser *)parser
+        didStartElement:(NSString *)elementName
+           namespaceURI:(NSString *)namespaceURI
+          qualifiedName:(NSString *)qName
+             attributes:(NSDictionary *)attributeDict {
+
+    if (![elementName isEqualToString:qOpmlOutlineKey]) {
+        return;
+    }
+
+    NSString *text = attributeDict[qOpmlTextKey];
+    if (text == nil) {
+        text = attributeDict[qOpmlTitleKey];
+    }
+
+    NSString *icons = attributeDict[qOpmlIconsKey];
+    NSArray *iconCodes = icons.length > 0 ? [icons componentsSeparatedByString:qOpmlIconSeparator] : @[];
+    BOOL folded = [attributeDict[qOpmlFoldedKey] isEqualToString:qTrueStringValue];
+    BOOL left = [attributeDict[qOpmlPositionKey] isEqualToString:qOpmlLeftPosition];
+
+    QMNode *node = [self nodeWithString:text ?: @"" iconCodes:iconCodes folded:folded left:left];
+    [self appendNode:node atLevel:_path.count];
+}
+
+- (void)parser:(NSXMLParser *)parser
+        didEndElement:(NSString *)elementName
+         namespaceURI:(NSString *)namespaceURI
+        qualifiedName:(NSString *)qName {
+
+    if ([elementName isEqualToString:qOpmlOutlineKey]) {
+        [_path removeLastObject];
+    }
+}
+
+- (void)parser:(NSXMLParser *)parser parseErrorOccurred:(NSError *)parseError {
+    log4Warn(@"An error occurred reading the OPML: %@", parseError);
+}
+
+#pragma mark Private
+- (void)reset {
+    _topLevelNodes = [[NSMutableArray alloc] init];
+    _path = [[NSMutableArray alloc] initWithCapacity:15];
+
+    _spacesPerLevel = 0;
+    _levelBelowHeading = 0;
+
+    _leftNodes = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+}
+
+- (BOOL)isOpml:(NSString *)string {
+    NSString *trimmedString = [string stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
+
+    if ([trimmedString hasPrefix:@"<opml"]) {
+        return YES;
+    }
+
+    return [trimmedString hasPrefix:@"<?xml"] && [trimmedString rangeOfString:@"<opml"].location != NSNotFound;
+}
+
+- (void)readLine:(NSString *)line {
+    NSUInteger length = line.length;
+    NSUInteger countOfTabs = 0;
+    NSUInteger countOfSpaces = 0;
+
+    NSUInteger index = 0;
+    for (; index < length; index++) {
+        unichar character = [line characterAtIndex:index];
+
+        if (character == '\t') {
+            countOfTabs++;
+        } else if (character == ' ') {
+            countOfSpaces++;
+        } else {
+            break;
+        }
+    }
+
+    if (index == length) {
+        return;
+    }
+
+    if (countOfSpaces > 0 && _spacesPerLevel == 0) {
+        _spacesPerLevel = countOfSpaces;
+    }
+
+    NSUInteger indentLevel = countOfTabs;
+    if (countOfSpaces > 0) {
+        indentLevel += countOfSpaces / _spacesPerLevel;
+    }
+
+    NSString *content = [line substringFromIndex:index];
+    NSUInteger headingLevel = [self markdownHeadingLevelOfString:content];
+
+    NSUInteger level;
+    if (headingLevel > 0 && indentLevel == 0) {
+        level = headingLevel - 1;
+        _levelBelowHeading = headingLevel;
+
+        content = [content substringFromIndex:MIN(headingLevel + 1, content.length)];
+    } else {
+        level = _levelBelowHeading + indentLevel;
+
+        content = [content substringFromIndex:[self lengthOfBulletOfString:content]];
+    }
+
+    content = [content stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+
+    // QMOutlineWriter writes the left marker before the folded one
+    BOOL folded = [content hasSuffix:qMarkdownFoldedMarker];
+    if (folded) {
+        content = [self string:content byRemovingSuffix:qMarkdownFoldedMarker];
+    }
+
+    BOOL left = [content hasSuffix:qMarkdownLeftMarker];
+    if (left) {
+        content = [self string:content byRemovingSuffix:qMarkdownLeftMarker];
+    }
+
+    NSMutableArray *iconCodes = [[NSMutableArray alloc] init];
+    content = [content substringFromIndex:[self lengthOfIconCodesOfString:content addingTo:iconCodes]];
+
+    [self appendNode:[self nodeWithString:content iconCodes:iconCodes folded:folded left:left] atLevel:level];
+}
+
+- (NSString *)string:(NSString *)string byRemovingSuffix:(NSString *)suffix {
+    NSString *result = [string substringToIndex:string.length - suffix.length];
+    return [result stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+}
+
+/**
+* Returns the length of the leading icon codes including the following spaces, eg of ":flag: :idea: ", and adds the
+* codes to the array. A code does not contain whitespace or colons and is followed by a space or the end of the string.
+*/
+- (NSUInteger)lengthOfIconCodesOfString:(NSString *)string addingTo:(NSMutableArray *)iconCodes {
+    NSCharacterSet *separators = [NSCharacterSet characterSetWithCharactersInString:@": \t"];
+    NSUInteger length = string.length;
+    NSUInteger index = 0;
+
+    while (index < length && [string characterAtIndex:index] == ':') {
+        NSRange searchRange = NSMakeRange(index + 1, length - index - 1);
+        NSUInteger endIndex = [string rangeOfCharacterFromSet:separators options:0 range:searchRange].location;
+
+        if (endIndex == NSNotFound || endIndex == index + 1 || [string characterAtIndex:endIndex] != ':') {
+            break;
+        }
+
+        if (endIndex + 1 < length && [string characterAtIndex:endIndex + 1] != ' ') {
+            break;
+        }
+
+        [iconCodes addObject:[string substringWithRange:NSMakeRange(index + 1, endIndex - index - 1)]];
+
+        index = endIndex + 1;
+        while (index < length && [string characterAtIndex:index] == ' ') {
+            index++;
+        }
+    }
+
+    return index;
+}
+
+/**
+* Returns the number of #s when the string is a Markdown heading, otherwise 0.
+*/
+- (NSUInteger)markdownHeadingLevelOfString:(NSString *)string {
+    NSUInteger length = string.length;
+
+    NSUInteger count = 0;
+    while (count < length && [string characterAtIndex:count] == '#') {
+        count++;
+    }
+
+    if (count > qMaxMarkdownHeadingLevel) {
+        return 0;
+    }
+
+    if (count < length && [string characterAtIndex:count] != ' ') {
+        return 0;
+    }
+
+    return count;
+}
+
+/**
+* Returns the length of the bullet including the following space, eg of "- " or "12. ", or 0 when there is none.
+*/
+- (NSUInteger)lengthOfBulletOfString:(NSString *)string {
+    NSUInteger length = string.length;
+    unichar firstCharacter = [string characterAtIndex:0];
+
+    if (firstCharacter == '-' || firstCharacter == '*' || firstCharacter == '+') {
+        if (length == 1) {
+            return 1;
+        }
+
+        return [string characterAtIndex:1] == ' ' ? 2 : 0;
+    }
+
+    NSUInteger index = 0;
+    while (index < length && [[NSCharacterSet decimalDigitCharacterSet] characterIsMember:[string characterAtIndex:index]]) {
+        index++;
+    }
+
+    if (index == 0 || index == length) {
+        return 0;
+    }
+
+    unichar delimiter = [string characterAtIndex:index];
+    if (delimiter != '.' && delimiter != ')') {
+        return 0;
+    }
+
+    if (index + 1 == length) {
+        return length;
+    }
+
+    return [string characterAtIndex:index + 1] == ' ' ? index + 2 : 0;
+}
+
+- (QMNode *)nodeWithString:(NSString *)string iconCodes:(NSArray *)iconCodes folded:(BOOL)folded left:(BOOL)left {
+    NSMutableDictionary *attributes = [[NSMutableDictionary alloc] initWithCapacity:2];
+    attributes[qNodeTextAttributeKey] = string;
+    if (folded) {
+        attributes[qNodeFoldedAttributeKey] = qTrueStringValue;
+    }
+
+    QMNode *node = [[QMNode alloc] initWithAttributes:attributes];
+    for (NSString *iconCode in iconCodes) {
+        [node addObjectInIcons:iconCode];
+    }
+
+    if (left) {
+        [_leftNodes addObject:node];
+    }
+
+    return node;
+}
+
+/**
+* The level is clamped to one deeper than the last read node.
+*/
+- (void)appendNode:(QMNode *)node atLevel:(NSUInteger)level {
+    NSUInteger clampedLevel = MIN(level, _path.count);
+    [_path removeObjectsInRange:NSMakeRange(clampedLevel, _path.count - clampedLevel)];
+
+    if (clampedLevel == 0) {
+        [_topLevelNodes addObject:node];
+    } else {
+        [_path.lastObject addObjectInChildren:node];
+    }
+
+    [_path addObject:node];
+}
+
+@end
@@ -0,0 +1,48 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import <Foundation/Foundation.h>
+
+@class QMNode;
+
+typedef enum {
+    QMOutlineFormatPlainText = 0,
+    QMOutlineFormatMarkdown,
+    QMOutlineFormatOpml,
+} QMOutlineFormat;
+
+/**
+* Writes nodes as outline: one line per node, the children of the root node in the order of -[QMNode allChildren], ie
+* the left children after the right ones. Line breaks within the text of a node are replaced by spaces.
+*
+* - Plain text: indented by one tab per level, without any marker.
+* - Markdown: the node as heading and its descendants as bullets indented by two spaces per level. Icons are written as
+*   :code: in front of the text; folded nodes and left children of the root node are marked by HTML comments.
+* - OPML: one outline element per node with the text attribute. Icons, folding and the left side are written to the
+*   icons, folded and position attributes.
+*
+* The nodes are visited with an explicit stack and all lines are appended to one buffer, thus, neither the depth nor the
+* size of the subtree is limited by the call stack or by intermediate strings. Writing to a stream flushes the buffer
+* regularly such that the memory does not grow with the size of the output.
+*/
+@interface QMOutlineWriter : NSObject
+
+- (NSString *)plainTextOutlineOfNode:(QMNode *)node;
+- (void)appendPlainTextOutlineOfNode:(QMNode *)node toString:(NSMutableString *)string;
+
+/**
+* Returns the outline without trailing line break.
+*/
+- (NSString *)outlineOfNode:(QMNode *)node format:(QMOutlineFormat)format;
+
+/**
+* Writes the outline, terminated by a line break, to the opened stream. Returns NO when the stream failed.
+*/
+- (BOOL)writeOutlineOfNode:(QMNode *)node format:(QMOutlineFormat)format toStream:(NSOutputStream *)stream;
+
+@end
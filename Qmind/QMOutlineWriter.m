@@ -0,0 +1,271 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import <Qkit/Qkit.h>
+#import "QMOutlineWriter.h"
+#import "QMNode.h"
+#import "QMTrace.h"
+
+/**
+* Number of characters after which the buffer is written to the stream.
+*/
+static const NSUInteger qFlushLength = 64 * 1024;
+
+static NSString * const qOpmlIconSeparator = @",";
+
+@implementation QMOutlineWriter {
+    NSMutableString *_buffer;
+    NSOutputStream *_stream;
+
+    BOOL _firstLine;
+    BOOL _streamFailed;
+}
+
+#pragma mark Public
+- (NSString *)plainTextOutlineOfNode:(QMNode *)node {
+    return [self outlineOfNode:node format:QMOutlineFormatPlainText];
+}
+
+- (void)appendPlainTextOutlineOfNode:(QMNode *)node toString:(NSMutableString *)string {
+    QM_TRACE_SCOPE("write plain text outline");
+
+    _buffer = string;
+    [self appendOutlineOfNode:node format:QMOutlineFormatPlainText];
+    _buffer = nil;
+}
+
+- (NSString *)outlineOfNode:(QMNode *)node format:(QMOutlineFormat)format {
+    QM_TRACE_SCOPE("write outline");
+
+    NSMutableString *result = [[NSMutableString alloc] init];
+
+    _buffer = result;
+    [self appendOutlineOfNode:node format:format];
+    _buffer = nil;
+
+    return result;
+}
+
+- (BOOL)writeOutlineOfNode:(QMNode *)node format:(QMOutlineFormat)format toStream:(NSOutputStream *)stream {
+    QM_TRACE_SCOPE("write outline to stream");
+
+    _buffer = [[NSMutableString alloc] initWithCapacity:qFlushLength];
+    _stream = stream;
+    _streamFailed = NO;
+
+    [self appendOutlineOfNode:node format:format];
+    [_buffer appendString:@"\n"];
+    [self flushBuffer];
+
+    BOOL success = !_streamFailed;
+
+    _buffer = nil;
+    _stream = nil;
+
+    return success;
+}
+
+#pragma mark Private
+- (void)appendOutlineOfNode:(QMNode *)node format:(QMOutlineFormat)format {
+    _firstLine = YES;
+
+    if (format == QMOutlineFormatOpml) {
+        [self appendOpmlHeadOfNode:node];
+    }
+
+    QMStack *stack = [[NSMutableArray alloc] initWithCapacity:15];
+    [stack push:@[node, @0]];
+
+    while (stack.count > 0 && !_streamFailed) {
+        NSArray *entry = [stack pop];
+        QMNode *currentNode = entry[0];
+        NSUInteger level = [entry[1] unsignedIntegerValue];
+
+        // a third element marks the end of the outline element of the node
+        if (entry.count == 3) {
+            [self beginLineWithCharacter:@"\t" count:level + 2];
+            [_buffer appendString:@"</outline>"];
+            continue;
+        }
+
+        NSArray *children = currentNode.allChildren;
+
+        switch (format) {
+            case QMOutlineFormatMarkdown:
+                [self appendMarkdownLineOfNode:currentNode level:level];
+                break;
+            case QMOutlineFormatOpml:
+                [self appendOpmlLineOfNode:currentNode level:level hasChildren:children.count > 0];
+                if (children.count > 0) {
+                    [stack push:@[currentNode, @(level), @YES]];
+                }
+                break;
+            default:
+                [self beginLineWithCharacter:@"\t" count:level];
+                [_buffer appendString:[self singleLineOfString:currentNode.stringValue]];
+                break;
+        }
+
+        if (_stream != nil && _buffer.length >= qFlushLength) {
+            [self flushBuffer];
+        }
+
+        NSNumber *levelOfChildren = @(level + 1);
+        for (QMNode *child in children.reverseObjectEnumerator) {
+            [stack push:@[child, levelOfChildren]];
+        }
+    }
+
+    if (format == QMOutlineFormatOpml) {
+        [self beginLineWithCharacter:@"\t" count:1];
+        [_buffer appendString:@"</body>"];
+        [self beginLineWithCharacter:@"\t" count:0];
+        [_buffer appendString:@"</opml>"];
+    }
+}
+
+- (void)appendMarkdownLineOfNode:(QMNode *)node level:(NSUInteger)level {
+    if (level == 0) {
+        [self beginLineWithCharacter:@" " count:0];
+        [_buffer appendString:@"# "];
+    } else {
+        [self beginLineWithCharacter:@" " count:2 * (level - 1)];
+        [_buffer appendString:@"- "];
+    }
+
+    for (NSString *iconCode in node.icons) {
+        [_buffer appendFormat:@":%@: ", iconCode];
+    }
+
+    [_buffer appendString:[self singleLineOfString:node.stringValue]];
+
+    if ([self isLeftChildOfRoot:node]) {
+        [_buffer appendString:@" <!-- left -->"];
+    }
+
+    if ([self isFoldedNode:node]) {
+        [_buffer appendString:@" <!-- folded -->"];
+    }
+}
+
+- (void)appendOpmlHeadOfNode:(QMNode *)node {
+    [self beginLineWithCharacter:@"\t" count:0];
+    [_buffer appendString:@"<?xml version=\"1.0\" encoding=\"UTF-8\"?>"];
+    [self beginLineWithCharacter:@"\t" count:0];
+    [_buffer appendString:@"<opml version=\"2.0\">"];
+    [self beginLineWithCharacter:@"\t" count:1];
+    [_buffer appendString:@"<head>"];
+    [self beginLineWithCharacter:@"\t" count:2];
+    [_buffer appendFormat:@"<title>%@</title>", [self escapedXmlStringOfString:node.stringValue]];
+    [self beginLineWithCharacter:@"\t" count:1];
+    [_buffer appendString:@"</head>"];
+    [self beginLineWithCharacter:@"\t" count:1];
+    [_buffer appendString:@"<body>"];
+}
+
+- (void)appendOpmlLineOfNode:(QMNode *)node level:(NSUInteger)level hasChildren:(BOOL)hasChildren {
+    [self beginLineWithCharacter:@"\t" count:level + 2];
+    [_buffer appendFormat:@"<outline text=\"%@\"", [self escapedXmlStringOfString:node.stringValue]];
+
+    if (node.icons.count > 0) {
+        NSString *icons = [node.icons componentsJoinedByString:qOpmlIconSeparator];
+        [_buffer appendFormat:@" icons=\"%@\"", [self escapedXmlStringOfString:icons]];
+    }
+
+    if ([self isLeftChildOfRoot:node]) {
+        [_buffer appendString:@" position=\"left\""];
+    }
+
+    if ([self isFoldedNode:node]) {
+        [_buffer appendString:@" folded=\"true\""];
+    }
+
+    [_buffer appendString:hasChildren ? @">" : @"/>"];
+}
+
+- (BOOL)isLeftChildOfRoot:(QMNode *)node {
+    return node.left && node.parent.isRoot;
+}
+
+- (BOOL)isFoldedNode:(QMNode *)node {
+    return node.folded && !node.leaf;
+}
+
+/**
+* Separates the lines with line breaks and indents the new line.
+*/
+- (void)beginLineWithCharacter:(NSString *)indentCharacter count:(NSUInteger)count {
+    if (!_firstLine) {
+        [_buffer appendString:@"\n"];
+    }
+    _firstLine = NO;
+
+    for (NSUInteger i = 0; i < count; i++) {
+        [_buffer appendString:indentCharacter];
+    }
+}
+
+- (NSString *)singleLineOfString:(NSString *)stringValue {
+    if (stringValue.length == 0) {
+        return @"";
+    }
+
+    NSCharacterSet *newlines = [NSCharacterSet newlineCharacterSet];
+    if ([stringValue rangeOfCharacterFromSet:newlines].location == NSNotFound) {
+        return stringValue;
+    }
+
+    return [[stringValue componentsSeparatedByCharactersInSet:newlines] componentsJoinedByString:@" "];
+}
+
+- (NSString *)escapedXmlStringOfString:(NSString *)string {
+    NSString *line = [self singleLineOfString:string];
+
+    static NSCharacterSet *charactersToEscape = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        charactersToEscape = [NSCharacterSet characterSetWithCharactersInString:@"&<>\""];
+    });
+
+    if ([line rangeOfCharacterFromSet:charactersToEscape].location == NSNotFound) {
+        return line;
+    }
+
+    NSMutableString *result = [line mutableCopy];
+    [result replaceOccurrencesOfString:@"&" withString:@"&amp;" options:0 range:NSMakeRange(0, result.length)];
+    [result replaceOccurrencesOfString:@"<" withString:@"&lt;" options:0 range:NSMakeRange(0, result.length)];
+    [result replaceOccurrencesOfString:@">" withString:@"&gt;" options:0 range:NSMakeRange(0, result.length)];
+    [result replaceOccurrencesOfString:@"\"" withString:@"&quot;" options:0 range:NSMakeRange(0, result.length)];
+
+    return result;
+}
+
+- (void)flushBuffer {
+    if (_buffer.length == 0 || _streamFailed) {
+        return;
+    }
+
+    @autoreleasepool {
+        NSData *data = [_buffer dataUsingEncoding:NSUTF8StringEncoding];
+        [_buffer setString:@""];
+
+        const uint8_t *bytes = data.bytes;
+        NSUInteger countOfWrittenBytes = 0;
+        while (countOfWrittenBytes < data.length) {
+            NSInteger result = [_stream write:bytes + countOfWrittenBytes maxLength:data.length - countOfWrittenBytes];
+            if (result <= 0) {
+                _streamFailed = YES;
+                return;
+            }
+
+            countOfWrittenBytes += result;
+        }
+    }
+}
+
+@end
@@ -15,8 +15,12 @@
 
 /**
 * Helper class to build up the mindmap internally using event-driven xml reading and the class QMNode.
+*
+* The proxies do not retain each other: QMXmlParser retains the proxy of each open element, thus, only the proxies of the
+* path to the current element are alive.
 * 
 * @see QMNode
+* @see QMXmlParser
 */
 @interface QMProxyNode : NSObject <NSXMLParserDelegate>
 
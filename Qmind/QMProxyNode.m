@@ -20,7 +20,6 @@
     __weak QMIdGenerator *_idGenerator;
 
     __weak QMProxyNode *_parent;
-    NSMutableArray *_children;
 
     id _node;
     NSXMLElement *_unsupportedXmlElement;
@@ -49,8 +48,6 @@
         }
 
         QMProxyNode *proxyNode = [[QMProxyNode alloc] initWithParent:self node:childNode];
-        [_children addObject:proxyNode];
-
         [parser setDelegate:proxyNode];
 
         return;
@@ -77,8 +74,6 @@
 
     QMProxyNode *proxyNode = [[QMProxyNode alloc] initAsUnsupportedXmlElement:xmlElement withParent:self];
 
-    [_children addObject:proxyNode];
-
     if ([self isUnsupportedElement]) {
         [_unsupportedXmlElement addChild:xmlElement];
     } else {
@@ -143,7 +138,6 @@
 
         _parent = parent;
         _node = node;
-        _children = [[NSMutableArray alloc] initWithCapacity:3];
     }
 
     return self;
@@ -155,7 +149,6 @@
         [self ensureExistenceOfNodeId:node];
 
         _node = node;
-        _children = [[NSMutableArray alloc] initWithCapacity:5];
     }
 
     return self;
@@ -168,7 +161,6 @@
         _node = nil;
         _unsupportedXmlElement = xmlElement;
         _parent = parent;
-        _children = [[NSMutableArray alloc] init];
     }
 
     return self;
@@ -18,11 +18,7 @@
 */
 @property (readonly) NSSize leftChildrenFamilySize;
 
-/**
-* Draws the cell and all of its children.
-*/
-- (void)drawRect:(NSRect)dirtyRect;
-- (id)initWithView:(QMMindmapView *)view;
+- (id)initWithView:(QMMindmapView *)view layoutContext:(QMLayoutContext *)layoutContext;
 
 - (void)addChild:(QMCell *)childCell left:(BOOL)cellIsLeft;
 
@@ -8,8 +8,8 @@
 
 #import <Qkit/Qkit.h>
 #import "QMRootCell.h"
-#import "QMCellDrawer.h"
 #import "QMCellSizeManager.h"
+#import "QMTrace.h"
 
 @interface QMRootCell ()
 
@@ -37,6 +37,7 @@
     childCell.parent = self;
     childCell.left = YES;
     [self.mutableLeftChildren insertObject:childCell atIndex:index];
+    [self updateIndexesOfChildren:self.leftChildren fromIndex:index];
 
     self.needsToRecomputeSize = YES;
 }
@@ -47,6 +48,7 @@
     cellToDel.left = NO;
 
     [self.mutableLeftChildren removeObjectAtIndex:index];
+    [self updateIndexesOfChildren:self.leftChildren fromIndex:index];
 
     self.needsToRecomputeSize = YES;
 }
@@ -68,9 +70,13 @@
 
 - (void)computeAllSizesIfNecessary {
     if (!self.needsToRecomputeSize) {
+        QM_TRACE_COUNT("text size cache hits", 1);
         return;
     }
 
+    QM_TRACE_COUNT("text size cache misses", 1);
+
+    [self computeSizesOfDescendantsIfNecessary];
     self.needsToRecomputeSize = NO;
 
     _iconSize = [self.cellSizeManager sizeOfIconsOfCell:self];
@@ -107,20 +113,8 @@
     return [self.children arrayByAddingObjectsFromArray:self.leftChildren];
 }
 
-- (void)drawRect:(NSRect)dirtyRect {
-    [self.cellDrawer drawCell:self rect:dirtyRect];
-
-    if (self.leaf || self.folded) {
-        return;
-    }
-
-    for (QMCell *childCell in self.allChildren) {
-        [childCell drawRect:dirtyRect];
-    }
-}
-
-- (id)initWithView:(QMMindmapView *)view {
-    if ((self = [super initWithView:view])) {
+- (id)initWithView:(QMMindmapView *)view layoutContext:(QMLayoutContext *)layoutContext {
+    if ((self = [super initWithView:view layoutContext:layoutContext])) {
         _leftChildren = [[NSMutableArray alloc] initWithCapacity:2];
     }
 
@@ -138,25 +132,17 @@
 
 - (void)removeChild:(QMCell *)childCell {
     if (childCell.isLeft) {
-        [self removeObjectFromLeftChildrenAtIndex:[self.leftChildren indexOfObject:childCell]];
+        [self removeObjectFromLeftChildrenAtIndex:[self indexOfChild:childCell]];
         return;
     }
 
-    [self removeObjectFromChildrenAtIndex:[self.children indexOfObject:childCell]];
+    [self removeObjectFromChildrenAtIndex:[self indexOfChild:childCell]];
 }
 
 - (NSUInteger)countOfAllChildren {
     return self.allChildren.count;
 }
 
-- (NSUInteger)indexOfChild:(QMCell *)childCell {
-    if (childCell.isLeft) {
-        return [self.leftChildren indexOfObject:childCell];
-    }
-
-    return [self.children indexOfObject:childCell];
-}
-
 #pragma mark Private
 - (NSMutableArray *)mutableLeftChildren {
     @synchronized (self) {
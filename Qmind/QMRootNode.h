@@ -33,4 +33,7 @@ extern NSString * const qNodeLeftChildrenKey;
 - (void)removeObjectFromLeftChildrenAtIndex:(NSUInteger)index;
 - (void)addObjectInLeftChildren:(QMNode *)childNode;
 
+- (void)insertLeftChildren:(NSArray *)childNodes atIndexes:(NSIndexSet *)indexes;
+- (void)removeLeftChildrenAtIndexes:(NSIndexSet *)indexes;
+
 @end
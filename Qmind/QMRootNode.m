@@ -54,12 +54,12 @@ NSString * const qNodeLeftChildrenKey = @"leftChildren";
     [[self.undoManager prepareWithInvocationTarget:self] removeObjectFromLeftChildrenAtIndex:index];
 
     childNode.parent = self;
+    childNode.left = YES;
     childNode.undoManager = self.undoManager;
     [self.mutableLeftChildren insertObject:childNode atIndex:index];
+    [self updateIndexesOfChildren:self.leftChildren fromIndex:index];
 
-    [self.observerInfos enumerateObjectsUsingBlock:^(QObserverInfo *info, BOOL *stop) {
-        [childNode addObserver:info.observer forKeyPath:info.keyPath];
-    }];
+    [self publishInsertionOfObjects:@[childNode] atIndexes:[NSIndexSet indexSetWithIndex:index] ofKey:qNodeLeftChildrenKey];
 }
 
 - (void)removeObjectFromLeftChildrenAtIndex:(NSUInteger)index {
@@ -69,8 +69,37 @@ NSString * const qNodeLeftChildrenKey = @"leftChildren";
     [[self.undoManager prepareWithInvocationTarget:self] insertObject:nodeToDel inLeftChildrenAtIndex:index];
 
     [self.mutableLeftChildren removeObjectAtIndex:index];
+    [self updateIndexesOfChildren:self.leftChildren fromIndex:index];
 
-    [nodeToDel removeObserver:[[self.observerInfos anyObject] observer]];
+    [self publishRemovalOfObjects:@[nodeToDel] atIndexes:[NSIndexSet indexSetWithIndex:index] ofKey:qNodeLeftChildrenKey];
+}
+
+- (void)insertLeftChildren:(NSArray *)childNodes atIndexes:(NSIndexSet *)indexes {
+    [[self.undoManager prepareWithInvocationTarget:self] removeLeftChildrenAtIndexes:[indexes copy]];
+
+    for (QMNode *childNode in childNodes) {
+        childNode.parent = self;
+        childNode.left = YES;
+        childNode.undoManager = self.undoManager;
+    }
+    [self.mutableLeftChildren insertObjects:childNodes atIndexes:indexes];
+    [self updateIndexesOfChildren:self.leftChildren fromIndex:indexes.firstIndex];
+
+    [self publishInsertionOfObjects:childNodes atIndexes:indexes ofKey:qNodeLeftChildrenKey];
+}
+
+- (void)removeLeftChildrenAtIndexes:(NSIndexSet *)indexes {
+    NSArray *nodesToDel = [self.leftChildren objectsAtIndexes:indexes];
+    [[self.undoManager prepareWithInvocationTarget:self] insertLeftChildren:nodesToDel atIndexes:[indexes copy]];
+
+    [self.mutableLeftChildren removeObjectsAtIndexes:indexes];
+    [self updateIndexesOfChildren:self.leftChildren fromIndex:indexes.firstIndex];
+
+    for (QMNode *nodeToDel in nodesToDel) {
+        nodeToDel.parent = nil;
+    }
+
+    [self publishRemovalOfObjects:nodesToDel atIndexes:indexes ofKey:qNodeLeftChildrenKey];
 }
 
 - (void)addObjectInLeftChildren:(QMNode *)childNode {
@@ -102,25 +131,6 @@ NSString * const qNodeLeftChildrenKey = @"leftChildren";
     return [self.children arrayByAddingObjectsFromArray:self.leftChildren];
 }
 
-#pragma mark QObservedObject
-- (void)addObserver:(id)observer forKeyPath:(NSString *)keyPath {
-    if ([keyPath isEqualToString:qNodeLeftChildrenKey]) {
-        [self addObserver:observer forKeyPath:keyPath options:NSKeyValueObservingOptionNew context:NULL];
-        return;
-    }
-
-    [super addObserver:observer forKeyPath:keyPath];
-}
-
-#pragma mark NSKeyValueObservingCustomization
-+ (BOOL)automaticallyNotifiesObserversForKey:(NSString *)key {
-    if ([key isEqualToString:qNodeLeftChildrenKey]) {
-        return YES;
-    }
-
-    return [super automaticallyNotifiesObserversForKey:key];
-}
-
 #pragma mark Initializer
 - (id)init {
     return [self initWithAttributes:nil];
@@ -137,12 +147,16 @@ NSString * const qNodeLeftChildrenKey = @"leftChildren";
 #pragma mark NSCoding
 - (void)encodeWithCoder:(NSCoder *)coder {
     [super encodeWithCoder:coder];
-    [coder encodeObject:self.leftChildren forKey:qNodeLeftChildrenArchiveKey];
+    [coder encodeObject:[self archiveRecordsOfNodes:self.leftChildren] forKey:qNodeLeftChildrenArchiveKey];
 }
 
 - (id)initWithCoder:(NSCoder *)decoder {
     if ((self = [super initWithCoder:decoder])) {
-        _leftChildren = [decoder decodeObjectForKey:qNodeLeftChildrenArchiveKey];
+        _leftChildren = [self nodesOfArchiveRecords:[decoder decodeObjectForKey:qNodeLeftChildrenArchiveKey]];
+
+        for (QMNode *childNode in _leftChildren) {
+            childNode.left = YES;
+        }
     }
 
     return self;
@@ -150,6 +164,8 @@ NSString * const qNodeLeftChildrenKey = @"leftChildren";
 
 #pragma mark Private
 - (NSMutableArray *)mutableLeftChildren {
+    [self prepareForMutation];
+
     @synchronized (self) {
         return _leftChildren;
     }
@@ -0,0 +1,52 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import <Foundation/Foundation.h>
+
+@class QMNode;
+@class QMRootNode;
+
+/**
+* In-memory inverted index over the text and the link of all nodes of a mindmap: it maps the lower case words to the
+* nodes containing them.
+*/
+@interface QMSearchIndex : NSObject
+
+@property (readonly, weak) QMRootNode *rootNode;
+
+/**
+* Indexes all nodes of the given root node.
+*/
+- (id)initWithRootNode:(QMRootNode *)rootNode;
+
+/**
+* Indexes the node and all its descendants. Adding an already indexed node re-indexes it.
+*/
+- (void)addNode:(QMNode *)node;
+
+/**
+* Removes the node and all its descendants from the index, eg after it has been removed from its parent.
+*/
+- (void)removeNode:(QMNode *)node;
+
+/**
+* Re-indexes only the node, eg after its string value changed.
+*/
+- (void)updateNode:(QMNode *)node;
+
+/**
+* Returns the nodes, in document order, which contain for each word of the query a word starting with it.
+*/
+- (NSArray *)nodesWithPrefix:(NSString *)prefix;
+
+/**
+* Returns the nodes, in document order, whose text or link contains the given string ignoring the case.
+*/
+- (NSArray *)nodesContainingString:(NSString *)string;
+
+@end
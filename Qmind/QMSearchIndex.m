@@ -0,0 +1,243 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import <Qkit/Qkit.h>
+#import "QMSearchIndex.h"
+#import "QMRootNode.h"
+
+@implementation QMSearchIndex {
+    NSMutableDictionary *_nodesByWord;
+    NSMapTable *_wordsByNode;
+
+    /**
+    * All words sorted for prefix queries. nil when a new word has been added since the last sorting.
+    */
+    NSArray *_sortedWords;
+}
+
+#pragma mark Public
+- (void)addNode:(QMNode *)node {
+    QMStack *nodeStack = [[NSMutableArray alloc] initWithCapacity:15];
+    [nodeStack push:node];
+
+    while (nodeStack.count > 0) {
+        QMNode *currentNode = [nodeStack pop];
+        [self updateNode:currentNode];
+        [nodeStack pushArray:currentNode.allChildren];
+    }
+}
+
+- (void)removeNode:(QMNode *)node {
+    QMStack *nodeStack = [[NSMutableArray alloc] initWithCapacity:15];
+    [nodeStack push:node];
+
+    while (nodeStack.count > 0) {
+        QMNode *currentNode = [nodeStack pop];
+
+        for (NSString *word in [_wordsByNode objectForKey:currentNode]) {
+            [_nodesByWord[word] removeObject:currentNode];
+        }
+
+        [_wordsByNode removeObjectForKey:currentNode];
+        [nodeStack pushArray:currentNode.allChildren];
+    }
+}
+
+- (void)updateNode:(QMNode *)node {
+    NSSet *oldWords = [_wordsByNode objectForKey:node];
+    NSSet *newWords = [self wordsOfNode:node];
+
+    for (NSString *word in oldWords) {
+        if (![newWords containsObject:word]) {
+            [_nodesByWord[word] removeObject:node];
+        }
+    }
+
+    for (NSString *word in newWords) {
+        if ([oldWords containsObject:word]) {
+            continue;
+        }
+
+        NSHashTable *nodes = _nodesByWord[word];
+        if (nodes == nil) {
+            nodes = [NSHashTable weakObjectsHashTable];
+            _nodesByWord[word] = nodes;
+            _sortedWords = nil;
+        }
+
+        [nodes addObject:node];
+    }
+
+    [_wordsByNode setObject:newWords forKey:node];
+}
+
+- (NSArray *)nodesWithPrefix:(NSString *)prefix {
+    NSArray *queryWords = [self wordsOfString:prefix].allObjects;
+    if (queryWords.count == 0) {
+        return @[];
+    }
+
+    NSMutableSet *result = nil;
+    for (NSString *queryWord in queryWords) {
+        NSMutableSet *nodes = [[NSMutableSet alloc] init];
+
+        NSArray *sortedWords = self.sortedWords;
+        NSUInteger index = [sortedWords indexOfObject:queryWord inSortedRange:NSMakeRange(0, sortedWords.count)
+                                              options:NSBinarySearchingInsertionIndex | NSBinarySearchingFirstEqual
+                                      usingComparator:^(NSString *word1, NSString *word2) {
+                                          return [word1 compare:word2];
+                                      }];
+
+        for (NSUInteger i = index; i < sortedWords.count && [sortedWords[i] hasPrefix:queryWord]; i++) {
+            [nodes addObjectsFromArray:[_nodesByWord[sortedWords[i]] allObjects]];
+        }
+
+        if (result == nil) {
+            result = nodes;
+        } else {
+            [result intersectSet:nodes];
+        }
+    }
+
+    return [self nodesInDocumentOrder:result];
+}
+
+- (NSArray *)nodesContainingString:(NSString *)string {
+    if (string.length == 0) {
+        return @[];
+    }
+
+    // every hit contains the longest word of the query as a part of one of its words
+    NSString *longestQueryWord = nil;
+    for (NSString *queryWord in [self wordsOfString:string]) {
+        if (queryWord.length > longestQueryWord.length) {
+            longestQueryWord = queryWord;
+        }
+    }
+
+    NSMutableSet *candidates = [[NSMutableSet alloc] init];
+    if (longestQueryWord == nil) {
+        for (QMNode *node in _wordsByNode.keyEnumerator) {
+            [candidates addObject:node];
+        }
+    } else {
+        [_nodesByWord enumerateKeysAndObjectsUsingBlock:^(NSString *word, NSHashTable *nodes, BOOL *stop) {
+            if ([word rangeOfString:longestQueryWord].location != NSNotFound) {
+                [candidates addObjectsFromArray:nodes.allObjects];
+            }
+        }];
+    }
+
+    NSMutableSet *result = [[NSMutableSet alloc] initWithCapacity:candidates.count];
+    for (QMNode *node in candidates) {
+        if ([node.stringValue rangeOfString:string options:NSCaseInsensitiveSearch].location != NSNotFound
+                || [node.link rangeOfString:string options:NSCaseInsensitiveSearch].location != NSNotFound) {
+
+            [result addObject:node];
+        }
+    }
+
+    return [self nodesInDocumentOrder:result];
+}
+
+#pragma mark Initializer
+- (id)initWithRootNode:(QMRootNode *)rootNode {
+    if ((self = [super init])) {
+        _rootNode = rootNode;
+
+        _nodesByWord = [[NSMutableDictionary alloc] init];
+        _wordsByNode = [NSMapTable weakToStrongObjectsMapTable];
+
+        if (rootNode != nil) {
+            [self addNode:rootNode];
+        }
+    }
+
+    return self;
+}
+
+#pragma mark Private
+- (NSArray *)sortedWords {
+    if (_sortedWords == nil) {
+        _sortedWords = [_nodesByWord.allKeys sortedArrayUsingSelector:@selector(compare:)];
+    }
+
+    return _sortedWords;
+}
+
+- (NSSet *)wordsOfNode:(QMNode *)node {
+    NSMutableSet *words = [[NSMutableSet alloc] init];
+
+    [words unionSet:[self wordsOfString:node.stringValue]];
+    [words unionSet:[self wordsOfString:node.link]];
+
+    return words;
+}
+
+- (NSSet *)wordsOfString:(NSString *)string {
+    if (string.length == 0) {
+        return [NSSet set];
+    }
+
+    static NSCharacterSet *separators = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        separators = [[NSCharacterSet alphanumericCharacterSet] invertedSet];
+    });
+
+    NSMutableSet *words = [[NSMutableSet alloc] init];
+    for (NSString *word in [string.lowercaseString componentsSeparatedByCharactersInSet:separators]) {
+        if (word.length > 0) {
+            [words addObject:word];
+        }
+    }
+
+    return words;
+}
+
+/**
+* Sorts the nodes in pre-order, right children of the root node first, ie in the order of -[QMNode allChildren].
+*/
+- (NSArray *)nodesInDocumentOrder:(NSSet *)nodes {
+    NSMapTable *pathByNode = [NSMapTable strongToStrongObjectsMapTable];
+
+    for (QMNode *node in nodes) {
+        NSMutableArray *path = [[NSMutableArray alloc] init];
+
+        QMNode *currentNode = node;
+        while (currentNode.parent != nil) {
+            NSUInteger index = currentNode.indexWithinParent;
+            if (currentNode.parent.isRoot && currentNode.left) {
+                index += currentNode.parent.countOfChildren;
+            }
+
+            [path insertObject:@(index) atIndex:0];
+            currentNode = currentNode.parent;
+        }
+
+        [pathByNode setObject:path forKey:node];
+    }
+
+    NSArray *result = [pathByNode.keyEnumerator.allObjects sortedArrayUsingComparator:^(QMNode *node1, QMNode *node2) {
+        NSArray *path1 = [pathByNode objectForKey:node1];
+        NSArray *path2 = [pathByNode objectForKey:node2];
+
+        for (NSUInteger i = 0; i < MIN(path1.count, path2.count); i++) {
+            NSComparisonResult comparison = [path1[i] compare:path2[i]];
+            if (comparison != NSOrderedSame) {
+                return comparison;
+            }
+        }
+
+        return [@(path1.count) compare:@(path2.count)];
+    }];
+
+    return result;
+}
+
+@end
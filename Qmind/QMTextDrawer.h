@@ -8,10 +8,16 @@
 
 #import <Cocoa/Cocoa.h>
 
+@class QMTextLayout;
 @protocol TBBean;
 
 @interface QMTextDrawer : NSObject <TBBean>
 
 - (void)drawAttributedString:(NSAttributedString *)attrStr inRect:(NSRect)frame range:(NSRange)range;
 
+/**
+* Draws the already laid out text: in contrast to -drawAttributedString:inRect:range: the text is not laid out again.
+*/
+- (void)drawTextLayout:(QMTextLayout *)textLayout range:(NSRange)range atPoint:(NSPoint)point;
+
 @end
@@ -8,6 +8,7 @@
 
 #import <TBCacao/TBCacao.h>
 #import "QMTextDrawer.h"
+#import "QMTextLayout.h"
 
 @implementation QMTextDrawer {
     NSLayoutManager *_layoutManager;
@@ -25,6 +26,10 @@
     }
 }
 
+- (void)drawTextLayout:(QMTextLayout *)textLayout range:(NSRange)range atPoint:(NSPoint)point {
+    [textLayout drawGlyphsForGlyphRange:range atPoint:point];
+}
+
 #pragma mark NSObject
 - (id)init {
     if ((self = [super init])) {
@@ -0,0 +1,34 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import <Cocoa/Cocoa.h>
+
+/**
+* The text of one cell laid out once: it owns its text storage, layout manager and text container such that the glyphs
+* and line fragments survive between draws. It is immutable; when the string, the font or the size changes, create a
+* new one.
+*/
+@interface QMTextLayout : NSObject
+
+@property (readonly) NSAttributedString *attributedString;
+@property (readonly) NSSize containerSize;
+
+/**
+* Lays out the string eagerly.
+*/
+- (id)initWithAttributedString:(NSAttributedString *)attrStr containerSize:(NSSize)containerSize;
+
+/**
+* Returns YES when the layout can be drawn for the string and the size. The string is compared by identity since
+* QMCell creates a new attributed string for every change of the text or of the font.
+*/
+- (BOOL)isLayoutOfAttributedString:(NSAttributedString *)attrStr containerSize:(NSSize)containerSize;
+
+- (void)drawGlyphsForGlyphRange:(NSRange)range atPoint:(NSPoint)point;
+
+@end
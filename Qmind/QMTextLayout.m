@@ -0,0 +1,49 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import "QMTextLayout.h"
+
+@implementation QMTextLayout {
+    NSLayoutManager *_layoutManager;
+    NSTextStorage *_textStorage;
+    NSTextContainer *_textContainer;
+}
+
+#pragma mark Public
+- (BOOL)isLayoutOfAttributedString:(NSAttributedString *)attrStr containerSize:(NSSize)containerSize {
+    return _attributedString == attrStr && NSEqualSizes(_containerSize, containerSize);
+}
+
+- (void)drawGlyphsForGlyphRange:(NSRange)range atPoint:(NSPoint)point {
+    [_layoutManager drawGlyphsForGlyphRange:range atPoint:point];
+}
+
+#pragma mark Initializer
+- (id)initWithAttributedString:(NSAttributedString *)attrStr containerSize:(NSSize)containerSize {
+    if ((self = [super init])) {
+        _attributedString = attrStr;
+        _containerSize = containerSize;
+
+        _textContainer = [[NSTextContainer alloc] initWithContainerSize:containerSize];
+        _layoutManager = [[NSLayoutManager alloc] init];
+        _textStorage = [[NSTextStorage alloc] initWithAttributedString:attrStr];
+
+        [_textContainer setLineFragmentPadding:0.0];
+        [_layoutManager addTextContainer:_textContainer];
+        [_textStorage addLayoutManager:_layoutManager];
+
+        /*
+        * The layout manager lays out lazily: force it now such that drawing only renders the glyphs.
+        */
+        (void)[_layoutManager glyphRangeForTextContainer:_textContainer];
+    }
+
+    return self;
+}
+
+@end
@@ -9,6 +9,7 @@
 #import <Cocoa/Cocoa.h>
 
 @class QMAppSettings;
+@class QMTextLayout;
 @protocol TBBean;
 
 @interface QMTextLayoutManager : NSObject <TBBean>
@@ -23,6 +24,23 @@
 - (NSSize)sizeOfAttributedString:(NSAttributedString *)attrStr;
 - (NSRange)completeRangeOfAttributedString:(NSAttributedString *)attrStr;
 
+/**
+* Maximum number of text layouts the manager keeps alive, see -textLayoutOfAttributedString:containerSize:.
+*/
+@property NSUInteger maxCountOfTextLayouts;
+
+/**
+* Returns the string laid out in a container of the given size, eg the text size of a cell, to be drawn without laying
+* out again. Only the maxCountOfTextLayouts most recently used layouts are kept alive by the manager, thus, the caller
+* should refer to the layout weakly, call -touchTextLayout: when drawing it and lay out again when it has been released.
+*/
+- (QMTextLayout *)textLayoutOfAttributedString:(NSAttributedString *)attrStr containerSize:(NSSize)containerSize;
+
+/**
+* Marks the layout as used most recently.
+*/
+- (void)touchTextLayout:(QMTextLayout *)textLayout;
+
 /**
 * Returns an NSDictionary which is suitable as attributes dictionary for creating an NSAttributedString. The attributes
 * are
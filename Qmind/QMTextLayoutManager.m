@@ -10,11 +10,20 @@
 #import <TBCacao/TBCacao.h>
 #import "QMTextLayoutManager.h"
 #import "QMAppSettings.h"
+#import "QMTrace.h"
+#import "QMTextLayout.h"
+
+static NSUInteger const qDefaultMaxCountOfTextLayouts = 1000;
 
 @implementation QMTextLayoutManager {
     NSLayoutManager *_layoutManager;
     NSTextStorage *_textStorage;
     NSTextContainer *_textContainer;
+
+    /**
+    * The kept text layouts, the least recently used one first.
+    */
+    NSMutableOrderedSet *_textLayouts;
 }
 
 TB_AUTOWIRE(settings)
@@ -48,6 +57,9 @@ TB_AUTOWIRE(settings)
         return NewSize(0.0, 0.0);
     }
 
+    QM_TRACE_SCOPE("measure text");
+    QM_TRACE_COUNT("texts measured", 1);
+
     @synchronized (_textStorage) {
         [_textStorage setAttributedString:attrStr];
         [_textContainer setContainerSize:NewSize(MAX_CGFLOAT, MAX_CGFLOAT)];
@@ -83,6 +95,37 @@ TB_AUTOWIRE(settings)
     }
 }
 
+- (QMTextLayout *)textLayoutOfAttributedString:(NSAttributedString *)attrStr containerSize:(NSSize)containerSize {
+    QM_TRACE_SCOPE("lay out text");
+    QM_TRACE_COUNT("texts laid out", 1);
+
+    QMTextLayout *textLayout = [[QMTextLayout alloc] initWithAttributedString:attrStr containerSize:containerSize];
+
+    @synchronized (self) {
+        [_textLayouts addObject:textLayout];
+
+        if (_textLayouts.count > self.maxCountOfTextLayouts) {
+            NSUInteger countOfReleasedLayouts = _textLayouts.count - self.maxCountOfTextLayouts;
+
+            QM_TRACE_COUNT("text layouts released", countOfReleasedLayouts);
+            [_textLayouts removeObjectsInRange:NSMakeRange(0, countOfReleasedLayouts)];
+        }
+    }
+
+    return textLayout;
+}
+
+- (void)touchTextLayout:(QMTextLayout *)textLayout {
+    @synchronized (self) {
+        if (_textLayouts.lastObject == textLayout) {
+            return;
+        }
+
+        [_textLayouts removeObject:textLayout];
+        [_textLayouts addObject:textLayout];
+    }
+}
+
 - (NSDictionary *)stringAttributesDictWithFont:(NSFont *)font {
     NSMutableParagraphStyle *style = [[NSMutableParagraphStyle alloc] init];
 
@@ -110,6 +153,9 @@ TB_AUTOWIRE(settings)
         _layoutManager = [[NSLayoutManager alloc] init];
         _textStorage = [[NSTextStorage alloc] init];
 
+        _textLayouts = [[NSMutableOrderedSet alloc] init];
+        _maxCountOfTextLayouts = qDefaultMaxCountOfTextLayouts;
+
         [_textContainer setLineFragmentPadding:0.0];
         [_textStorage addLayoutManager:_layoutManager];
         [_layoutManager addTextContainer:_textContainer];
@@ -0,0 +1,57 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import <Foundation/Foundation.h>
+
+/**
+* Scoped timers and counters for the hot paths of the document and view pipeline. Everything is compiled out unless
+* QM_TRACE is defined, eg by adding QM_TRACE=1 to the preprocessor macros of the build configuration.
+*
+* QM_TRACE_SCOPE("name") measures the time until the end of the enclosing scope and QM_TRACE_COUNT("name", n) adds n
+* to the counter. The names have to be string literals. The recorded scopes and counters can be exported in the Chrome
+* trace format, which chrome://tracing and Perfetto can open. Only the latest 65536 scopes are kept.
+*
+* The app writes the trace to the path in the environment variable QM_TRACE_FILE when terminating; File > Export Trace…
+* writes it at any time.
+*/
+#ifdef QM_TRACE
+
+typedef struct {
+    const char *name;
+    uint64_t start;
+} QMTraceScope;
+
+QMTraceScope QMTraceBeginScope(const char *name);
+void QMTraceEndScope(QMTraceScope *scope);
+void QMTraceCount(const char *name, NSInteger count);
+
+/**
+* Returns the recorded scopes and the current values of the counters as Chrome trace JSON.
+*/
+NSData *QMTraceChromeTraceData(void);
+BOOL QMTraceWriteChromeTraceToUrl(NSURL *url);
+
+/**
+* Drops all recorded scopes and resets the counters.
+*/
+void QMTraceReset(void);
+
+#define QM_TRACE_CONCAT_(a, b) a ## b
+#define QM_TRACE_CONCAT(a, b) QM_TRACE_CONCAT_(a, b)
+
+#define QM_TRACE_SCOPE(name) \
+    QMTraceScope QM_TRACE_CONCAT(qTraceScope, __LINE__) \
+        __attribute__((cleanup(QMTraceEndScope))) = QMTraceBeginScope(name)
+#define QM_TRACE_COUNT(name, count) QMTraceCount(name, count)
+
+#else
+
+#define QM_TRACE_SCOPE(name)
+#define QM_TRACE_COUNT(name, count)
+
+#endif
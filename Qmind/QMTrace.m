@@ -0,0 +1,160 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import "QMTrace.h"
+
+#ifdef QM_TRACE
+
+#import <mach/mach_time.h>
+#import <pthread.h>
+
+#define qTraceMaxScopes (1 << 16)
+#define qTraceMaxCounters 64
+
+typedef struct {
+    const char *name;
+    uint64_t start;
+    uint64_t end;
+    mach_port_t thread;
+} QMTraceEvent;
+
+typedef struct {
+    const char *name;
+    NSInteger value;
+} QMTraceCounter;
+
+static pthread_mutex_t qTraceMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+* Ring buffer: qTraceEventCount is the number of all scopes recorded since the last reset.
+*/
+static QMTraceEvent qTraceEvents[qTraceMaxScopes];
+static NSUInteger qTraceEventCount = 0;
+
+static QMTraceCounter qTraceCounters[qTraceMaxCounters];
+static NSUInteger qTraceCounterCount = 0;
+
+static uint64_t qTraceOrigin = 0;
+
+static double microsecondsOfTicks(uint64_t ticks) {
+    static mach_timebase_info_data_t timebase;
+    if (timebase.denom == 0) {
+        mach_timebase_info(&timebase);
+    }
+
+    return (double) ticks * timebase.numer / timebase.denom / 1000.0;
+}
+
+QMTraceScope QMTraceBeginScope(const char *name) {
+    QMTraceScope scope = {name, mach_absolute_time()};
+    return scope;
+}
+
+void QMTraceEndScope(QMTraceScope *scope) {
+    uint64_t end = mach_absolute_time();
+    mach_port_t thread = pthread_mach_thread_np(pthread_self());
+
+    pthread_mutex_lock(&qTraceMutex);
+
+    if (qTraceOrigin == 0 || scope->start < qTraceOrigin) {
+        qTraceOrigin = scope->start;
+    }
+
+    QMTraceEvent event = {scope->name, scope->start, end, thread};
+    qTraceEvents[qTraceEventCount % qTraceMaxScopes] = event;
+    qTraceEventCount++;
+
+    pthread_mutex_unlock(&qTraceMutex);
+}
+
+void QMTraceCount(const char *name, NSInteger count) {
+    pthread_mutex_lock(&qTraceMutex);
+
+    // the names are literals, thus, mostly the pointers are equal
+    for (NSUInteger i = 0; i < qTraceCounterCount; i++) {
+        if (qTraceCounters[i].name == name || strcmp(qTraceCounters[i].name, name) == 0) {
+            qTraceCounters[i].value += count;
+            pthread_mutex_unlock(&qTraceMutex);
+            return;
+        }
+    }
+
+    if (qTraceCounterCount < qTraceMaxCounters) {
+        QMTraceCounter counter = {name, count};
+        qTraceCounters[qTraceCounterCount] = counter;
+        qTraceCounterCount++;
+    }
+
+    pthread_mutex_unlock(&qTraceMutex);
+}
+
+NSData *QMTraceChromeTraceData(void) {
+    NSNumber *pid = @([[NSProcessInfo processInfo] processIdentifier]);
+    NSMutableArray *traceEvents = [[NSMutableArray alloc] init];
+
+    pthread_mutex_lock(&qTraceMutex);
+
+    NSUInteger countOfEvents = MIN(qTraceEventCount, (NSUInteger) qTraceMaxScopes);
+    NSUInteger firstEvent = qTraceEventCount - countOfEvents;
+
+    for (NSUInteger i = firstEvent; i < qTraceEventCount; i++) {
+        QMTraceEvent event = qTraceEvents[i % qTraceMaxScopes];
+
+        [traceEvents addObject:@{
+                @"name" : @(event.name),
+                @"cat" : @"qmind",
+                @"ph" : @"X",
+                @"ts" : @(microsecondsOfTicks(event.start - qTraceOrigin)),
+                @"dur" : @(microsecondsOfTicks(event.end - event.start)),
+                @"pid" : pid,
+                @"tid" : @(event.thread),
+        }];
+    }
+
+    NSNumber *now = @(qTraceOrigin == 0 ? 0 : microsecondsOfTicks(mach_absolute_time() - qTraceOrigin));
+    for (NSUInteger i = 0; i < qTraceCounterCount; i++) {
+        NSString *name = @(qTraceCounters[i].name);
+
+        [traceEvents addObject:@{
+                @"name" : name,
+                @"cat" : @"qmind",
+                @"ph" : @"C",
+                @"ts" : now,
+                @"pid" : pid,
+                @"args" : @{name : @(qTraceCounters[i].value)},
+        }];
+    }
+
+    NSUInteger droppedEvents = firstEvent;
+
+    pthread_mutex_unlock(&qTraceMutex);
+
+    NSDictionary *trace = @{
+            @"traceEvents" : traceEvents,
+            @"displayTimeUnit" : @"ms",
+            @"otherData" : @{@"droppedScopes" : @(droppedEvents)},
+    };
+
+    return [NSJSONSerialization dataWithJSONObject:trace options:0 error:NULL];
+}
+
+BOOL QMTraceWriteChromeTraceToUrl(NSURL *url) {
+    return [QMTraceChromeTraceData() writeToURL:url atomically:YES];
+}
+
+void QMTraceReset(void) {
+    pthread_mutex_lock(&qTraceMutex);
+
+    qTraceEventCount = 0;
+    qTraceCounterCount = 0;
+    qTraceOrigin = 0;
+
+    pthread_mutex_unlock(&qTraceMutex);
+}
+
+#endif
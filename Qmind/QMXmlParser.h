@@ -0,0 +1,28 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import <Foundation/Foundation.h>
+
+/**
+* Event-driven XML parser with the interface of NSXMLParser which does not limit the depth of the document: libxml2,
+* which NSXMLParser uses, refuses elements nested deeper than 256 levels and NSXMLParser does not offer a way to lift
+* that limit.
+*
+* The open elements are kept on an explicit stack, thus, neither the call stack nor the parser limits the depth. Only the
+* subset of XML which mm files use is supported: elements, attributes, character data, the predefined entities and
+* character references, comments and CDATA sections. Processing instructions and the document type declaration are
+* skipped and external entities are never resolved. The encoding of the XML declaration is respected, UTF-8 otherwise.
+*
+* The delegate may be changed within the callbacks like with NSXMLParser. The delegate which is set after the start of an
+* element is retained until the element ends, such that delegates which set a new delegate at the start of an element
+* and the previous one at its end, like QMProxyNode does, do not have to retain each other.
+*
+* Use -initWithData:.
+*/
+@interface QMXmlParser : NSXMLParser
+@end
@@ -0,0 +1,741 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import <Qkit/Qkit.h>
+#import <string.h>
+#import "QMXmlParser.h"
+#import "QMTrace.h"
+
+/**
+* Number of bytes in which the XML declaration is looked for the encoding.
+*/
+static const NSUInteger qDeclarationSearchLength = 256;
+
+static const char *const qPredefinedEntityNames[] = {"lt", "gt", "amp", "quot", "apos"};
+static const char qPredefinedEntityCharacters[] = {'<', '>', '&', '"', '\''};
+static const NSUInteger qCountOfPredefinedEntities = sizeof(qPredefinedEntityCharacters);
+
+static inline BOOL isXmlWhitespace(char character) {
+    return character == ' ' || character == '\t' || character == '\n' || character == '\r';
+}
+
+static inline BOOL isNameDelimiter(char character) {
+    return isXmlWhitespace(character) || character == '/' || character == '>' || character == '<' || character == '='
+            || character == '"' || character == '\'';
+}
+
+/**
+* Writes the code point as UTF-8 to the buffer, which must hold at least four bytes, and returns the count of bytes.
+*/
+static NSUInteger encodeUtf8(uint32_t codePoint, uint8_t *buffer) {
+    if (codePoint < 0x80) {
+        buffer[0] = (uint8_t) codePoint;
+        return 1;
+    }
+
+    if (codePoint < 0x800) {
+        buffer[0] = (uint8_t) (0xC0 | (codePoint >> 6));
+        buffer[1] = (uint8_t) (0x80 | (codePoint & 0x3F));
+        return 2;
+    }
+
+    if (codePoint < 0x10000) {
+        buffer[0] = (uint8_t) (0xE0 | (codePoint >> 12));
+        buffer[1] = (uint8_t) (0x80 | ((codePoint >> 6) & 0x3F));
+        buffer[2] = (uint8_t) (0x80 | (codePoint & 0x3F));
+        return 3;
+    }
+
+    buffer[0] = (uint8_t) (0xF0 | (codePoint >> 18));
+    buffer[1] = (uint8_t) (0x80 | ((codePoint >> 12) & 0x3F));
+    buffer[2] = (uint8_t) (0x80 | ((codePoint >> 6) & 0x3F));
+    buffer[3] = (uint8_t) (0x80 | (codePoint & 0x3F));
+    return 4;
+}
+
+@implementation QMXmlParser {
+    NSData *_data;
+    NSData *_utf8Data;
+
+    const char *_bytes;
+    NSUInteger _length;
+    NSUInteger _position;
+
+    __weak id <NSXMLParserDelegate> _delegate;
+
+    /**
+    * Entries of the open elements: the name and the delegate after the start of the element or NSNull.
+    */
+    QMStack *_openElements;
+    NSMutableData *_decodedBytes;
+
+    BOOL _foundRootElement;
+    BOOL _rootElementEnded;
+
+    NSError *_parserError;
+}
+
+#pragma mark NSXMLParser
+- (id)initWithData:(NSData *)data {
+    if ((self = [super initWithData:data])) {
+        _data = data;
+    }
+
+    return self;
+}
+
+- (id <NSXMLParserDelegate>)delegate {
+    return _delegate;
+}
+
+- (void)setDelegate:(id <NSXMLParserDelegate>)delegate {
+    _delegate = delegate;
+}
+
+- (NSError *)parserError {
+    return _parserError;
+}
+
+- (NSInteger)lineNumber {
+    NSInteger result = 1;
+
+    const char *current = _bytes;
+    const char *end = _bytes + MIN(_position, _length);
+    while (current != NULL && current < end) {
+        current = memchr(current, '\n', (size_t) (end - current));
+        if (current != NULL) {
+            result++;
+            current++;
+        }
+    }
+
+    return result;
+}
+
+- (BOOL)parse {
+    QM_TRACE_SCOPE("parse xml");
+
+    _parserError = nil;
+    _foundRootElement = NO;
+    _rootElementEnded = NO;
+    _openElements = [[NSMutableArray alloc] initWithCapacity:15];
+    _decodedBytes = [[NSMutableData alloc] initWithCapacity:1024];
+
+    if (![self prepareBytes]) {
+        return NO;
+    }
+
+    id <NSXMLParserDelegate> delegate = _delegate;
+    if ([delegate respondsToSelector:@selector(parserDidStartDocument:)]) {
+        [delegate parserDidStartDocument:self];
+    }
+
+    while (_parserError == nil && _position < _length) {
+        if (_bytes[_position] == '<') {
+            [self scanMarkup];
+        } else {
+            [self scanCharacters];
+        }
+    }
+
+    if (!_foundRootElement) {
+        [self failWithCode:NSXMLParserEmptyDocumentError description:@"The document has no root element."];
+    } else if (_openElements.count > 0) {
+        NSString *name = [_openElements lastObject][0];
+        [self failWithCode:NSXMLParserPrematureDocumentEndError
+               description:[NSString stringWithFormat:@"The element %@ is not closed.", name]];
+    }
+
+    // the delegates of the open elements do not retain each other, thus, they are released one after another
+    [_openElements removeAllObjects];
+    _utf8Data = nil;
+
+    if (_parserError != nil) {
+        return NO;
+    }
+
+    delegate = _delegate;
+    if ([delegate respondsToSelector:@selector(parserDidEndDocument:)]) {
+        [delegate parserDidEndDocument:self];
+    }
+
+    return YES;
+}
+
+- (void)abortParsing {
+    if (_parserError != nil) {
+        return;
+    }
+
+    _parserError = [NSError errorWithDomain:NSXMLParserErrorDomain code:NSXMLParserDelegateAbortedParseError userInfo:nil];
+}
+
+#pragma mark Private
+/**
+* Converts the data to UTF-8 when the XML declaration names another encoding.
+*/
+- (BOOL)prepareBytes {
+    _utf8Data = _data;
+    _bytes = NULL;
+    _length = 0;
+    _position = 0;
+
+    NSString *encodingName = [self declaredEncodingName];
+    if (encodingName != nil) {
+        CFStringEncoding cfEncoding = CFStringConvertIANACharSetNameToEncoding((__bridge CFStringRef) encodingName);
+        if (cfEncoding == kCFStringEncodingInvalidId) {
+            [self failWithCode:NSXMLParserUnknownEncodingError
+                   description:[NSString stringWithFormat:@"The encoding %@ is not supported.", encodingName]];
+            return NO;
+        }
+
+        NSStringEncoding encoding = CFStringConvertEncodingToNSStringEncoding(cfEncoding);
+        if (encoding != NSUTF8StringEncoding) {
+            NSString *string = [[NSString alloc] initWithData:_data encoding:encoding];
+            if (string == nil) {
+                [self failWithCode:NSXMLParserUnknownEncodingError
+                       description:[NSString stringWithFormat:@"The document is not encoded in %@.", encodingName]];
+                return NO;
+            }
+
+            _utf8Data = [string dataUsingEncoding:NSUTF8StringEncoding];
+        }
+    }
+
+    _bytes = _utf8Data.bytes;
+    _length = _utf8Data.length;
+
+    if (_length >= 3 && memcmp(_bytes, "\xEF\xBB\xBF", 3) == 0) {
+        _position = 3;
+    }
+
+    return YES;
+}
+
+- (NSString *)declaredEncodingName {
+    NSUInteger headLength = MIN(_data.length, qDeclarationSearchLength);
+    NSString *head = [[NSString alloc] initWithBytes:_data.bytes length:headLength encoding:NSISOLatin1StringEncoding];
+
+    NSRange endOfDeclaration = [head rangeOfString:@"?>"];
+    if (![head hasPrefix:@"<?xml"] || endOfDeclaration.location == NSNotFound) {
+        return nil;
+    }
+
+    NSString *declaration = [head substringToIndex:endOfDeclaration.location];
+    NSRange encodingKey = [declaration rangeOfString:@"encoding"];
+    if (encodingKey.location == NSNotFound) {
+        return nil;
+    }
+
+    NSCharacterSet *quotes = [NSCharacterSet characterSetWithCharactersInString:@"\"'"];
+    NSScanner *scanner = [NSScanner scannerWithString:[declaration substringFromIndex:NSMaxRange(encodingKey)]];
+
+    NSString *encodingName = nil;
+    if ([scanner scanString:@"=" intoString:NULL]
+            && [scanner scanCharactersFromSet:quotes intoString:NULL]
+            && [scanner scanUpToCharactersFromSet:quotes intoString:&encodingName]) {
+
+        return encodingName;
+    }
+
+    return nil;
+}
+
+- (void)scanMarkup {
+    if ([self hasPrefix:"<!--"]) {
+        [self scanComment];
+        return;
+    }
+
+    if ([self hasPrefix:"<![CDATA["]) {
+        [self scanCData];
+        return;
+    }
+
+    if ([self hasPrefix:"<?"]) {
+        NSUInteger end = [self locationOfString:"?>" from:_position + 2];
+        if (end == NSNotFound) {
+            [self failWithCode:NSXMLParserPINotFinishedError description:@"The processing instruction is not terminated."];
+            return;
+        }
+
+        _position = end + 2;
+        return;
+    }
+
+    if ([self hasPrefix:"<!"]) {
+        [self skipDocumentTypeDeclaration];
+        return;
+    }
+
+    if ([self hasPrefix:"</"]) {
+        [self scanEndTag];
+        return;
+    }
+
+    [self scanStartTag];
+}
+
+- (void)scanStartTag {
+    if (_rootElementEnded) {
+        [self failWithCode:NSXMLParserExtraContentError description:@"There is an element after the root element."];
+        return;
+    }
+
+    _position++;
+    NSString *name = [self scanName];
+    if (name == nil) {
+        return;
+    }
+
+    NSMutableDictionary *attributes = [[NSMutableDictionary alloc] initWithCapacity:4];
+    BOOL isEmptyElement = NO;
+
+    while (YES) {
+        BOOL separated = [self skipWhitespace];
+        if (_position >= _length) {
+            [self failWithCode:NSXMLParserGTRequiredError
+                   description:[NSString stringWithFormat:@"The start tag of %@ is not terminated.", name]];
+            return;
+        }
+
+        char character = _bytes[_position];
+        if (character == '>') {
+            _position++;
+            break;
+        }
+
+        if (character == '/') {
+            if (_position + 1 >= _length || _bytes[_position + 1] != '>') {
+                [self failWithCode:NSXMLParserGTRequiredError
+                       description:[NSString stringWithFormat:@"> expected after / in the start tag of %@.", name]];
+                return;
+            }
+
+            _position += 2;
+            isEmptyElement = YES;
+            break;
+        }
+
+        if (!separated) {
+            [self failWithCode:NSXMLParserSpaceRequiredError
+                   description:[NSString stringWithFormat:@"Whitespace expected between the attributes of %@.", name]];
+            return;
+        }
+
+        if (![self scanAttributeOfElement:name intoDictionary:attributes]) {
+            return;
+        }
+    }
+
+    _foundRootElement = YES;
+
+    id <NSXMLParserDelegate> delegate = _delegate;
+    if ([delegate respondsToSelector:@selector(parser:didStartElement:namespaceURI:qualifiedName:attributes:)]) {
+        [delegate parser:self didStartElement:name namespaceURI:nil qualifiedName:nil attributes:attributes];
+    }
+
+    id delegateOfElement = _delegate;
+    [_openElements push:@[name, delegateOfElement ?: [NSNull null]]];
+
+    if (isEmptyElement) {
+        [self endElement];
+    }
+}
+
+- (BOOL)scanAttributeOfElement:(NSString *)elementName intoDictionary:(NSMutableDictionary *)attributes {
+    NSString *name = [self scanName];
+    if (name == nil) {
+        return NO;
+    }
+
+    [self skipWhitespace];
+    if (_position >= _length || _bytes[_position] != '=') {
+        [self failWithCode:NSXMLParserEqualExpectedError
+               description:[NSString stringWithFormat:@"= expected after the attribute %@ of %@.", name, elementName]];
+        return NO;
+    }
+
+    _position++;
+    [self skipWhitespace];
+
+    char quote = _position < _length ? _bytes[_position] : '\0';
+    if (quote != '"' && quote != '\'') {
+        [self failWithCode:NSXMLParserAttributeNotStartedError
+               description:[NSString stringWithFormat:@"The value of the attribute %@ of %@ is not quoted.", name, elementName]];
+        return NO;
+    }
+
+    NSUInteger start = _position + 1;
+    const char *end = memchr(_bytes + start, quote, _length - start);
+    if (end == NULL) {
+        [self failWithCode:NSXMLParserAttributeNotFinishedError
+               description:[NSString stringWithFormat:@"The value of the attribute %@ of %@ is not terminated.", name, elementName]];
+        return NO;
+    }
+
+    NSRange range = NSMakeRange(start, (NSUInteger) (end - _bytes) - start);
+    if (memchr(_bytes + start, '<', range.length) != NULL) {
+        [self failWithCode:NSXMLParserLessThanSymbolInAttributeError
+               description:[NSString stringWithFormat:@"The value of the attribute %@ of %@ contains <.", name, elementName]];
+        return NO;
+    }
+
+    NSString *value = [self decodedStringInRange:range isAttributeValue:YES];
+    if (value == nil) {
+        return NO;
+    }
+
+    _position = NSMaxRange(range) + 1;
+
+    if (attributes[name] != nil) {
+        [self failWithCode:NSXMLParserAttributeRedefinedError
+               description:[NSString stringWithFormat:@"The attribute %@ of %@ is defined twice.", name, elementName]];
+        return NO;
+    }
+
+    attributes[name] = value;
+    return YES;
+}
+
+- (void)scanEndTag {
+    _position += 2;
+    NSString *name = [self scanName];
+    if (name == nil) {
+        return;
+    }
+
+    [self skipWhitespace];
+    if (_position >= _length || _bytes[_position] != '>') {
+        [self failWithCode:NSXMLParserGTRequiredError
+               description:[NSString stringWithFormat:@"> expected after the end tag of %@.", name]];
+        return;
+    }
+
+    _position++;
+
+    NSString *nameOfOpenElement = [_openElements lastObject][0];
+    if (![name isEqualToString:nameOfOpenElement]) {
+        [self failWithCode:NSXMLParserTagNameMismatchError
+               description:[NSString stringWithFormat:@"The end tag %@ does not match the open element %@.", name, nameOfOpenElement]];
+        return;
+    }
+
+    [self endElement];
+}
+
+/**
+* The entry of the element is popped after the callback, thus, its delegate lives until the element has ended.
+*/
+- (void)endElement {
+    NSString *name = [_openElements lastObject][0];
+
+    id <NSXMLParserDelegate> delegate = _delegate;
+    if ([delegate respondsToSelector:@selector(parser:didEndElement:namespaceURI:qualifiedName:)]) {
+        [delegate parser:self didEndElement:name namespaceURI:nil qualifiedName:nil];
+    }
+
+    [_openElements pop];
+
+    if (_openElements.count == 0) {
+        _rootElementEnded = YES;
+    }
+}
+
+- (void)scanCharacters {
+    NSUInteger start = _position;
+    const char *end = memchr(_bytes + start, '<', _length - start);
+    _position = end != NULL ? (NSUInteger) (end - _bytes) : _length;
+
+    if (_openElements.count == 0) {
+        for (NSUInteger i = start; i < _position; i++) {
+            if (!isXmlWhitespace(_bytes[i])) {
+                [self failWithCode:NSXMLParserExtraContentError description:@"There is text outside of the root element."];
+                return;
+            }
+        }
+
+        return;
+    }
+
+    id <NSXMLParserDelegate> delegate = _delegate;
+    if (![delegate respondsToSelector:@selector(parser:foundCharacters:)]) {
+        return;
+    }
+
+    NSString *characters = [self decodedStringInRange:NSMakeRange(start, _position - start) isAttributeValue:NO];
+    if (characters == nil) {
+        return;
+    }
+
+    [delegate parser:self foundCharacters:characters];
+}
+
+- (void)scanComment {
+    NSUInteger start = _position + 4;
+    NSUInteger end = [self locationOfString:"-->" from:start];
+    if (end == NSNotFound) {
+        [self failWithCode:NSXMLParserCommentNotTerminatedError description:@"The comment is not terminated."];
+        return;
+    }
+
+    _position = end + 3;
+
+    id <NSXMLParserDelegate> delegate = _delegate;
+    if (![delegate respondsToSelector:@selector(parser:foundComment:)]) {
+        return;
+    }
+
+    NSString *comment = [self stringWithBytes:_bytes + start length:end - start];
+    if (comment == nil) {
+        return;
+    }
+
+    [delegate parser:self foundComment:comment];
+}
+
+/**
+* Delegates which do not handle CDATA sections get their content as characters.
+*/
+- (void)scanCData {
+    NSUInteger start = _position + 9;
+    NSUInteger end = [self locationOfString:"]]>" from:start];
+    if (end == NSNotFound) {
+        [self failWithCode:NSXMLParserCDATANotFinishedError description:@"The CDATA section is not terminated."];
+        return;
+    }
+
+    _position = end + 3;
+
+    id <NSXMLParserDelegate> delegate = _delegate;
+    if ([delegate respondsToSelector:@selector(parser:foundCDATA:)]) {
+        [delegate parser:self foundCDATA:[_utf8Data subdataWithRange:NSMakeRange(start, end - start)]];
+        return;
+    }
+
+    if (![delegate respondsToSelector:@selector(parser:foundCharacters:)]) {
+        return;
+    }
+
+    NSString *characters = [self stringWithBytes:_bytes + start length:end - start];
+    if (characters == nil) {
+        return;
+    }
+
+    [delegate parser:self foundCharacters:characters];
+}
+
+/**
+* Skips <!DOCTYPE ...> including the internal subset in brackets.
+*/
+- (void)skipDocumentTypeDeclaration {
+    BOOL inInternalSubset = NO;
+    char quote = '\0';
+
+    for (NSUInteger i = _position + 2; i < _length; i++) {
+        char character = _bytes[i];
+
+        if (quote != '\0') {
+            if (character == quote) {
+                quote = '\0';
+            }
+
+            continue;
+        }
+
+        if (character == '"' || character == '\'') {
+            quote = character;
+        } else if (character == '[') {
+            inInternalSubset = YES;
+        } else if (character == ']') {
+            inInternalSubset = NO;
+        } else if (character == '>' && !inInternalSubset) {
+            _position = i + 1;
+            return;
+        }
+    }
+
+    [self failWithCode:NSXMLParserDOCTYPEDeclNotFinishedError description:@"The document type declaration is not terminated."];
+}
+
+- (NSString *)scanName {
+    NSUInteger start = _position;
+    while (_position < _length && !isNameDelimiter(_bytes[_position])) {
+        _position++;
+    }
+
+    if (_position == start) {
+        [self failWithCode:NSXMLParserNAMERequiredError description:@"Name expected."];
+        return nil;
+    }
+
+    return [self stringWithBytes:_bytes + start length:_position - start];
+}
+
+/**
+* Returns whether any whitespace was skipped.
+*/
+- (BOOL)skipWhitespace {
+    NSUInteger start = _position;
+    while (_position < _length && isXmlWhitespace(_bytes[_position])) {
+        _position++;
+    }
+
+    return _position > start;
+}
+
+- (BOOL)hasPrefix:(const char *)prefix {
+    size_t prefixLength = strlen(prefix);
+    return _length - _position >= prefixLength && memcmp(_bytes + _position, prefix, prefixLength) == 0;
+}
+
+- (NSUInteger)locationOfString:(const char *)string from:(NSUInteger)location {
+    if (location >= _length) {
+        return NSNotFound;
+    }
+
+    const char *result = memmem(_bytes + location, _length - location, string, strlen(string));
+    return result != NULL ? (NSUInteger) (result - _bytes) : NSNotFound;
+}
+
+/**
+* Resolves the entity and character references and normalizes the line breaks to \n. In attribute values, line breaks
+* and tabs become spaces, as opposed to the ones written as character references.
+*/
+- (NSString *)decodedStringInRange:(NSRange)range isAttributeValue:(BOOL)isAttributeValue {
+    const char *bytes = _bytes + range.location;
+    NSUInteger length = range.length;
+
+    BOOL needsDecoding = NO;
+    for (NSUInteger i = 0; i < length && !needsDecoding; i++) {
+        char character = bytes[i];
+        needsDecoding = character == '&' || character == '\r' || (isAttributeValue && (character == '\n' || character == '\t'));
+    }
+
+    if (!needsDecoding) {
+        return [self stringWithBytes:bytes length:length];
+    }
+
+    [_decodedBytes setLength:0];
+
+    for (NSUInteger i = 0; i < length; i++) {
+        char character = bytes[i];
+
+        if (character == '\r') {
+            if (i + 1 < length && bytes[i + 1] == '\n') {
+                i++;
+            }
+
+            character = '\n';
+        }
+
+        if (isAttributeValue && (character == '\n' || character == '\t')) {
+            character = ' ';
+        }
+
+        if (character != '&') {
+            [_decodedBytes appendBytes:&character length:1];
+            continue;
+        }
+
+        const char *semicolon = memchr(bytes + i, ';', length - i);
+        if (semicolon == NULL) {
+            [self failWithCode:NSXMLParserEntityRefUnfinishedError description:@"The entity reference is not terminated."];
+            return nil;
+        }
+
+        const char *entity = bytes + i + 1;
+        if (![self appendEntity:entity length:(NSUInteger) (semicolon - entity)]) {
+            return nil;
+        }
+
+        i = (NSUInteger) (semicolon - bytes);
+    }
+
+    return [self stringWithBytes:_decodedBytes.bytes length:_decodedBytes.length];
+}
+
+- (BOOL)appendEntity:(const char *)entity length:(NSUInteger)length {
+    if (length > 1 && entity[0] == '#') {
+        BOOL isHexadecimal = entity[1] == 'x';
+        NSUInteger start = isHexadecimal ? 2 : 1;
+        uint32_t codePoint = 0;
+
+        BOOL valid = length > start;
+        for (NSUInteger i = start; i < length && valid; i++) {
+            char character = entity[i];
+            uint32_t digit;
+
+            if (character >= '0' && character <= '9') {
+                digit = (uint32_t) (character - '0');
+            } else if (isHexadecimal && character >= 'a' && character <= 'f') {
+                digit = (uint32_t) (character - 'a' + 10);
+            } else if (isHexadecimal && character >= 'A' && character <= 'F') {
+                digit = (uint32_t) (character - 'A' + 10);
+            } else {
+                valid = NO;
+                break;
+            }
+
+            codePoint = codePoint * (isHexadecimal ? 16 : 10) + digit;
+            valid = codePoint <= 0x10FFFF;
+        }
+
+        if (!valid || codePoint == 0 || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) {
+            NSString *reference = [[NSString alloc] initWithBytes:entity length:length encoding:NSISOLatin1StringEncoding];
+            [self failWithCode:NSXMLParserInvalidCharacterRefError
+                   description:[NSString stringWithFormat:@"The character reference &%@; is invalid.", reference]];
+            return NO;
+        }
+
+        uint8_t buffer[4];
+        [_decodedBytes appendBytes:buffer length:encodeUtf8(codePoint, buffer)];
+        return YES;
+    }
+
+    for (NSUInteger i = 0; i < qCountOfPredefinedEntities; i++) {
+        const char *name = qPredefinedEntityNames[i];
+        if (strlen(name) == length && memcmp(name, entity, length) == 0) {
+            [_decodedBytes appendBytes:&qPredefinedEntityCharacters[i] length:1];
+            return YES;
+        }
+    }
+
+    NSString *name = [[NSString alloc] initWithBytes:entity length:length encoding:NSISOLatin1StringEncoding];
+    [self failWithCode:NSXMLParserUndeclaredEntityError
+           description:[NSString stringWithFormat:@"The entity &%@; is not declared.", name]];
+    return NO;
+}
+
+- (NSString *)stringWithBytes:(const void *)bytes length:(NSUInteger)length {
+    NSString *result = [[NSString alloc] initWithBytes:bytes length:length encoding:NSUTF8StringEncoding];
+    if (result == nil) {
+        [self failWithCode:NSXMLParserInvalidCharacterError description:@"The document contains invalid UTF-8."];
+    }
+
+    return result;
+}
+
+/**
+* Only the first error is reported; the parsing stops after it.
+*/
+- (void)failWithCode:(NSXMLParserError)code description:(NSString *)description {
+    if (_parserError != nil) {
+        return;
+    }
+
+    NSString *message = [NSString stringWithFormat:@"%@ (line %ld)", description, (long) self.lineNumber];
+    _parserError = [NSError errorWithDomain:NSXMLParserErrorDomain code:code userInfo:@{NSLocalizedDescriptionKey : message}];
+
+    id <NSXMLParserDelegate> delegate = _delegate;
+    if ([delegate respondsToSelector:@selector(parser:parseErrorOccurred:)]) {
+        [delegate parser:self parseErrorOccurred:_parserError];
+    }
+}
+
+@end
@@ -0,0 +1,125 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import <Foundation/Foundation.h>
+#import <TBCacao/TBCacao.h>
+#import <getopt.h>
+#import "QMMindmapReader.h"
+#import "QMOutlineWriter.h"
+#import "QMRootNode.h"
+
+/**
+* Converts mindmaps to outlines without the GUI, eg in batch jobs:
+*
+*   qmind-export [-f text|markdown|opml] [-o output directory] file.mm ...
+*
+* The outline of a.mm is written to a.txt, a.md or a.opml, by default next to a.mm. Each file is converted within its
+* own autorelease pool and the outline is streamed to the file, thus, the memory is bounded by the largest mindmap
+* instead of growing with the number of files.
+*/
+
+static void printUsage() {
+    fprintf(stderr, "usage: qmind-export [-f text|markdown|opml] [-o output directory] file.mm ...\n");
+}
+
+static BOOL formatForName(const char *name, QMOutlineFormat *format, NSString **extension) {
+    if (strcmp(name, "text") == 0) {
+        *format = QMOutlineFormatPlainText;
+        *extension = @"txt";
+        return YES;
+    }
+
+    if (strcmp(name, "markdown") == 0) {
+        *format = QMOutlineFormatMarkdown;
+        *extension = @"md";
+        return YES;
+    }
+
+    if (strcmp(name, "opml") == 0) {
+        *format = QMOutlineFormatOpml;
+        *extension = @"opml";
+        return YES;
+    }
+
+    return NO;
+}
+
+static BOOL exportFile(NSString *path, NSString *outputDirectory, QMOutlineFormat format, NSString *extension) {
+    QMMindmapReader *mindmapReader = [[TBContext sharedContext] beanWithClass:[QMMindmapReader class]];
+    QMRootNode *rootNode = [mindmapReader rootNodeForFileUrl:[NSURL fileURLWithPath:path]];
+
+    if (rootNode == nil) {
+        fprintf(stderr, "could not read %s\n", path.fileSystemRepresentation);
+        return NO;
+    }
+
+    NSString *directory = outputDirectory ?: path.stringByDeletingLastPathComponent;
+    NSString *fileName = [path.lastPathComponent.stringByDeletingPathExtension stringByAppendingPathExtension:extension];
+    NSString *outputPath = [directory stringByAppendingPathComponent:fileName];
+
+    NSOutputStream *stream = [NSOutputStream outputStreamToFileAtPath:outputPath append:NO];
+    [stream open];
+
+    BOOL success = [[[QMOutlineWriter alloc] init] writeOutlineOfNode:rootNode format:format toStream:stream];
+    [stream close];
+
+    if (!success) {
+        fprintf(stderr, "could not write %s: %s\n", outputPath.fileSystemRepresentation,
+                stream.streamError.localizedDescription.UTF8String);
+    }
+
+    return success;
+}
+
+int main(int argc, char *argv[]) {
+    @autoreleasepool {
+        QMOutlineFormat format = QMOutlineFormatPlainText;
+        NSString *extension = @"txt";
+        NSString *outputDirectory = nil;
+
+        int option;
+        while ((option = getopt(argc, argv, "f:o:")) != -1) {
+            switch (option) {
+                case 'f':
+                    if (!formatForName(optarg, &format, &extension)) {
+                        printUsage();
+                        return EXIT_FAILURE;
+                    }
+                    break;
+                case 'o':
+                    outputDirectory = [[NSFileManager defaultManager] stringWithFileSystemRepresentation:optarg
+                                                                                                 length:strlen(optarg)];
+                    break;
+                default:
+                    printUsage();
+                    return EXIT_FAILURE;
+            }
+        }
+
+        if (optind == argc) {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+
+        [[TBContext sharedContext] initContext];
+
+        int result = EXIT_SUCCESS;
+        for (int i = optind; i < argc; i++) {
+            @autoreleasepool {
+                NSString *path = [[NSFileManager defaultManager] stringWithFileSystemRepresentation:argv[i]
+                                                                                            length:strlen(argv[i])];
+
+                if (!exportFile(path, outputDirectory, format, extension)) {
+                    result = EXIT_FAILURE;
+                }
+            }
+        }
+
+        return result;
+    }
+}
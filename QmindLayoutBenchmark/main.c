@@ -0,0 +1,287 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "QMLayoutCore.h"
+
+/**
+* Benchmarks QMLayoutComputeGeometry() without Cocoa, eg on Linux:
+*
+*   make -C QmindLayoutBenchmark run
+*
+* The tree is generated like QMMindmapGenerator does and the text is measured by a stub assuming a fixed width per
+* character, thus, only the layout itself is timed. QM_BENCHMARK_BREADTH, QM_BENCHMARK_DEPTH, QM_BENCHMARK_DEEP_DEPTH
+* and QM_BENCHMARK_OUTPUT have the same meaning and the results the same JSON lines format as in BenchmarkTest.
+*/
+
+static size_t const qBenchmarkIterations = 5;
+static size_t const qBenchmarkTextLength = 30;
+static double const qBenchmarkIconDensity = 0.2;
+
+static double const qStubCharacterWidth = 7;
+static double const qStubLineHeight = 14;
+
+static const char *const qGeneratorWords[] = {
+        "alpha", "bravo", "charlie", "delta", "echo", "foxtrot", "golf", "hotel",
+        "india", "juliet", "kilo", "lima", "mike", "november", "oscar", "papa",
+};
+static size_t const qGeneratorWordCount = sizeof(qGeneratorWords) / sizeof(qGeneratorWords[0]);
+
+typedef struct {
+    QMLayoutNode *nodes;
+    QMLayoutNode **childPointers;
+    char *texts;
+    size_t countOfNodes;
+    size_t breadth;
+    size_t depth;
+} QMBenchmarkTree;
+
+static FILE *outputFile;
+
+static size_t sizeFromEnvironment(const char *name, size_t defaultValue) {
+    const char *value = getenv(name);
+    return value != NULL ? (size_t) strtoul(value, NULL, 10) : defaultValue;
+}
+
+/**
+* Same linear congruential generator as QMMindmapGenerator.
+*/
+static uint64_t randomNumber(uint64_t *state) {
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return *state >> 33;
+}
+
+static double randomFraction(uint64_t *state) {
+    return (double) randomNumber(state) / (double) (1ULL << 31);
+}
+
+static void fillNode(QMLayoutNode *node, char *text, uint64_t *state) {
+    size_t length = 0;
+    text[0] = '\0';
+
+    while (length < qBenchmarkTextLength) {
+        if (length > 0) {
+            text[length++] = ' ';
+        }
+
+        const char *word = qGeneratorWords[randomNumber(state) % qGeneratorWordCount];
+        strcpy(text + length, word);
+        length += strlen(word);
+    }
+
+    node->text = text;
+    node->countOfIcons = randomFraction(state) < qBenchmarkIconDensity ? 1 : 0;
+}
+
+static double elapsedMilliseconds(const struct timespec *start, const struct timespec *end) {
+    return (end->tv_sec - start->tv_sec) * 1000.0 + (end->tv_nsec - start->tv_nsec) / 1000000.0;
+}
+
+static int compareDurations(const void *duration1, const void *duration2) {
+    double difference = *(const double *) duration1 - *(const double *) duration2;
+    return (difference > 0) - (difference < 0);
+}
+
+/**
+* Wraps the text at the max width: each line is as high as the font.
+*/
+static QMLayoutSize measureText(void *context, const QMLayoutNode *node, double maxWidth) {
+    size_t *countOfMeasuredTexts = context;
+    (*countOfMeasuredTexts)++;
+
+    double width = strlen(node->text) * qStubCharacterWidth;
+    double countOfLines = 1;
+    while (width > maxWidth) {
+        width -= maxWidth;
+        countOfLines++;
+    }
+
+    QMLayoutSize size = {countOfLines > 1 ? maxWidth : width, countOfLines * qStubLineHeight};
+    return size;
+}
+
+/**
+* The default values of QMAppSettings.
+*/
+static QMLayoutMetrics defaultMetrics() {
+    QMLayoutMetrics metrics = {
+            .cellHorizontalPadding = 3,
+            .cellVerticalPadding = 3,
+            .iconDrawSize = 16,
+            .interIconDistance = 3,
+            .iconTextDistance = 5,
+            .linkIconDrawSize = 16,
+            .linkIconHorizontalMargin = 3,
+            .nodeMinWidth = 100,
+            .nodeMinHeight = 14,
+            .internodeHorizontalDistance = 30,
+            .internodeVerticalDistance = 7.5,
+            .maxTextNodeWidth = 640,
+            .maxRootCellTextWidth = 400,
+    };
+
+    return metrics;
+}
+
+/**
+* Like -[QMMindmapGenerator rootNode]: every node except the leaves has breadth children, the children of the root
+* alternate between right and left. The nodes are in level order, thus, the children of a node are consecutive.
+*/
+static bool generateTree(QMBenchmarkTree *tree, size_t breadth, size_t depth) {
+    size_t countOfNodes = 1;
+    size_t countOfLevel = 1;
+    for (size_t level = 0; level < depth; level++) {
+        countOfLevel *= breadth;
+        countOfNodes += countOfLevel;
+    }
+
+    tree->breadth = breadth;
+    tree->depth = depth;
+    tree->countOfNodes = countOfNodes;
+    tree->nodes = calloc(countOfNodes, sizeof(QMLayoutNode));
+    tree->childPointers = calloc(countOfNodes, sizeof(QMLayoutNode *));
+    tree->texts = malloc(countOfNodes * (qBenchmarkTextLength + 16));
+    if (tree->nodes == NULL || tree->childPointers == NULL || tree->texts == NULL) {
+        return false;
+    }
+
+    uint64_t state = 1;
+    for (size_t i = 0; i < countOfNodes; i++) {
+        fillNode(&tree->nodes[i], tree->texts + i * (qBenchmarkTextLength + 16), &state);
+    }
+
+    for (size_t i = 1; i < countOfNodes; i++) {
+        tree->childPointers[i] = &tree->nodes[i];
+    }
+
+    size_t countOfParents = countOfNodes - countOfLevel;
+    for (size_t i = 1; i < countOfParents; i++) {
+        tree->nodes[i].children = &tree->childPointers[1 + i * breadth];
+        tree->nodes[i].countOfChildren = breadth;
+    }
+
+    if (depth == 0) {
+        return true;
+    }
+
+    // the root gets the right children first, then the left ones
+    QMLayoutNode *rootNode = &tree->nodes[0];
+    size_t countOfLeftChildren = breadth / 2;
+    size_t countOfRightChildren = breadth - countOfLeftChildren;
+    for (size_t i = 0; i < breadth; i++) {
+        size_t slot = i % 2 == 1 ? countOfRightChildren + i / 2 : i / 2;
+        tree->childPointers[1 + slot] = &tree->nodes[1 + i];
+    }
+    rootNode->children = &tree->childPointers[1];
+    rootNode->countOfChildren = countOfRightChildren;
+    rootNode->leftChildren = &tree->childPointers[1 + rootNode->countOfChildren];
+    rootNode->countOfLeftChildren = countOfLeftChildren;
+
+    return true;
+}
+
+static bool generateChain(QMBenchmarkTree *tree, size_t depth) {
+    tree->breadth = 1;
+    tree->depth = depth;
+    tree->countOfNodes = depth + 1;
+    tree->nodes = calloc(depth + 1, sizeof(QMLayoutNode));
+    tree->childPointers = calloc(depth + 1, sizeof(QMLayoutNode *));
+    tree->texts = NULL;
+    if (tree->nodes == NULL || tree->childPointers == NULL) {
+        return false;
+    }
+
+    for (size_t i = 0; i <= depth; i++) {
+        tree->nodes[i].text = i == 0 ? "root" : (i == depth ? "deepest" : "node");
+
+        if (i < depth) {
+            tree->childPointers[i + 1] = &tree->nodes[i + 1];
+            tree->nodes[i].children = &tree->childPointers[i + 1];
+            tree->nodes[i].countOfChildren = 1;
+        }
+    }
+
+    return true;
+}
+
+static void freeTree(QMBenchmarkTree *tree) {
+    free(tree->nodes);
+    free(tree->childPointers);
+    free(tree->texts);
+}
+
+static void writeResult(const char *name, const QMBenchmarkTree *tree, const double *durations) {
+    fprintf(outputFile, "{\"benchmark\":\"%s\",\"nodes\":%zu,\"breadth\":%zu,\"depth\":%zu,\"iterations\":%zu,"
+            "\"min_ms\":%f,\"median_ms\":%f,\"max_ms\":%f}\n",
+            name, tree->countOfNodes, tree->breadth, tree->depth, qBenchmarkIterations,
+            durations[0], durations[qBenchmarkIterations / 2], durations[qBenchmarkIterations - 1]);
+    fflush(outputFile);
+}
+
+static bool benchmarkTree(const char *name, QMBenchmarkTree *tree, const QMLayoutMetrics *metrics) {
+    double durations[qBenchmarkIterations];
+    size_t countOfMeasuredTexts = 0;
+
+    for (size_t i = 0; i < qBenchmarkIterations; i++) {
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+
+        if (!QMLayoutComputeGeometry(&tree->nodes[0], metrics, measureText, &countOfMeasuredTexts)) {
+            return false;
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        durations[i] = elapsedMilliseconds(&start, &end);
+    }
+
+    qsort(durations, qBenchmarkIterations, sizeof(double), compareDurations);
+    writeResult(name, tree, durations);
+
+    return countOfMeasuredTexts == qBenchmarkIterations * tree->countOfNodes;
+}
+
+int main() {
+    const char *outputPath = getenv("QM_BENCHMARK_OUTPUT");
+    outputFile = outputPath != NULL ? fopen(outputPath, "a") : stdout;
+    if (outputFile == NULL) {
+        perror(outputPath);
+        return 1;
+    }
+
+    QMLayoutMetrics metrics = defaultMetrics();
+    size_t breadth = sizeFromEnvironment("QM_BENCHMARK_BREADTH", 8);
+    size_t depth = sizeFromEnvironment("QM_BENCHMARK_DEPTH", 4);
+    size_t deepDepth = sizeFromEnvironment("QM_BENCHMARK_DEEP_DEPTH", 100000);
+
+    QMBenchmarkTree tree;
+    bool success = generateTree(&tree, breadth, depth) && benchmarkTree("core geometry", &tree, &metrics);
+    freeTree(&tree);
+
+    size_t chainDepths[] = {deepDepth / 4, deepDepth / 2, deepDepth};
+    for (size_t i = 0; success && i < sizeof(chainDepths) / sizeof(chainDepths[0]); i++) {
+        success = generateChain(&tree, chainDepths[i]) && benchmarkTree("core deep geometry", &tree, &metrics);
+        freeTree(&tree);
+    }
+
+    if (outputFile != stdout) {
+        fclose(outputFile);
+    }
+
+    if (!success) {
+        fprintf(stderr, "qmind-layout-benchmark: could not lay out the tree\n");
+        return 1;
+    }
+
+    return 0;
+}
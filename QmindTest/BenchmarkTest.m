@@ -0,0 +1,362 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import "QMCacaoTestCase.h"
+#import "QMBaseTestCase+Util.h"
+#import "QMMindmapGenerator.h"
+#import "QMMindmapReader.h"
+#import "QMMindmapWriter.h"
+#import "QMRootNode.h"
+#import "QMRootCell.h"
+#import "QMCellSelector.h"
+#import "QMDocument.h"
+#import "QMMindmapView.h"
+#import "QMMindmapViewDataSourceImpl.h"
+#import "QMCellPool.h"
+
+static NSUInteger const qBenchmarkIterations = 5;
+
+/**
+* The benchmarks only run when the environment variable QM_BENCHMARK is set, eg
+*
+*   QM_BENCHMARK=1 QM_BENCHMARK_OUTPUT=/tmp/qmind-benchmark.json xcodebuild test -scheme Qmind
+*
+* QM_BENCHMARK_BREADTH and QM_BENCHMARK_DEPTH change the size of the generated mindmap, QM_BENCHMARK_DEEP_DEPTH the
+* depth of the chains of -testDeepMap, by default 100000. Each benchmark appends one JSON
+* object per line to QM_BENCHMARK_OUTPUT, or writes it to the standard output, such that the results of different
+* commits can be compared by scripts.
+*/
+@interface BenchmarkTest : QMCacaoTestCase
+@end
+
+@implementation BenchmarkTest {
+    NSDictionary *environment;
+    BOOL enabled;
+
+    QMMindmapGenerator *generator;
+    QMRootNode *rootNode;
+}
+
+- (void)setUp {
+    [super setUp];
+
+    environment = [[NSProcessInfo processInfo] environment];
+    enabled = environment[@"QM_BENCHMARK"] != nil;
+    if (!enabled) {
+        return;
+    }
+
+    NSUInteger breadth = environment[@"QM_BENCHMARK_BREADTH"] ? [environment[@"QM_BENCHMARK_BREADTH"] integerValue] : 8;
+    NSUInteger depth = environment[@"QM_BENCHMARK_DEPTH"] ? [environment[@"QM_BENCHMARK_DEPTH"] integerValue] : 4;
+
+    generator = [[QMMindmapGenerator alloc] initWithBreadth:breadth depth:depth];
+    generator.textLength = 30;
+    generator.iconDensity = 0.2;
+    generator.fontDensity = 0.1;
+    generator.unsupportedElementDensity = 0.05;
+
+    rootNode = [generator rootNode];
+}
+
+- (void)testGeneratorIsDeterministic {
+    QMMindmapGenerator *smallGenerator = [[QMMindmapGenerator alloc] initWithBreadth:3 depth:2];
+    QMRootNode *rootNode1 = [smallGenerator rootNode];
+    QMRootNode *rootNode2 = [smallGenerator rootNode];
+
+    assertThat(@(smallGenerator.countOfNodes), is(@13));
+    assertThat(rootNode1.children, hasSize(2));
+    assertThat(rootNode1.leftChildren, hasSize(1));
+    assertThat([rootNode1.leftChildren[0] children], hasSize(3));
+
+    assertThat([rootNode1.leftChildren[0] stringValue], is([rootNode2.leftChildren[0] stringValue]));
+    assertThat([rootNode1.children[1] nodeId], is([rootNode2.children[1] nodeId]));
+}
+
+- (void)testWriteAndRead {
+    if (!enabled) {
+        return;
+    }
+
+    QMMindmapWriter *writer = [self.context beanWithClass:[QMMindmapWriter class]];
+    QMMindmapReader *reader = [self.context beanWithClass:[QMMindmapReader class]];
+
+    __block NSData *data;
+    [self benchmark:@"write" usingBlock:^{
+        data = [writer dataForRootNode:rootNode];
+    }];
+
+    NSURL *fileUrl = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:@"qmind-benchmark.mm"]];
+    [data writeToURL:fileUrl atomically:NO];
+
+    [self benchmark:@"read" usingBlock:^{
+        [reader rootNodeForFileUrl:fileUrl];
+    }];
+
+    [[NSFileManager defaultManager] removeItemAtURL:fileUrl error:NULL];
+}
+
+- (void)testLayoutAndSelection {
+    if (!enabled) {
+        return;
+    }
+
+    QMDocument *doc = [[QMDocument alloc] init];
+    wireRootNodeOfDoc(doc, rootNode);
+
+    QMMindmapView *view = [[QMMindmapView alloc] init];
+    QMMindmapViewDataSourceImpl *dataSource = [[QMMindmapViewDataSourceImpl alloc] initWithDoc:doc view:view];
+
+    NSUInteger countOfAllocatedCells = view.cellPool.countOfAllocatedCells;
+    NSUInteger countOfReusedCells = view.cellPool.countOfReusedCells;
+    [self benchmark:@"cells" usingBlock:^{
+        [view initMindmapViewWithDataSource:dataSource];
+    }];
+
+    // the first rebuild allocates all cells, the following ones reuse them
+    [self writeResult:@{
+            @"benchmark" : @"cells allocations",
+            @"nodes" : @(generator.countOfNodes),
+            @"iterations" : @(qBenchmarkIterations),
+            @"allocated_cells" : @(view.cellPool.countOfAllocatedCells - countOfAllocatedCells),
+            @"reused_cells" : @(view.cellPool.countOfReusedCells - countOfReusedCells),
+    }];
+
+    QMCellSelector *selector = [self.context beanWithClass:[QMCellSelector class]];
+    QMRootCell *rootCell = view.rootCell;
+
+    NSMutableArray *allCells = [[NSMutableArray alloc] initWithCapacity:generator.countOfNodes];
+    [selector traverseCell:rootCell usingBlock:^(QMCell *cell, BOOL *stop) {
+        [allCells addObject:cell];
+    }];
+
+    [self benchmark:@"geometry" usingBlock:^{
+        for (QMCell *cell in allCells) {
+            cell.needsToRecomputeSize = YES;
+        }
+
+        [rootCell computeGeometry];
+    }];
+
+    id lastIdentifier = [allCells.lastObject identifier];
+    [self benchmark:@"selector" usingBlock:^{
+        [selector cellWithIdentifier:lastIdentifier fromParentCell:rootCell];
+    }];
+
+    NSUInteger step = MAX(allCells.count / 100, 1);
+    [self benchmark:@"hittest" usingBlock:^{
+        for (NSUInteger i = 0; i < allCells.count; i += step) {
+            [selector cellContainingPoint:[allCells[i] middlePoint] inCell:rootCell];
+        }
+    }];
+}
+
+- (void)testInsertionIntoObservedTree {
+    if (!enabled) {
+        return;
+    }
+
+    QMDocument *doc = [[QMDocument alloc] init];
+    wireRootNodeOfDoc(doc, rootNode);
+
+    QMNode *subtree = rootNode.children[0];
+    [rootNode removeObjectFromChildrenAtIndex:0];
+
+    [self benchmark:@"insert observed subtree" usingBlock:^{
+        [rootNode insertObject:subtree inChildrenAtIndex:0];
+        [rootNode removeObjectFromChildrenAtIndex:0];
+    }];
+}
+
+/**
+* Chains of a quarter, a half and all of QM_BENCHMARK_DEEP_DEPTH nodes. All steps have to finish without overflowing
+* the call stack and their durations should grow linearly with the depth.
+*/
+- (void)testDeepMap {
+    if (!enabled) {
+        return;
+    }
+
+    NSUInteger depth = environment[@"QM_BENCHMARK_DEEP_DEPTH"] ? [environment[@"QM_BENCHMARK_DEEP_DEPTH"] integerValue] : 100000;
+
+    for (NSNumber *chainDepth in @[@(depth / 4), @(depth / 2), @(depth)]) {
+        @autoreleasepool {
+            [self benchmarkChainOfDepth:chainDepth.unsignedIntegerValue];
+        }
+    }
+}
+
+#pragma mark Private
+- (void)benchmarkChainOfDepth:(NSUInteger)depth {
+    NSDictionary *properties = @{
+            @"nodes" : @(depth + 1),
+            @"breadth" : @1,
+            @"depth" : @(depth),
+    };
+
+    [self benchmark:@"deep build and release" properties:properties usingBlock:^{
+        [self rootNodeWithChainOfDepth:depth];
+    }];
+
+    // appending to the deepest node publishes a change of a node at the depth of the chain
+    [self benchmark:@"deep top-down build" properties:properties usingBlock:^{
+        [self appendChainOfDepth:depth toNode:[[QMRootNode alloc] init]];
+    }];
+
+    [self benchmark:@"deep observed top-down build" properties:properties usingBlock:^{
+        QMRootNode *observedRootNode = [[QMRootNode alloc] init];
+        QMDocument *observingDoc = [[QMDocument alloc] init];
+        wireRootNodeOfDoc(observingDoc, observedRootNode);
+
+        [self appendChainOfDepth:depth toNode:observedRootNode];
+        [observedRootNode removeObserver:observingDoc];
+    }];
+
+    QMRootNode *chainRootNode = [self rootNodeWithChainOfDepth:depth];
+    NSUndoManager *undoManager = [[NSUndoManager alloc] init];
+
+    [self benchmark:@"deep undo manager" properties:properties usingBlock:^{
+        chainRootNode.undoManager = undoManager;
+        chainRootNode.undoManager = nil;
+    }];
+
+    [self benchmark:@"deep archive" properties:properties usingBlock:^{
+        NSData *data = [NSKeyedArchiver archivedDataWithRootObject:chainRootNode];
+        [NSKeyedUnarchiver unarchiveObjectWithData:data];
+    }];
+
+    QMMindmapWriter *writer = [self.context beanWithClass:[QMMindmapWriter class]];
+    QMMindmapReader *reader = [self.context beanWithClass:[QMMindmapReader class]];
+
+    __block NSData *data;
+    [self benchmark:@"deep write" properties:properties usingBlock:^{
+        data = [writer dataForRootNode:chainRootNode];
+    }];
+
+    NSURL *fileUrl = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:@"qmind-deep-benchmark.mm"]];
+    [data writeToURL:fileUrl atomically:NO];
+
+    __block QMRootNode *readRootNode;
+    [self benchmark:@"deep read" properties:properties usingBlock:^{
+        readRootNode = [reader rootNodeForFileUrl:fileUrl];
+    }];
+
+    [[NSFileManager defaultManager] removeItemAtURL:fileUrl error:NULL];
+
+    QMNode *deepestReadNode = readRootNode;
+    while (deepestReadNode.children.count > 0) {
+        deepestReadNode = deepestReadNode.children[0];
+    }
+    assertThat(deepestReadNode.stringValue, is(@"deepest"));
+
+    QMDocument *doc = [[QMDocument alloc] init];
+    wireRootNodeOfDoc(doc, chainRootNode);
+
+    QMMindmapView *view = [[QMMindmapView alloc] init];
+    QMMindmapViewDataSourceImpl *dataSource = [[QMMindmapViewDataSourceImpl alloc] initWithDoc:doc view:view];
+
+    [self benchmark:@"deep cells" properties:properties usingBlock:^{
+        [view initMindmapViewWithDataSource:dataSource];
+    }];
+
+    QMRootCell *rootCell = view.rootCell;
+    QMCell *deepestCell = rootCell;
+    while (deepestCell.countOfAllChildren > 0) {
+        deepestCell = deepestCell.allChildren[0];
+    }
+
+    // marking the deepest cell marks all its ancestors, thus, all sizes and the whole geometry are computed again
+    [self benchmark:@"deep geometry" properties:properties usingBlock:^{
+        deepestCell.needsToRecomputeSize = YES;
+        [rootCell computeGeometry];
+    }];
+}
+
+/**
+* The chain is built bottom-up, such that each insertion only touches the inserted node and its new parent.
+*/
+- (QMRootNode *)rootNodeWithChainOfDepth:(NSUInteger)depth {
+    QMNode *topNode = [[QMNode alloc] initWithAttributes:@{qNodeTextAttributeKey : @"deepest"}];
+
+    for (NSUInteger i = 1; i < depth; i++) {
+        QMNode *parentNode = [[QMNode alloc] initWithAttributes:@{qNodeTextAttributeKey : @"node"}];
+        [parentNode addObjectInChildren:topNode];
+        topNode = parentNode;
+    }
+
+    QMRootNode *result = [[QMRootNode alloc] initWithAttributes:@{qNodeTextAttributeKey : @"root"}];
+    [result addObjectInChildren:topNode];
+
+    return result;
+}
+
+- (void)appendChainOfDepth:(NSUInteger)depth toNode:(QMNode *)node {
+    QMNode *deepestNode = node;
+
+    for (NSUInteger i = 0; i < depth; i++) {
+        QMNode *childNode = [[QMNode alloc] initWithAttributes:@{qNodeTextAttributeKey : @"node"}];
+        [deepestNode addObjectInChildren:childNode];
+        deepestNode = childNode;
+    }
+}
+
+- (void)benchmark:(NSString *)name usingBlock:(void (^)())block {
+    NSDictionary *properties = @{
+            @"nodes" : @(generator.countOfNodes),
+            @"breadth" : @(generator.breadth),
+            @"depth" : @(generator.depth),
+    };
+
+    [self benchmark:name properties:properties usingBlock:block];
+}
+
+- (void)benchmark:(NSString *)name properties:(NSDictionary *)properties usingBlock:(void (^)())block {
+    NSMutableArray *durations = [[NSMutableArray alloc] initWithCapacity:qBenchmarkIterations];
+
+    for (NSUInteger i = 0; i < qBenchmarkIterations; i++) {
+        @autoreleasepool {
+            CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+            block();
+            [durations addObject:@((CFAbsoluteTimeGetCurrent() - start) * 1000)];
+        }
+    }
+
+    [durations sortUsingSelector:@selector(compare:)];
+
+    NSMutableDictionary *result = [[NSMutableDictionary alloc] initWithDictionary:properties];
+    [result addEntriesFromDictionary:@{
+            @"benchmark" : name,
+            @"iterations" : @(qBenchmarkIterations),
+            @"min_ms" : durations[0],
+            @"median_ms" : durations[qBenchmarkIterations / 2],
+            @"max_ms" : durations.lastObject,
+    }];
+
+    [self writeResult:result];
+}
+
+- (void)writeResult:(NSDictionary *)result {
+    NSMutableData *line = [[NSJSONSerialization dataWithJSONObject:result options:0 error:NULL] mutableCopy];
+    [line appendBytes:"\n" length:1];
+
+    NSString *outputPath = environment[@"QM_BENCHMARK_OUTPUT"];
+    if (outputPath == nil) {
+        [[NSFileHandle fileHandleWithStandardOutput] writeData:line];
+        return;
+    }
+
+    if (![[NSFileManager defaultManager] fileExistsAtPath:outputPath]) {
+        [[NSFileManager defaultManager] createFileAtPath:outputPath contents:nil attributes:nil];
+    }
+
+    NSFileHandle *fileHandle = [NSFileHandle fileHandleForWritingAtPath:outputPath];
+    [fileHandle seekToEndOfFile];
+    [fileHandle writeData:line];
+    [fileHandle closeFile];
+}
+
+@end
@@ -11,6 +11,9 @@
 #import "QMCell.h"
 #import "QMRootCell.h"
 #import "QMBaseTestCase+Util.h"
+#import "QMLayoutContext.h"
+
+static NSUInteger const qDeepDepth = 20000;
 
 @interface CellComponentTest : QMCacaoTestCase
 @end
@@ -74,4 +77,29 @@
     assertThat(@(newSize.height), lessThanFloat(oldSize.height));
 }
 
+- (void)testDeepFamily {
+    QMLayoutContext *layoutContext = [[QMLayoutContext alloc] init];
+
+    QMCell *topCell = CELL(1, 1);
+    QMCell *deepestCell = topCell;
+    for (NSUInteger i = 0; i < qDeepDepth; i++) {
+        QMCell *childCell = [[QMCell alloc] initWithView:view layoutContext:layoutContext];
+        childCell.stringValue = @"deep";
+
+        [deepestCell addObjectInChildren:childCell];
+        deepestCell = childCell;
+    }
+
+    [rootCell computeGeometry];
+
+    assertThat(@(rootCell.needsToRecomputeSize), isNo);
+    assertThat(@(rootCell.familySize.width), greaterThan(@(qDeepDepth * deepestCell.size.width)));
+    assertThat(@(deepestCell.origin.x), greaterThan(@(topCell.origin.x)));
+    assertThat(deepestCell.line, notNilValue());
+
+    deepestCell.needsToRecomputeSize = YES;
+    assertThat(@(topCell.needsToRecomputeSize), isYes);
+    assertThat(@(rootCell.needsToRecomputeSize), isYes);
+}
+
 @end
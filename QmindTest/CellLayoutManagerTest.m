@@ -371,6 +371,34 @@
     assertThatPoint(childCell1.familyOrigin, equalToPoint(NewPoint(10 + horDist + 10, 10 + 50 - 25)));
 }
 
+/**
+* Relaying out a single left cell, eg after editing its text, keeps its children on the left side.
+*/
+- (void)testLeftCellLayout {
+    cell.left = YES;
+    [cell addObjectInChildren:childCell1];
+    [childCell1 addObjectInChildren:grandChild];
+
+    [given([cellSizeManager sizeOfCell:cell]) willReturnSize:NewSize(10, 100)];
+    [given([cellSizeManager sizeOfChildrenFamily:cell.children]) willReturnSize:NewSize(10, 10)];
+    [given([cellSizeManager sizeOfFamilyOfCell:cell]) willReturnSize:NewSize(10 + horDist + 10 + horDist + 10, 100)];
+
+    [given([cellSizeManager sizeOfCell:childCell1]) willReturnSize:NewSize(10, 10)];
+    [given([cellSizeManager sizeOfChildrenFamily:childCell1.children]) willReturnSize:NewSize(10, 50)];
+    [given([cellSizeManager sizeOfFamilyOfCell:childCell1]) willReturnSize:NewSize(10 + horDist + 10, 50)];
+
+    [given([cellSizeManager sizeOfCell:grandChild]) willReturnSize:NewSize(10, 50)];
+    [given([cellSizeManager sizeOfChildrenFamily:grandChild.children]) willReturnSize:NewSize(0, 0)];
+    [given([cellSizeManager sizeOfFamilyOfCell:grandChild]) willReturnSize:NewSize(10, 50)];
+
+    cell.familyOrigin = NewPoint(10, 10);
+    [manager computeGeometryAndLinesOfCell:cell];
+
+    assertThat(@(childCell1.familyOrigin.x), is(@(cell.familyOrigin.x)));
+    assertThat(@(childCell1.origin.x + childCell1.size.width), lessThanOrEqualTo(@(cell.origin.x)));
+    assertThat(@(grandChild.origin.x + grandChild.size.width), lessThanOrEqualTo(@(childCell1.origin.x)));
+}
+
 - (void)testCellLayout2 {
     [cell addObjectInChildren:childCell1];
     [childCell1 addObjectInChildren:grandChild];
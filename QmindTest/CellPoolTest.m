@@ -0,0 +1,101 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import "QMBaseTestCase.h"
+#import "QMCellPool.h"
+#import "QMCell.h"
+#import "QMRootCell.h"
+#import "QMMindmapView.h"
+#import "QMLayoutContext.h"
+#import "QMIcon.h"
+
+@interface CellPoolTest : QMBaseTestCase @end
+
+@implementation CellPoolTest {
+    QMCellPool *pool;
+    QMMindmapView *view;
+    QMRootCell *rootCell;
+}
+
+- (void)setUp {
+    [super setUp];
+
+    view = mock([QMMindmapView class]);
+    pool = [[QMCellPool alloc] initWithView:view layoutContext:[[QMLayoutContext alloc] init]];
+
+    rootCell = [[QMRootCell alloc] initWithView:view];
+}
+
+- (void)testNewCell {
+    QMCell *cell = [pool cell];
+
+    assertThat(cell.view, is(view));
+    assertThat(@(pool.countOfAllocatedCells), is(@1));
+    assertThat(@(pool.countOfReusedCells), is(@0));
+}
+
+- (void)testRecycle {
+    QMCell *cell = [pool cell];
+    QMCell *leftCell = [pool cell];
+    QMCell *grandChildCell = [pool cell];
+
+    [rootCell addObjectInChildren:cell];
+    [rootCell addObjectInLeftChildren:leftCell];
+    [cell addObjectInChildren:grandChildCell];
+
+    cell.identifier = @"id";
+    cell.stringValue = @"cell";
+    cell.folded = YES;
+    [cell addObjectInIcons:[[QMIcon alloc] initWithCode:@"1"]];
+
+    [pool recycleDescendantsOfCell:rootCell];
+    assertThat(@(pool.countOfPooledCells), is(@3));
+
+    QMCell *reusedCell;
+    for (NSUInteger i = 0; i < 3; i++) {
+        QMCell *pooledCell = [pool cell];
+        if (pooledCell == cell) {
+            reusedCell = pooledCell;
+        }
+    }
+
+    assertThat(reusedCell, notNilValue());
+    assertThat(reusedCell.parent, nilValue());
+    assertThat(reusedCell.identifier, nilValue());
+    assertThat(reusedCell.stringValue, is(@""));
+    assertThat(reusedCell.children, isEmpty());
+    assertThat(reusedCell.icons, isEmpty());
+    assertThatBool(reusedCell.folded, isFalse);
+    assertThatBool(leftCell.left, isFalse);
+    assertThatBool(reusedCell.needsToRecomputeSize, isTrue);
+
+    assertThat(@(pool.countOfAllocatedCells), is(@3));
+    assertThat(@(pool.countOfReusedCells), is(@3));
+}
+
+- (void)testTrimToSizeOfTree {
+    QMCell *cell = [pool cell];
+    [rootCell addObjectInChildren:cell];
+    [cell addObjectInChildren:[pool cell]];
+    [cell addObjectInChildren:[pool cell]];
+    [rootCell addObjectInLeftChildren:[pool cell]];
+
+    [pool recycleDescendantsOfCell:rootCell];
+    assertThat(@(pool.countOfPooledCells), is(@4));
+
+    QMRootCell *smallRootCell = [[QMRootCell alloc] initWithView:view];
+    [smallRootCell addObjectInChildren:[[QMCell alloc] initWithView:view]];
+
+    [pool trimToSizeOfTreeOfCell:smallRootCell];
+    assertThat(@(pool.countOfPooledCells), is(@2));
+
+    [pool trimToSizeOfTreeOfCell:smallRootCell];
+    assertThat(@(pool.countOfPooledCells), is(@2));
+}
+
+@end
@@ -151,6 +151,22 @@
     assertThat(selCells, consistsOf(CELL(3), CELL(4), CELL(5), CELL(6), CELL(7), CELL(8), CELL(9)));
 }
 
+- (void)testShiftClickOverSelectedCellsDoesNotDuplicate {
+    [stateManager addCellToSelection:CELL(2) modifier:0];
+    [stateManager addCellToSelection:CELL(7) modifier:NSCommandKeyMask];
+    [stateManager addCellToSelection:CELL(5) modifier:NSCommandKeyMask];
+    [stateManager addCellToSelection:CELL(0) modifier:NSShiftKeyMask];
+    [stateManager addCellToSelection:CELL(9) modifier:NSShiftKeyMask];
+
+    assertThat(selCells, hasSize(10));
+    assertThat(selCells, consistsOf(CELL(0), CELL(1), CELL(2), CELL(3), CELL(4),
+                                    CELL(5), CELL(6), CELL(7), CELL(8), CELL(9)));
+    for (NSUInteger i = 0; i < 10; i++) {
+        assertThat(@([stateManager cellIsSelected:CELL(i)]), isYes);
+    }
+    assertThat(@([stateManager cellIsSelected:CELL(1, 1)]), isNo);
+}
+
 - (void)testSimpleRemoveOneCell {
     [stateManager addCellToSelection:CELL(0) modifier:0];
     assertThat(selCells, consistsOf(CELL(0)));
@@ -0,0 +1,76 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import <Qkit/Qkit.h>
+#import "QMBaseTestCase.h"
+#import "QMDamageTracker.h"
+#import "QMCell.h"
+#import "QMCellDrawer.h"
+#import "QMMindmapView.h"
+#import "QMAppSettings.h"
+
+@interface DamageTrackerTest : QMBaseTestCase @end
+
+@implementation DamageTrackerTest {
+    QMDamageTracker *tracker;
+
+    QMAppSettings *settings;
+    QMCellDrawer *cellDrawer;
+}
+
+- (void)setUp {
+    [super setUp];
+
+    tracker = [[QMDamageTracker alloc] init];
+
+    settings = [[QMAppSettings alloc] init];
+    cellDrawer = [[QMCellDrawer alloc] init];
+    cellDrawer.settings = settings;
+}
+
+- (void)testUnion {
+    assertThatRect(tracker.damagedRect, equalToRect(NSZeroRect));
+
+    [tracker addRect:NewRect(10, 10, 5, 5)];
+    [tracker addRect:NSZeroRect];
+    [tracker addRect:NewRect(30, 20, 5, 5)];
+
+    assertThatRect(tracker.damagedRect, equalToRect(NewRect(10, 10, 25, 15)));
+}
+
+- (void)testCell {
+    QMCell *cell = [[QMCell alloc] initWithView:mock([QMMindmapView class])];
+    cell.cellDrawer = cellDrawer;
+    cell.origin = NewPoint(100, 50);
+
+    [tracker addCell:cell];
+    [tracker addCell:nil];
+
+    assertThatRect(tracker.damagedRect, equalToRect([cellDrawer displayRectOfCell:cell]));
+    assertThatBool(NSContainsRect(tracker.damagedRect, cell.frame), isTrue);
+    assertThatBool(NSContainsRect(tracker.damagedRect, NewRectExpanding(cell.frame, [settings floatForKey:qSettingNodeFocusRingMargin], [settings floatForKey:qSettingNodeFocusRingMargin])), isTrue);
+}
+
+- (void)testInvalidate {
+    NSView *view = mock([NSView class]);
+
+    [tracker addRect:NewRect(10, 10, 5, 5)];
+    [tracker invalidateView:view];
+
+    [verify(view) setNeedsDisplayInRect:NewRect(10, 10, 5, 5)];
+    assertThatRect(tracker.damagedRect, equalToRect(NSZeroRect));
+}
+
+- (void)testReset {
+    [tracker addRect:NewRect(10, 10, 5, 5)];
+    [tracker reset];
+
+    assertThatRect(tracker.damagedRect, equalToRect(NSZeroRect));
+}
+
+@end
@@ -106,9 +106,10 @@ static NSString * const MINDMAP_EXTENSION = @"mm";
     assertThat(node2.undoManager, is(undoManager));
     assertThat(node1.parent, is(NODE(4)));
     assertThat(node2.parent, is(NODE(4)));
-    assertThat(node1.observerInfos, hasSize(5));
-    assertThat(node2.observerInfos, hasSize(5));
-    assertThat([[node1 objectInChildrenAtIndex:0] observerInfos], hasSize(5));
+    assertThat(node1.observerInfos, hasSize(0));
+
+    [[node1 objectInChildrenAtIndex:0] setStringValue:@"changed"];
+    [verify(controller) updateCellWithIdentifier:[node1 objectInChildrenAtIndex:0]];
 }
 
 - (void)testAppendRootNodeFromPBoardAsChild {
@@ -145,10 +146,23 @@ static NSString * const MINDMAP_EXTENSION = @"mm";
 
     assertThat(child.undoManager, is(undoManager));
     assertThat(child.parent, is(NODE(4)));
-    assertThat(child.observerInfos, hasSize(5));
+    assertThat(child.observerInfos, hasSize(0));
     assertThat(child.stringValue, is(@"test"));
 }
 
+- (void)testAppendOutlineAsChildrenFromPBoard {
+    [given([pasteboard readObjectsForClasses:consistsOf([QMNode class], [NSString class]) options:anything()]) willReturn:@[@"first\n\tchild\nsecond"]];
+    [doc appendItemsFromPBoard:pasteboard asChildrenToItem:NODE(4)];
+
+    assertThat([NODE(4) children], hasSize(NUMBER_OF_GRAND_CHILD + 2));
+    assertThat([NODE(4, NUMBER_OF_GRAND_CHILD) stringValue], is(@"first"));
+    assertThat([NODE(4, NUMBER_OF_GRAND_CHILD, 0) stringValue], is(@"child"));
+    assertThat([NODE(4, NUMBER_OF_GRAND_CHILD + 1) stringValue], is(@"second"));
+
+    assertThat([NODE(4, NUMBER_OF_GRAND_CHILD, 0) undoManager], is(undoManager));
+    [verifyCount(undoManager, times(1)) prepareWithInvocationTarget:NODE(4)];
+}
+
 - (void)testAppendNodesAsLeftChildFromPBoard {
     // we know that we use the same internal method to do this, thus, no duplicate tests...
     // however, if we should refactor the inner working of QMDoc, we should test this separately
@@ -346,6 +360,34 @@ static NSString * const MINDMAP_EXTENSION = @"mm";
     assertThat(@([targetNode countOfAllChildren]), is(@(NUMBER_OF_CHILD + NUMBER_OF_LEFT_CHILD)));
 }
 
+- (void)testMoveItemsIsOneSplice {
+    QMNode *sourceNode = NODE(3);
+    QMNode *nodeToMove1 = NODE(3, 0);
+    QMNode *nodeToMove2 = NODE(3, 2);
+    QMNode *targetNode = NODE(4);
+    [doc moveItems:@[nodeToMove1, nodeToMove2] toItem:targetNode inDirection:QMDirectionRight];
+
+    assertThat(sourceNode.children, hasSize(NUMBER_OF_GRAND_CHILD - 2));
+    assertThat([targetNode objectInChildrenAtIndex:NUMBER_OF_GRAND_CHILD], is(nodeToMove1));
+    assertThat([targetNode objectInChildrenAtIndex:NUMBER_OF_GRAND_CHILD + 1], is(nodeToMove2));
+
+    [verify(undoManager) prepareWithInvocationTarget:sourceNode];
+    [verify(undoManager) prepareWithInvocationTarget:targetNode];
+}
+
+- (void)testMoveItemsWithinParent {
+    QMNode *parentNode = NODE(3);
+    QMNode *nodeToMove1 = NODE(3, 0);
+    QMNode *nodeToMove2 = NODE(3, 1);
+    QMNode *targetNode = NODE(3, 3);
+    [doc moveItems:@[nodeToMove1, nodeToMove2] toItem:targetNode inDirection:QMDirectionBottom];
+
+    assertThat(parentNode.children, hasSize(NUMBER_OF_GRAND_CHILD));
+    assertThat([parentNode objectInChildrenAtIndex:1], is(targetNode));
+    assertThat([parentNode objectInChildrenAtIndex:2], is(nodeToMove1));
+    assertThat([parentNode objectInChildrenAtIndex:3], is(nodeToMove2));
+}
+
 - (void)testAddNewChildNode {
     QMNode *old01 = NODE(0, 1);
 
@@ -356,13 +398,10 @@ static NSString * const MINDMAP_EXTENSION = @"mm";
     assertThat([NODE(0, 1) undoManager], is(undoManager));
     assertThatBool([NODE(0, 1) isCreatedNewly], isTrue);
 
-    QObserverInfo *strInfo = [[QObserverInfo alloc] initWithObserver:doc keyPath:qNodeStringValueKey];
-    QObserverInfo *fontInfo = [[QObserverInfo alloc] initWithObserver:doc keyPath:qNodeFontKey];
-    QObserverInfo *childrenInfo = [[QObserverInfo alloc] initWithObserver:doc keyPath:qNodeChildrenKey];
-    QObserverInfo *foldingInfo = [[QObserverInfo alloc] initWithObserver:doc keyPath:qNodeFoldingKey];
-    QObserverInfo *iconsInfo = [[QObserverInfo alloc] initWithObserver:doc keyPath:qNodeIconsKey];
+    assertThat([NODE(0, 1) observerInfos], hasSize(0));
 
-    assertThat([NODE(0, 1) observerInfos], consistsOfInAnyOrder(strInfo, fontInfo, childrenInfo, foldingInfo, iconsInfo));
+    [NODE(0, 1) setStringValue:@"changed"];
+    [verify(controller) updateCellWithIdentifier:NODE(0, 1)];
 }
 
 - (void)testAddNewLeftChildNode {
@@ -609,6 +648,89 @@ static NSString * const MINDMAP_EXTENSION = @"mm";
     assertThat([LNODE(1) children], isNot(hasItem(nodeToDel)));
 }
 
+- (void)testDeleteItemsIsOneUndoActionPerSiblingArray {
+    QMNode *leftNode2 = LNODE(2);
+    QMNode *leftNode4 = LNODE(4);
+    NSArray *items = @[NODE(3, 1), NODE(3, 5), NODE(3, 7), leftNode2, leftNode4];
+    [doc deleteItems:items];
+
+    assertThat([NODE(3) children], hasSize(NUMBER_OF_GRAND_CHILD - 3));
+    assertThat([NODE(3) children], isNot(hasItems(items[0], items[1], items[2], nil)));
+    assertThat(rootNode.leftChildren, hasSize(NUMBER_OF_LEFT_CHILD - 2));
+    assertThat(rootNode.leftChildren, isNot(hasItems(leftNode2, leftNode4, nil)));
+
+    [verifyCount(undoManager, times(1)) prepareWithInvocationTarget:NODE(3)];
+    [verifyCount(undoManager, times(1)) prepareWithInvocationTarget:rootNode];
+}
+
+- (void)testFoldSubtree {
+    [NODE(4, 2) addObjectInChildren:[[QMNode alloc] init]];
+
+    [doc foldSubtreeOfItem:NODE(4)];
+
+    assertThatBool([NODE(4) isFolded], isTrue);
+    assertThatBool([NODE(4, 2) isFolded], isTrue);
+    assertThatBool([NODE(4, 1) isFolded], isFalse);
+    assertThatBool([NODE(5) isFolded], isFalse);
+    [verifyCount(controller, times(1)) updateCellFoldingInFamilyWithIdentifier:NODE(4) anchorIdentifier:NODE(4)];
+    [verifyCount(controller, never()) updateCellFoldingWithIdentifier:anything()];
+}
+
+- (void)testUnfoldSubtreeToDepth {
+    [NODE(4, 2) addObjectInChildren:[[QMNode alloc] init]];
+    [doc foldSubtreeOfItem:rootNode];
+    assertThatBool([NODE(4) isFolded], isTrue);
+    assertThatBool([LNODE(3) isFolded], isTrue);
+
+    [doc unfoldSubtreeOfItem:rootNode toDepth:2];
+
+    assertThatBool([rootNode isFolded], isFalse);
+    assertThatBool([NODE(4) isFolded], isFalse);
+    assertThatBool([LNODE(3) isFolded], isFalse);
+    assertThatBool([NODE(4, 2) isFolded], isTrue);
+
+    [NODE(4, 2) setFolded:NO];
+    [doc unfoldSubtreeOfItem:rootNode toDepth:1];
+    assertThatBool([NODE(4) isFolded], isTrue);
+    assertThatBool([NODE(4, 2) isFolded], isFalse);
+}
+
+- (void)testUnfoldSubtreeWithoutChangeDoesNotUpdateView {
+    [doc unfoldSubtreeOfItem:NODE(4) toDepth:5];
+    [verifyCount(controller, never()) updateCellFoldingInFamilyWithIdentifier:anything() anchorIdentifier:anything()];
+}
+
+- (void)testUnfoldItem {
+    [NODE(4, 2) addObjectInChildren:[[QMNode alloc] init]];
+    [doc foldSubtreeOfItem:NODE(4)];
+
+    assertThatBool([doc unfoldItem:NODE(4)], isTrue);
+    assertThatBool([NODE(4) isFolded], isFalse);
+    assertThatBool([NODE(4, 2) isFolded], isTrue);
+    [verifyCount(controller, times(2)) updateCellFoldingInFamilyWithIdentifier:NODE(4) anchorIdentifier:NODE(4)];
+
+    assertThatBool([doc unfoldItem:NODE(4)], isFalse);
+    [verifyCount(controller, times(2)) updateCellFoldingInFamilyWithIdentifier:NODE(4) anchorIdentifier:NODE(4)];
+    [verifyCount(controller, never()) updateCellFoldingWithIdentifier:anything()];
+}
+
+- (void)testFoldSiblings {
+    [doc foldSiblingsOfItem:NODE(4)];
+
+    for (QMNode *node in rootNode.children) {
+        assertThat(@(node.folded), is(@(node != NODE(4))));
+    }
+    for (QMNode *node in rootNode.leftChildren) {
+        assertThatBool(node.folded, isFalse);
+    }
+    [verifyCount(controller, times(1)) updateCellFoldingInFamilyWithIdentifier:rootNode anchorIdentifier:NODE(4)];
+
+    [doc foldSiblingsOfItem:LNODE(2)];
+    for (QMNode *node in rootNode.leftChildren) {
+        assertThat(@(node.folded), is(@(node != LNODE(2))));
+    }
+}
+
 - (void)testToggleFolding {
     [NODE(4) setFolded:NO];
     [doc toggleFoldingForItem:NODE(4)];
@@ -706,8 +828,8 @@ static NSString * const MINDMAP_EXTENSION = @"mm";
     QObserverInfo *iconsInfo = [[QObserverInfo alloc] initWithObserver:doc keyPath:qNodeIconsKey];
 
     assertThat(rootNode.observerInfos, consistsOfInAnyOrder(strInfo, fontInfo, childrenInfo, leftChildrenInfo, foldingInfo, iconsInfo));
-    assertThat([NODE(1, 4) observerInfos], consistsOfInAnyOrder(strInfo, fontInfo, childrenInfo, foldingInfo, iconsInfo));
-    assertThat([LNODE(5) observerInfos], consistsOfInAnyOrder(strInfo, fontInfo, childrenInfo, foldingInfo, iconsInfo));
+    assertThat([NODE(1, 4) observerInfos], hasSize(0));
+    assertThat([LNODE(5) observerInfos], hasSize(0));
 }
 
 - (void)testWriteDoc {
@@ -765,6 +887,13 @@ static NSString * const MINDMAP_EXTENSION = @"mm";
     [verify(controller) updateCellForLeftChildRemovalWithIdentifier:rootNode];
 }
 
+- (void)testRemovedItemsAreNotFound {
+    assertThat([doc itemsContainingString:@"7. right"], hasSize(NUMBER_OF_CHILD + 1));
+
+    [rootNode removeObjectFromChildrenAtIndex:7];
+    assertThat([doc itemsContainingString:@"7. right"], hasSize(NUMBER_OF_CHILD - 1));
+}
+
 - (void)testObserveChildrenInsertion {
     QMNode *insertedNode = [[QMNode alloc] init];
 
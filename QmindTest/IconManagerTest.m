@@ -6,6 +6,7 @@
  * See LICENSE
  */
 
+#import <Qkit/Qkit.h>
 #import "QMBaseTestCase.h"
 #import "QMIconManager.h"
 #import "QMCacaoTestCase.h"
@@ -21,6 +22,7 @@
     [super setUp];
 
     manager = [self.context beanWithClass:[QMIconManager class]];
+    [manager clearCache];
 }
 
 - (void)testIconRep {
@@ -29,6 +31,33 @@
     assertThat([manager iconRepresentationForCode:@"jjjjj"], instanceOf(NSImage.class));
 }
 
+- (void)testIconRepIsCached {
+    NSImage *image = [manager iconRepresentationForCode:@"kmail"];
+
+    assertThat([manager iconRepresentationForCode:@"kmail"], sameInstance(image));
+    assertThat(@(manager.cacheHitCount), is(@1));
+    assertThat(@(manager.cacheMissCount), is(@1));
+    assertThat(@(manager.cacheHitRate), is(@0.5));
+}
+
+- (void)testFlippedImage {
+    NSImage *flippedImage = [manager flippedImageForCode:@"kmail" size:NewSize(16, 16)];
+
+    assertThatSize(flippedImage.size, equalToSize(NewSize(16, 16)));
+    assertThat([manager flippedImageForCode:@"kmail" size:NewSize(16, 16)], sameInstance(flippedImage));
+    assertThat([manager flippedImageForCode:@"kmail" size:NewSize(32, 32)], isNot(sameInstance(flippedImage)));
+    assertThat([manager flippedImageForCode:@"full-1" size:NewSize(16, 16)], is(nilValue()));
+}
+
+- (void)testAttributedString {
+    NSDictionary *attrs = @{NSFontAttributeName : [NSFont systemFontOfSize:12]};
+    NSAttributedString *attrStr = [manager attributedStringWithString:@"a" attributes:attrs];
+
+    assertThat(attrStr.string, is(@"a"));
+    assertThat([manager attributedStringWithString:@"a" attributes:[attrs copy]], sameInstance(attrStr));
+    assertThat([manager attributedStringWithString:@"b" attributes:attrs], isNot(sameInstance(attrStr)));
+}
+
 - (void)testIconKind {
     assertThat(@([manager kindForCode:@"closed"]), is(@(QMIconKindImage)));
     assertThat(@([manager kindForCode:@"list"]), is(@(QMIconKindString)));
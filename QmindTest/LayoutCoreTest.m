@@ -0,0 +1,260 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import <Qkit/Qkit.h>
+#import "QMBaseTestCase.h"
+#import "QMLayoutCore.h"
+#import "QMLayoutCoreCocoa.h"
+#import "QMAppSettings.h"
+#import "QMCellLayoutManager.h"
+#import "QMCellSizeManager.h"
+#import "QMTextLayoutManager.h"
+#import "QMMindmapView.h"
+#import "QMRootCell.h"
+#import "QMIcon.h"
+
+static CGFloat const qCharacterWidth = 7;
+static CGFloat const qLineHeight = 14;
+
+/**
+* Counts the measured texts when the context is not NULL.
+*/
+static QMLayoutSize measureText(void *context, const QMLayoutNode *node, double maxWidth) {
+    if (context != NULL) {
+        (*(NSUInteger *) context)++;
+    }
+
+    QMLayoutSize size = {20, 10};
+    return size;
+}
+
+static QMLayoutSize measureTextByLength(void *context, const QMLayoutNode *node, double maxWidth) {
+    QMLayoutSize size = {strlen(node->text) * qCharacterWidth, qLineHeight};
+    return size;
+}
+
+@interface LayoutCoreTest : QMBaseTestCase @end
+
+@implementation LayoutCoreTest {
+    QMLayoutMetrics metrics;
+
+    QMLayoutNode rootNode;
+    QMLayoutNode childNode1, childNode2, grandChildNode, leftChildNode;
+
+    QMLayoutNode *children[2];
+    QMLayoutNode *grandChildren[1];
+    QMLayoutNode *leftChildren[1];
+
+    QMAppSettings *settings;
+    QMCellLayoutManager *cellLayoutManager;
+    QMCellSizeManager *cellSizeManager;
+    QMTextLayoutManager *textLayoutManager;
+    QMMindmapView *view;
+}
+
+- (void)setUp {
+    [super setUp];
+
+    metrics = (QMLayoutMetrics) {
+            .nodeMinWidth = 10,
+            .nodeMinHeight = 10,
+            .internodeHorizontalDistance = 10,
+            .internodeVerticalDistance = 5,
+            .maxTextNodeWidth = 100,
+            .maxRootCellTextWidth = 100,
+    };
+
+    rootNode = (QMLayoutNode) {.text = "root"};
+    childNode1 = (QMLayoutNode) {.text = "child 1"};
+    childNode2 = (QMLayoutNode) {.text = "child 2"};
+    grandChildNode = (QMLayoutNode) {.text = "grand child"};
+    leftChildNode = (QMLayoutNode) {.text = "left child"};
+
+    children[0] = &childNode1;
+    children[1] = &childNode2;
+    grandChildren[0] = &grandChildNode;
+    leftChildren[0] = &leftChildNode;
+
+    rootNode.children = children;
+    rootNode.countOfChildren = 2;
+    rootNode.leftChildren = leftChildren;
+    rootNode.countOfLeftChildren = 1;
+
+    childNode2.children = grandChildren;
+    childNode2.countOfChildren = 1;
+
+    settings = [[QMAppSettings alloc] init];
+    textLayoutManager = mock([QMTextLayoutManager class]);
+    view = mock([QMMindmapView class]);
+
+    cellSizeManager = [[QMCellSizeManager alloc] init];
+    cellSizeManager.settings = settings;
+    cellSizeManager.textLayoutManager = textLayoutManager;
+
+    cellLayoutManager = [[QMCellLayoutManager alloc] init];
+    cellLayoutManager.settings = settings;
+}
+
+- (void)testTree {
+    assertThatBool(QMLayoutComputeGeometry(&rootNode, &metrics, measureText, NULL), isTrue);
+
+    assertThat(@(rootNode.kind), is(@(QMLayoutCellKindRoot)));
+    assertThat(@(childNode2.kind), is(@(QMLayoutCellKindRight)));
+    assertThat(@(leftChildNode.kind), is(@(QMLayoutCellKindLeft)));
+
+    assertThatBool(grandChildNode.parent == &childNode2, isTrue);
+    assertThat(@(childNode2.indexWithinParent), is(@1));
+}
+
+- (void)testSizes {
+    QMLayoutComputeGeometry(&rootNode, &metrics, measureText, NULL);
+
+    assertThat(@(childNode1.size.width), is(@20));
+    assertThat(@(childNode2.familySize.width), is(@(20 + 10 + 20)));
+
+    assertThat(@(rootNode.childrenFamilySize.width), is(@50));
+    assertThat(@(rootNode.childrenFamilySize.height), is(@(10 + 5 + 10)));
+    assertThat(@(rootNode.leftChildrenFamilySize.width), is(@20));
+    assertThat(@(rootNode.familySize.width), is(@(20 + 10 + rootNode.size.width + 10 + 50)));
+}
+
+- (void)testFoldedNode {
+    childNode2.folded = true;
+    NSUInteger countOfMeasuredTexts = 0;
+    QMLayoutComputeGeometry(&rootNode, &metrics, measureText, &countOfMeasuredTexts);
+
+    assertThat(@(childNode2.childrenFamilySize.width), is(@0));
+    assertThat(@(childNode2.familySize.width), is(@20));
+
+    // the subtree of the folded node is skipped
+    assertThat(@(countOfMeasuredTexts), is(@4));
+    assertThatBool(grandChildNode.parent == NULL, isTrue);
+}
+
+- (void)testOrigins {
+    QMLayoutComputeGeometry(&rootNode, &metrics, measureText, NULL);
+
+    assertThat(@(rootNode.origin.x), is(@(20 + 10)));
+    assertThat(@(leftChildNode.origin.x), is(@0));
+
+    double middleY = rootNode.origin.y + rootNode.size.height / 2;
+    assertThat(@(childNode1.familyOrigin.x), is(@(rootNode.origin.x + rootNode.size.width + 10)));
+    assertThat(@(childNode1.familyOrigin.y), is(@(middleY - 25.0 / 2)));
+    assertThat(@(childNode2.familyOrigin.y), is(@(childNode1.familyOrigin.y + 10 + 5)));
+    assertThat(@(grandChildNode.origin.x), is(@(childNode2.origin.x + 20 + 10)));
+}
+
+- (void)testSameGeometryAsCells {
+    QMLayoutNode leftGrandChildNode = {.text = "left grand child"};
+    QMLayoutNode *leftGrandChildren[] = {&leftGrandChildNode};
+    leftChildNode.children = leftGrandChildren;
+    leftChildNode.countOfChildren = 1;
+    childNode1.countOfIcons = 2;
+
+    [self assertCellsHaveSameGeometryAsTreeOfNode:&rootNode];
+}
+
+- (void)testSameGeometryAsCellsWithFoldedNode {
+    childNode2.folded = true;
+
+    [self assertCellsHaveSameGeometryAsTreeOfNode:&rootNode];
+}
+
+- (void)testDeepTree {
+    NSUInteger depth = 100000;
+    QMLayoutNode *nodes = calloc(depth, sizeof(QMLayoutNode));
+    QMLayoutNode **childPointers = calloc(depth, sizeof(QMLayoutNode *));
+
+    for (NSUInteger i = 0; i < depth - 1; i++) {
+        childPointers[i] = &nodes[i + 1];
+        nodes[i].children = &childPointers[i];
+        nodes[i].countOfChildren = 1;
+    }
+
+    assertThatBool(QMLayoutComputeGeometry(&nodes[0], &metrics, measureText, NULL), isTrue);
+    assertThat(@(nodes[depth - 1].origin.x), is(@(nodes[depth - 2].origin.x + nodes[depth - 2].size.width + 10)));
+
+    free(childPointers);
+    free(nodes);
+}
+
+#pragma mark Private
+/**
+* Lays out the tree of the node with QMLayoutComputeGeometry() and the same tree of cells with QMCellLayoutManager, the
+* text of both measured by its length, and compares the geometry of all visible cells.
+*/
+- (void)assertCellsHaveSameGeometryAsTreeOfNode:(QMLayoutNode *)node {
+    QMLayoutMetrics settingsMetrics = settings.layoutMetrics;
+    assertThatBool(QMLayoutComputeGeometry(node, &settingsMetrics, measureTextByLength, NULL), isTrue);
+
+    QMCell *cell = [self cellOfNode:node parentCell:nil left:NO];
+    [cellLayoutManager computeGeometryAndLinesOfCell:cell];
+
+    [self assertCell:cell hasSameGeometryAsNode:node];
+}
+
+- (void)assertCell:(QMCell *)cell hasSameGeometryAsNode:(QMLayoutNode *)node {
+    assertThatSize(cell.size, equalToSize(NSSizeFromQMLayoutSize(node->size)));
+    assertThatSize(cell.familySize, equalToSize(NSSizeFromQMLayoutSize(node->familySize)));
+    assertThatPoint(cell.origin, equalToPoint(NSPointFromQMLayoutPoint(node->origin)));
+    assertThatPoint(cell.familyOrigin, equalToPoint(NSPointFromQMLayoutPoint(node->familyOrigin)));
+    assertThatPoint(cell.textOrigin, equalToPoint(NSPointFromQMLayoutPoint(node->textOrigin)));
+
+    if (node->folded) {
+        return;
+    }
+
+    for (NSUInteger i = 0; i < node->countOfChildren; i++) {
+        [self assertCell:cell.children[i] hasSameGeometryAsNode:node->children[i]];
+    }
+
+    for (NSUInteger i = 0; i < node->countOfLeftChildren; i++) {
+        [self assertCell:[(QMRootCell *) cell leftChildren][i] hasSameGeometryAsNode:node->leftChildren[i]];
+    }
+}
+
+/**
+* The cells are added to their parents before their children are added, such that the children of left cells are left.
+*/
+- (QMCell *)cellOfNode:(QMLayoutNode *)node parentCell:(QMCell *)parentCell left:(BOOL)left {
+    QMCell *cell = parentCell == nil ? [[QMRootCell alloc] initWithView:view] : [[QMCell alloc] initWithView:view];
+    cell.cellLayoutManager = cellLayoutManager;
+    cell.cellSizeManager = cellSizeManager;
+    cell.textLayoutManager = textLayoutManager;
+    cell.cellDrawer = nil;
+    cell.stringValue = @(node->text);
+    cell.folded = node->folded;
+
+    for (NSUInteger i = 0; i < node->countOfIcons; i++) {
+        QMIcon *icon = [[QMIcon alloc] initWithCode:@"1"];
+        icon.settings = settings;
+        [cell addObjectInIcons:icon];
+    }
+
+    CGFloat maxWidth = [settings floatForKey:parentCell == nil ? qSettingMaxRootCellTextWidth : qSettingMaxTextNodeWidth];
+    [given([textLayoutManager sizeOfAttributedString:cell.attributedString maxWidth:maxWidth])
+            willReturnSize:NewSize(cell.stringValue.length * qCharacterWidth, qLineHeight)];
+
+    if (left) {
+        [(QMRootCell *) parentCell addObjectInLeftChildren:cell];
+    } else {
+        [parentCell addObjectInChildren:cell];
+    }
+
+    for (NSUInteger i = 0; i < node->countOfChildren; i++) {
+        [self cellOfNode:node->children[i] parentCell:cell left:NO];
+    }
+
+    for (NSUInteger i = 0; i < node->countOfLeftChildren; i++) {
+        [self cellOfNode:node->leftChildren[i] parentCell:cell left:YES];
+    }
+
+    return cell;
+}
+
+@end
@@ -210,11 +210,20 @@
     assertThat(@([view performDragOperation:info]), isNo);
 }
 
+- (void)testPerformDragOperationArchivedNodesOnly {
+    DummyDraggingInfo *info = [[DummyDraggingInfo alloc] init];
+    info->pasteboard = pasteboard;
+    info->dragSource = view;
+    [given([pasteboard types]) willReturn:@[qNodeUti]];
+
+    assertThat(@([view performDragOperation:info]), isNo);
+}
+
 - (void)testPerformDragOperationNotAllowedSource {
     DummyDraggingInfo *info = [[DummyDraggingInfo alloc] init];
     info->pasteboard = pasteboard;
     info->dragSource = self;
-    [given([pasteboard types]) willReturn:@[qNodeUti]];
+    [given([pasteboard types]) willReturn:@[qNodeReferenceUti, qNodeUti]];
 
     assertThat(@([view performDragOperation:info]), isNo);
 }
@@ -223,7 +232,7 @@
     DummyDraggingInfo *info = [[DummyDraggingInfo alloc] init];
     info->pasteboard = pasteboard;
     info->dragSource = view;
-    [given([pasteboard types]) willReturn:@[qNodeUti]];
+    [given([pasteboard types]) willReturn:@[qNodeReferenceUti, qNodeUti]];
 
     [stateManager addCellToSelection:CELL(4) modifier:0];
     [stateManager addCellToSelection:CELL(6) modifier:NSCommandKeyMask];
@@ -237,7 +246,7 @@
     DummyDraggingInfo *info = [[DummyDraggingInfo alloc] init];
     info->pasteboard = pasteboard;
     info->dragSource = view;
-    [given([pasteboard types]) willReturn:@[qNodeUti]];
+    [given([pasteboard types]) willReturn:@[qNodeReferenceUti, qNodeUti]];
 
     [stateManager addCellToSelection:CELL(4) modifier:0];
     [stateManager addCellToSelection:CELL(6) modifier:NSCommandKeyMask];
@@ -252,7 +261,7 @@
     info->pasteboard = pasteboard;
     info->dragSource = view;
     info->dragOperation = NSDragOperationMove | NSDragOperationCopy;
-    [given([pasteboard types]) willReturn:@[qNodeUti]];
+    [given([pasteboard types]) willReturn:@[qNodeReferenceUti, qNodeUti]];
 
     [stateManager addCellToSelection:CELL(4) modifier:0];
     [stateManager addCellToSelection:CELL(6) modifier:NSCommandKeyMask];
@@ -272,7 +281,7 @@
     info->pasteboard = pasteboard;
     info->dragSource = view;
     info->dragOperation = NSDragOperationCopy;
-    [given([pasteboard types]) willReturn:@[qNodeUti]];
+    [given([pasteboard types]) willReturn:@[qNodeReferenceUti, qNodeUti]];
 
     [stateManager addCellToSelection:CELL(4) modifier:0];
     [stateManager addCellToSelection:CELL(6) modifier:NSCommandKeyMask];
@@ -86,6 +86,16 @@ static NSSize const CELL_SIZE = {100, 20};
     [verify(dataSource) mindmapView:view toggleFoldingForItem:[CELL(4) identifier]];
 }
 
+- (void)testSelectChildrenOfSelectedCell {
+    [stateManager addCellToSelection:CELL(4) modifier:0];
+    [view selectChildrenOfSelectedCell];
+    assertThat([view selectedCells], hasSize(NUMBER_OF_GRAND_CHILD));
+    assertThat([view selectedCells], is([CELL(4) children]));
+
+    [view selectChildrenOfSelectedCell];
+    assertThat([view selectedCells], hasSize(NUMBER_OF_GRAND_CHILD));
+}
+
 - (void)testChangeFontOfSelectedCells {
     rootCell.familyOrigin = NewPoint(10, 10);
     [CELL(1, 5) setFont:[NSFont systemFontOfSize:10]];
@@ -251,6 +261,28 @@ static NSSize const CELL_SIZE = {100, 20};
     [verify(dataSource) mindmapView:view editingCancelledForItem:[CELL(3) identifier] withAttrString:str];
 }
 
+- (void)testZoomDoesNotLayOutCells {
+    rootCell.cellSizeManager = cellSizeManager;
+    rootCell.cellLayoutManager = cellLayoutManager;
+    [given([cellSizeManager sizeOfFamilyOfCell:rootCell]) willReturnSize:NewSize(1, 1)];
+
+    [view zoomByFactor:2];
+    [view zoomToActualSize];
+
+    [verifyCount(cellLayoutManager, never()) computeGeometryAndLinesOfCell:anything()];
+}
+
+- (void)testResizeDoesNotLayOutCells {
+    rootCell.cellSizeManager = cellSizeManager;
+    rootCell.cellLayoutManager = cellLayoutManager;
+    [given([cellSizeManager sizeOfFamilyOfCell:rootCell]) willReturnSize:NewSize(1, 1)];
+
+    [view updateCanvasWithOldClipViewOrigin:NewPoint(0, 0)];
+
+    [verifyCount(cellLayoutManager, never()) computeGeometryAndLinesOfCell:anything()];
+    [verifyCount(editor, never()) endEditing];
+}
+
 - (void)testNoZoomWhenEditing {
     NSSize oldSize = view.frame.size;
     NSEvent *event = mock([NSEvent class]);
@@ -407,6 +439,19 @@ static NSSize const CELL_SIZE = {100, 20};
     assertThat([stateManager selectedCells], consistsOf(CELL(4, 1)));
 }
 
+- (void)testMoveRightOnRightCellBelowAllChildren {
+    [self prepareCell:CELL(4) origin:NewPoint(0, 5000) size:NewSize(100, 100)];
+
+    for (int i = 0; i < NUMBER_OF_GRAND_CHILD; i++) {
+        [self prepareCell:CELL(4, i) origin:NewPoint(150, i * 100) size:NewSize(100, 50)];
+    }
+
+    [stateManager addCellToSelection:CELL(4) modifier:0];
+    [view moveRight:self];
+
+    assertThat([stateManager selectedCells], consistsOf(CELL(4, NUMBER_OF_GRAND_CHILD - 1)));
+}
+
 - (void)testMoveRightOnLeftCell {
     [stateManager addCellToSelection:LCELL(4, 1) modifier:0];
     [view moveRight:self];
@@ -81,6 +81,55 @@
     [self checkLeftChildren:newRootNode];
 }
 
+- (void)testDataForStream {
+    NSOutputStream *stream = [NSOutputStream outputStreamToFileAtPath:tempFileName append:NO];
+    [stream open];
+
+    assertThat(@([writer writeRootNode:rootNode toStream:stream]), isYes);
+    [stream close];
+
+    QMRootNode *newRootNode = [reader rootNodeForFileUrl:tempFileUrl];
+    [self checkRightChildren:newRootNode];
+    [self checkLeftChildren:newRootNode];
+}
+
+- (void)testEscapedText {
+    NSString *text = @"a & b\n<c>\t\"d\"";
+    [rootNode setStringValue:text];
+
+    [[writer dataForRootNode:rootNode] writeToFile:tempFileName atomically:NO];
+
+    QMRootNode *newRootNode = [reader rootNodeForFileUrl:tempFileUrl];
+    assertThat(newRootNode.stringValue, is(text));
+}
+
+/**
+* NSXMLParser cannot read maps deeper than 256 levels.
+*/
+- (void)testDeepMap {
+    NSUInteger depth = 1000;
+
+    rootNode = [[QMRootNode alloc] initWithAttributes:@{qNodeTextAttributeKey : @"root"}];
+    QMNode *deepestNode = rootNode;
+    for (NSUInteger i = 0; i < depth; i++) {
+        QMNode *childNode = [[QMNode alloc] initWithAttributes:@{qNodeTextAttributeKey : @"node"}];
+        [deepestNode addObjectInChildren:childNode];
+        deepestNode = childNode;
+    }
+
+    [[writer dataForRootNode:rootNode] writeToFile:tempFileName atomically:NO];
+
+    QMNode *node = [reader rootNodeForFileUrl:tempFileUrl];
+    NSUInteger depthOfReadMap = 0;
+    while (node.children.count > 0) {
+        node = node.children[0];
+        depthOfReadMap++;
+    }
+
+    assertThat(@(depthOfReadMap), is(@(depth)));
+    assertThat(node.stringValue, is(@"node"));
+}
+
 - (void)checkLeftChildren:(QMRootNode *)aRootNode {
     NSArray *leftChildren = aRootNode.leftChildren;
 
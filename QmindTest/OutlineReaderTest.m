@@ -0,0 +1,189 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import "QMBaseTestCase.h"
+#import "QMOutlineReader.h"
+#import "QMOutlineWriter.h"
+#import "QMRootNode.h"
+
+@interface OutlineReaderTest : QMBaseTestCase @end
+
+@implementation OutlineReaderTest {
+    QMOutlineReader *reader;
+}
+
+- (void)setUp {
+    [super setUp];
+
+    reader = [[QMOutlineReader alloc] init];
+}
+
+- (void)testSingleLine {
+    NSArray *nodes = [reader nodesFromString:@"text"];
+
+    assertThat(nodes, hasSize(1));
+    assertThat([nodes[0] stringValue], is(@"text"));
+    assertThat([nodes[0] children], hasSize(0));
+}
+
+- (void)testTabs {
+    NSArray *nodes = [reader nodesFromString:@"first\n\tchild\n\t\tgrand child\n\n\tsecond child\nsecond"];
+
+    assertThat(nodes, hasSize(2));
+    assertThat([nodes[1] stringValue], is(@"second"));
+
+    QMNode *first = nodes[0];
+    assertThat(first.children, hasSize(2));
+    assertThat([first.children[0] stringValue], is(@"child"));
+    assertThat([[first.children[0] children][0] stringValue], is(@"grand child"));
+    assertThat([first.children[1] stringValue], is(@"second child"));
+}
+
+- (void)testSpaces {
+    NSArray *nodes = [reader nodesFromString:@"first\n  child\n    grand child\n  second child"];
+
+    QMNode *first = nodes[0];
+    assertThat(first.children, hasSize(2));
+    assertThat([[first.children[0] children][0] stringValue], is(@"grand child"));
+}
+
+- (void)testLevelIsClamped {
+    NSArray *nodes = [reader nodesFromString:@"first\n\t\t\tchild"];
+
+    QMNode *first = nodes[0];
+    assertThat(first.children, hasSize(1));
+    assertThat([first.children[0] stringValue], is(@"child"));
+}
+
+- (void)testMarkdown {
+    NSArray *nodes = [reader nodesFromString:@"# title\n## section\n- item\n  * sub item\n1. numbered\n# second title"];
+
+    assertThat(nodes, hasSize(2));
+    assertThat([nodes[0] stringValue], is(@"title"));
+    assertThat([nodes[1] stringValue], is(@"second title"));
+
+    QMNode *section = [nodes[0] children][0];
+    assertThat(section.stringValue, is(@"section"));
+    assertThat(section.children, hasSize(2));
+    assertThat([section.children[0] stringValue], is(@"item"));
+    assertThat([[section.children[0] children][0] stringValue], is(@"sub item"));
+    assertThat([section.children[1] stringValue], is(@"numbered"));
+}
+
+- (void)testNoBullet {
+    NSArray *nodes = [reader nodesFromString:@"*emphasis*\n1.5 liters\n#hashtag"];
+
+    assertThat([nodes[0] stringValue], is(@"*emphasis*"));
+    assertThat([nodes[1] stringValue], is(@"1.5 liters"));
+    assertThat([nodes[2] stringValue], is(@"#hashtag"));
+}
+
+- (void)testOpml {
+    NSString *opml = @"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+            "<opml version=\"2.0\"><head><title>head</title></head><body>"
+            "<outline text=\"first\"><outline text=\"child\"/><outline title=\"titled\"/></outline>"
+            "<outline text=\"second\"/>"
+            "</body></opml>";
+
+    NSArray *nodes = [reader nodesFromString:opml];
+
+    assertThat(nodes, hasSize(2));
+    assertThat([nodes[1] stringValue], is(@"second"));
+
+    QMNode *first = nodes[0];
+    assertThat(first.stringValue, is(@"first"));
+    assertThat(first.children, hasSize(2));
+    assertThat([first.children[0] stringValue], is(@"child"));
+    assertThat([first.children[1] stringValue], is(@"titled"));
+}
+
+- (void)testMarkdownMarkers {
+    NSArray *nodes = [reader nodesFromString:@"- :idea: :stop: text <!-- left --> <!-- folded -->\n  - child\n- :no icon\n- a :b: c"];
+
+    QMNode *node = nodes[0];
+    assertThat(node.stringValue, is(@"text"));
+    assertThat(node.icons, contains(@"idea", @"stop", nil));
+    assertThatBool(node.folded, isTrue);
+    assertThatBool([reader isLeftNode:node], isTrue);
+
+    assertThat([nodes[1] stringValue], is(@":no icon"));
+    assertThat([nodes[1] icons], isEmpty());
+    assertThatBool([reader isLeftNode:nodes[1]], isFalse);
+    assertThat([nodes[2] stringValue], is(@"a :b: c"));
+}
+
+- (void)testMarkdownRoundTrip {
+    [self assertRoundTripOfFormat:QMOutlineFormatMarkdown];
+}
+
+- (void)testOpmlRoundTrip {
+    [self assertRoundTripOfFormat:QMOutlineFormatOpml];
+}
+
+- (void)testDeepOutline {
+    NSMutableString *outline = [[NSMutableString alloc] init];
+    for (NSUInteger i = 0; i < 1000; i++) {
+        [outline appendString:[@"" stringByPaddingToLength:i withString:@"\t" startingAtIndex:0]];
+        [outline appendString:@"x\n"];
+    }
+
+    NSArray *nodes = [reader nodesFromString:outline];
+    assertThat(nodes, hasSize(1));
+
+    QMNode *node = nodes[0];
+    NSUInteger depth = 1;
+    while (node.children.count > 0) {
+        node = node.children[0];
+        depth++;
+    }
+
+    assertThat(@(depth), is(@1000));
+}
+
+#pragma mark Private
+- (void)assertRoundTripOfFormat:(QMOutlineFormat)format {
+    QMRootNode *rootNode = [[QMRootNode alloc] init];
+    rootNode.stringValue = @"root";
+
+    QMNode *child = [[QMNode alloc] init];
+    child.stringValue = @"child";
+    [child addObjectInIcons:@"idea"];
+    [child addObjectInIcons:@"stop"];
+    [rootNode addObjectInChildren:child];
+
+    QMNode *grandChild = [[QMNode alloc] init];
+    grandChild.stringValue = @"grand child";
+    [child addObjectInChildren:grandChild];
+    child.folded = YES;
+
+    QMNode *leftChild = [[QMNode alloc] init];
+    leftChild.stringValue = @"left child";
+    [rootNode addObjectInLeftChildren:leftChild];
+
+    NSString *outline = [[[QMOutlineWriter alloc] init] outlineOfNode:rootNode format:format];
+    NSArray *nodes = [reader nodesFromString:outline];
+
+    assertThat(nodes, hasSize(1));
+    assertThat([nodes[0] stringValue], is(@"root"));
+    assertThat([nodes[0] children], hasSize(2));
+
+    QMNode *readChild = [nodes[0] children][0];
+    assertThat(readChild.stringValue, is(@"child"));
+    assertThat(readChild.icons, contains(@"idea", @"stop", nil));
+    assertThatBool(readChild.folded, isTrue);
+    assertThatBool([reader isLeftNode:readChild], isFalse);
+    assertThat([readChild.children[0] stringValue], is(@"grand child"));
+
+    QMNode *readLeftChild = [nodes[0] children][1];
+    assertThat(readLeftChild.stringValue, is(@"left child"));
+    assertThat(readLeftChild.icons, isEmpty());
+    assertThatBool(readLeftChild.folded, isFalse);
+    assertThatBool([reader isLeftNode:readLeftChild], isTrue);
+}
+
+@end
@@ -0,0 +1,117 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import "QMBaseTestCase.h"
+#import "QMOutlineWriter.h"
+#import "QMRootNode.h"
+
+@interface OutlineWriterTest : QMBaseTestCase @end
+
+@implementation OutlineWriterTest {
+    QMOutlineWriter *writer;
+    QMRootNode *rootNode;
+}
+
+- (void)setUp {
+    [super setUp];
+
+    writer = [[QMOutlineWriter alloc] init];
+
+    rootNode = [[QMRootNode alloc] init];
+    rootNode.stringValue = @"root";
+
+    QMNode *child = [[QMNode alloc] init];
+    child.stringValue = @"child";
+    [rootNode addObjectInChildren:child];
+
+    QMNode *grandChild = [[QMNode alloc] init];
+    grandChild.stringValue = @"grand\nchild";
+    [child addObjectInChildren:grandChild];
+
+    QMNode *secondChild = [[QMNode alloc] init];
+    secondChild.stringValue = @"second child";
+    [rootNode addObjectInChildren:secondChild];
+
+    QMNode *leftChild = [[QMNode alloc] init];
+    leftChild.stringValue = @"left child";
+    [rootNode addObjectInLeftChildren:leftChild];
+}
+
+- (void)testLeaf {
+    QMNode *leaf = [[QMNode alloc] init];
+    leaf.stringValue = @"leaf";
+
+    assertThat([writer plainTextOutlineOfNode:leaf], is(@"leaf"));
+}
+
+- (void)testOutline {
+    assertThat([writer plainTextOutlineOfNode:rootNode],
+               is(@"root\n\tchild\n\t\tgrand child\n\tsecond child\n\tleft child"));
+}
+
+- (void)testAppend {
+    NSMutableString *string = [[NSMutableString alloc] initWithString:@"existing\n"];
+    [writer appendPlainTextOutlineOfNode:rootNode.children[1] toString:string];
+
+    assertThat(string, is(@"existing\nsecond child"));
+}
+
+- (void)testMarkdown {
+    [rootNode.children[1] addObjectInIcons:@"idea"];
+    [rootNode.children[0] setFolded:YES];
+
+    assertThat([writer outlineOfNode:rootNode format:QMOutlineFormatMarkdown],
+               is(@"# root\n- child <!-- folded -->\n  - grand child\n- :idea: second child\n- left child <!-- left -->"));
+}
+
+- (void)testOpml {
+    rootNode.stringValue = @"<root> & \"co\"";
+    [rootNode.children[1] addObjectInIcons:@"idea"];
+    [rootNode.children[1] addObjectInIcons:@"stop"];
+
+    NSString *opml = [writer outlineOfNode:rootNode format:QMOutlineFormatOpml];
+
+    assertThatBool([opml hasPrefix:@"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<opml version=\"2.0\">"], isTrue);
+    assertThatBool([opml hasSuffix:@"\t</body>\n</opml>"], isTrue);
+    assertThatBool([opml rangeOfString:@"<title>&lt;root&gt; &amp; &quot;co&quot;</title>"].location != NSNotFound, isTrue);
+    assertThatBool([opml rangeOfString:@"\t\t\t<outline text=\"child\">\n\t\t\t\t<outline text=\"grand child\"/>\n\t\t\t</outline>"].location != NSNotFound, isTrue);
+    assertThatBool([opml rangeOfString:@"<outline text=\"second child\" icons=\"idea,stop\"/>"].location != NSNotFound, isTrue);
+    assertThatBool([opml rangeOfString:@"<outline text=\"left child\" position=\"left\"/>"].location != NSNotFound, isTrue);
+}
+
+- (void)testWriteToStream {
+    NSOutputStream *stream = [NSOutputStream outputStreamToMemory];
+    [stream open];
+
+    assertThatBool([writer writeOutlineOfNode:rootNode format:QMOutlineFormatPlainText toStream:stream], isTrue);
+    [stream close];
+
+    NSData *data = [stream propertyForKey:NSStreamDataWrittenToMemoryStreamKey];
+    NSString *outline = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
+    assertThat(outline, is(@"root\n\tchild\n\t\tgrand child\n\tsecond child\n\tleft child\n"));
+}
+
+- (void)testDeepTree {
+    QMNode *topNode = [[QMNode alloc] init];
+    topNode.stringValue = @"top";
+
+    QMNode *node = topNode;
+    for (NSUInteger i = 0; i < 1000; i++) {
+        QMNode *child = [[QMNode alloc] init];
+        child.stringValue = @"x";
+        [node addObjectInChildren:child];
+
+        node = child;
+    }
+
+    NSString *outline = [writer plainTextOutlineOfNode:topNode];
+    NSString *deepestLine = [[@"" stringByPaddingToLength:1000 withString:@"\t" startingAtIndex:0] stringByAppendingString:@"x"];
+    assertThatBool([outline hasSuffix:[@"\n" stringByAppendingString:deepestLine]], isTrue);
+}
+
+@end
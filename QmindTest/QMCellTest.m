@@ -15,6 +15,7 @@
 #import "QMCellSizeManager.h"
 #import "QMBaseTestCase.h"
 #import "QMIcon.h"
+#import "QMTextLayout.h"
 
 @interface QMCellTest : QMBaseTestCase @end
 
@@ -128,6 +129,24 @@
     assertThat(@([child2 indexWithinParent]), is(@(1)));
 }
 
+- (void)testIndexWithinParentAfterInsertionAndRemoval {
+    QMCell *child1 = [[QMCell alloc] initWithView:view];
+    QMCell *child2 = [[QMCell alloc] initWithView:view];
+    QMCell *child3 = [[QMCell alloc] initWithView:view];
+
+    [cell addObjectInChildren:child1];
+    [cell addObjectInChildren:child2];
+    [cell insertObject:child3 inChildrenAtIndex:0];
+
+    assertThat(@([child1 indexWithinParent]), is(@(1)));
+    assertThat(@([child2 indexWithinParent]), is(@(2)));
+
+    [cell removeChild:child1];
+
+    assertThat(@([cell indexOfChild:child2]), is(@(1)));
+    assertThat(@([cell indexOfChild:child1]), is(@(NSNotFound)));
+}
+
 - (void)testIndexWithinRoot {
     QMCell *child1 = [[QMCell alloc] initWithView:view];
     QMCell *child2 = [[QMCell alloc] initWithView:view];
@@ -426,6 +445,22 @@
     assertThatRect(cell.textFrame, equalToRect(NewRect(1, 2, 3, 4)));
 }
 
+- (void)testTextLayout {
+    [given([cellSizeManager sizeOfTextOfCell:cell]) willReturnSize:NewSize(3, 4)];
+    QMTextLayoutManager *realTextLayoutManager = [[QMTextLayoutManager alloc] init];
+    cell.textLayoutManager = realTextLayoutManager;
+    cell.stringValue = @"test cell";
+
+    QMTextLayout *textLayout = cell.textLayout;
+    assertThat(textLayout.attributedString, is(cell.attributedString));
+    assertThatSize(textLayout.containerSize, equalToSize(NewSize(3, 4)));
+    assertThat(cell.textLayout, sameInstance(textLayout));
+
+    cell.stringValue = @"new string";
+    assertThat(cell.textLayout, isNot(sameInstance(textLayout)));
+    assertThat(cell.textLayout.attributedString, is(cell.attributedString));
+}
+
 - (void)testIconSize {
     [given([cellSizeManager sizeOfCell:cell]) willReturnSize:NewSize(10, 10)];
     [given([cellSizeManager sizeOfIconsOfCell:cell]) willReturnSize:NewSize(11, 11)];
@@ -112,6 +112,21 @@
     assertThat(@(result.pointSize), is(@(100)));
 }
 
+- (void)testFontFromXmlIsCached {
+    NSDictionary *attrDict = @{@"NAME" : @"Times", @"SIZE" : @"100", @"BOLD" : @"true"};
+
+    NSFont *result = [fontManager fontFromFontAttrDict:attrDict];
+    assertThat([fontManager fontFromFontAttrDict:[attrDict copy]], sameInstance(result));
+    assertThat([fontManager fontFromFontAttrDict:@{@"NAME" : @"Times", @"SIZE" : @"100"}], isNot(sameInstance(result)));
+}
+
+- (void)testFontToXmlIsCached {
+    NSFont *font = [NSFont fontWithName:@"Times" size:200];
+
+    NSDictionary *result = [fontManager fontAttrDictFromFont:font];
+    assertThat([fontManager fontAttrDictFromFont:font], sameInstance(result));
+}
+
 - (void)testWithTraitsFromXml {
     NSMutableDictionary *attrDict = [[NSMutableDictionary alloc] init];
     [attrDict setObject:@"Times" forKey:@"NAME"];
@@ -76,6 +76,14 @@
     assertThatSize(copy.size, equalToSize(original.size));
 }
 
+- (void)testSharedRepresentations {
+    QMIcon *imageIcon1 = [[QMIcon alloc] initWithCode:@"closed"];
+    QMIcon *imageIcon2 = [[QMIcon alloc] initWithCode:@"closed"];
+
+    assertThat(imageIcon2.image, sameInstance(imageIcon1.image));
+    assertThat(imageIcon2.flippedImage, sameInstance(imageIcon1.flippedImage));
+}
+
 - (void)testIconSize {
     QMIcon *icon = [[QMIcon alloc] initWithCode:@"list"];
 
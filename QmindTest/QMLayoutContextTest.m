@@ -0,0 +1,70 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import "QMCacaoTestCase.h"
+#import "QMLayoutContext.h"
+#import "QMCellSizeManager.h"
+#import "QMCellLayoutManager.h"
+#import "QMCellDrawer.h"
+#import "QMTextLayoutManager.h"
+#import "QMTextDrawer.h"
+#import "QMIconManager.h"
+#import "QMAppSettings.h"
+#import "QMFontManager.h"
+#import "QMCell.h"
+#import "QMRootCell.h"
+#import "QMIcon.h"
+
+@interface QMLayoutContextTest : QMCacaoTestCase
+@end
+
+@implementation QMLayoutContextTest {
+    QMLayoutContext *layoutContext;
+}
+
+- (void)setUp {
+    [super setUp];
+
+    layoutContext = [[QMLayoutContext alloc] init];
+}
+
+- (void)testInit {
+    assertThat(layoutContext.cellSizeManager, is([self.context beanWithClass:[QMCellSizeManager class]]));
+    assertThat(layoutContext.cellLayoutManager, is([self.context beanWithClass:[QMCellLayoutManager class]]));
+    assertThat(layoutContext.cellDrawer, is([self.context beanWithClass:[QMCellDrawer class]]));
+    assertThat(layoutContext.textLayoutManager, is([self.context beanWithClass:[QMTextLayoutManager class]]));
+    assertThat(layoutContext.textDrawer, is([self.context beanWithClass:[QMTextDrawer class]]));
+    assertThat(layoutContext.iconManager, is([self.context beanWithClass:[QMIconManager class]]));
+    assertThat(layoutContext.settings, is([self.context beanWithClass:[QMAppSettings class]]));
+    assertThat(layoutContext.fontManager, is([self.context beanWithClass:[QMFontManager class]]));
+    assertThat(layoutContext.systemFontManager, is([self.context beanWithClass:[NSFontManager class]]));
+}
+
+- (void)testCellsWithContext {
+    QMRootCell *rootCell = [[QMRootCell alloc] initWithView:nil layoutContext:layoutContext];
+    QMCell *cell = [[QMCell alloc] initWithView:nil layoutContext:layoutContext];
+
+    assertThat(rootCell.cellSizeManager, is(layoutContext.cellSizeManager));
+    assertThat(rootCell.leftChildren, hasSize(0));
+    assertThat(cell.cellSizeManager, is(layoutContext.cellSizeManager));
+    assertThat(cell.cellLayoutManager, is(layoutContext.cellLayoutManager));
+    assertThat(cell.cellDrawer, is(layoutContext.cellDrawer));
+    assertThat(cell.textLayoutManager, is(layoutContext.textLayoutManager));
+}
+
+- (void)testIconsWithContext {
+    QMIcon *icon = [[QMIcon alloc] initWithCode:@"list" layoutContext:layoutContext];
+    QMIcon *linkIcon = [[QMIcon alloc] initAsLinkWithLayoutContext:layoutContext];
+
+    assertThat(icon.layoutContext, is(layoutContext));
+    assertThat(icon.iconManager, is(layoutContext.iconManager));
+    assertThat(linkIcon.layoutContext, is(layoutContext));
+    assertThat([icon copy], hasProperty(@"layoutContext", layoutContext));
+}
+
+@end
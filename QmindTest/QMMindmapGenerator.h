@@ -0,0 +1,50 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import <Foundation/Foundation.h>
+
+@class QMRootNode;
+
+/**
+* Generates synthetic mindmaps for benchmarks. The same settings and seed always result in the same mindmap.
+*
+* The densities are probabilities between 0 and 1 per node.
+*/
+@interface QMMindmapGenerator : NSObject
+
+/**
+* Number of children of each non-leaf node. Half of the children of the root node are left children.
+*/
+@property NSUInteger breadth;
+
+/**
+* Number of levels below the root node.
+*/
+@property NSUInteger depth;
+
+/**
+* Approximate number of characters of each node text.
+*/
+@property NSUInteger textLength;
+
+@property double iconDensity;
+@property double fontDensity;
+@property double unsupportedElementDensity;
+
+@property uint64_t seed;
+
+/**
+* Number of nodes including the root node the generated mindmap will have.
+*/
+@property (readonly) NSUInteger countOfNodes;
+
+- (id)initWithBreadth:(NSUInteger)breadth depth:(NSUInteger)depth;
+
+- (QMRootNode *)rootNode;
+
+@end
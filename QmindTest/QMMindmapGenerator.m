@@ -0,0 +1,149 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import <Cocoa/Cocoa.h>
+#import "QMMindmapGenerator.h"
+#import "QMRootNode.h"
+
+static NSString *const qGeneratorWords[] = {
+        @"alpha", @"bravo", @"charlie", @"delta", @"echo", @"foxtrot", @"golf", @"hotel",
+        @"india", @"juliet", @"kilo", @"lima", @"mike", @"november", @"oscar", @"papa",
+};
+static NSUInteger const qGeneratorWordCount = sizeof(qGeneratorWords) / sizeof(qGeneratorWords[0]);
+
+static NSString *const qGeneratorIcons[] = {@"flag-pink", @"attach", @"password", @"pencil", @"full-1", @"idea"};
+static NSUInteger const qGeneratorIconCount = sizeof(qGeneratorIcons) / sizeof(qGeneratorIcons[0]);
+
+@implementation QMMindmapGenerator {
+    uint64_t _state;
+    NSUInteger _idCounter;
+}
+
+@dynamic countOfNodes;
+
+#pragma mark Public
+- (NSUInteger)countOfNodes {
+    NSUInteger count = 1;
+    NSUInteger countOfLevel = 1;
+
+    for (NSUInteger level = 0; level < self.depth; level++) {
+        countOfLevel *= self.breadth;
+        count += countOfLevel;
+    }
+
+    return count;
+}
+
+- (QMRootNode *)rootNode {
+    _state = self.seed;
+    _idCounter = 0;
+
+    QMRootNode *rootNode = [[QMRootNode alloc] initWithAttributes:[self attributesForNewNode]];
+    [self fillContentsOfNode:rootNode];
+
+    if (self.depth == 0) {
+        return rootNode;
+    }
+
+    for (NSUInteger i = 0; i < self.breadth; i++) {
+        QMNode *childNode = [self nodeWithDepth:self.depth - 1];
+
+        if (i % 2 == 1) {
+            [rootNode addObjectInLeftChildren:childNode];
+        } else {
+            [rootNode addObjectInChildren:childNode];
+        }
+    }
+
+    return rootNode;
+}
+
+#pragma mark Initializer
+- (id)initWithBreadth:(NSUInteger)breadth depth:(NSUInteger)depth {
+    if ((self = [super init])) {
+        _breadth = breadth;
+        _depth = depth;
+        _textLength = 20;
+        _seed = 1;
+    }
+
+    return self;
+}
+
+#pragma mark NSObject
+- (id)init {
+    return [self initWithBreadth:5 depth:3];
+}
+
+#pragma mark Private
+- (QMNode *)nodeWithDepth:(NSUInteger)depth {
+    QMNode *node = [[QMNode alloc] initWithAttributes:[self attributesForNewNode]];
+    [self fillContentsOfNode:node];
+
+    if (depth == 0) {
+        return node;
+    }
+
+    for (NSUInteger i = 0; i < self.breadth; i++) {
+        [node addObjectInChildren:[self nodeWithDepth:depth - 1]];
+    }
+
+    return node;
+}
+
+- (NSDictionary *)attributesForNewNode {
+    _idCounter++;
+
+    return @{
+            qNodeIdAttributeKey : [NSString stringWithFormat:@"ID_%lu", _idCounter],
+            qNodeTextAttributeKey : [self randomText],
+    };
+}
+
+- (void)fillContentsOfNode:(QMNode *)node {
+    if ([self randomFraction] < self.iconDensity) {
+        [node addObjectInIcons:qGeneratorIcons[[self randomNumber] % qGeneratorIconCount]];
+    }
+
+    if ([self randomFraction] < self.fontDensity) {
+        node.font = [NSFont fontWithName:@"Helvetica" size:10 + [self randomNumber] % 20];
+    }
+
+    if ([self randomFraction] < self.unsupportedElementDensity) {
+        NSString *unsupportedElement = [NSString stringWithFormat:@"<attribute NAME=\"key\" VALUE=\"%lu\"/>", _idCounter];
+        [node.unsupportedChildren addObject:unsupportedElement];
+    }
+}
+
+- (NSString *)randomText {
+    NSMutableString *text = [[NSMutableString alloc] initWithCapacity:self.textLength + 10];
+
+    while (text.length < self.textLength) {
+        if (text.length > 0) {
+            [text appendString:@" "];
+        }
+
+        [text appendString:qGeneratorWords[[self randomNumber] % qGeneratorWordCount]];
+    }
+
+    return text;
+}
+
+/**
+* Linear congruential generator such that the mindmaps do not depend on the state of random().
+*/
+- (uint64_t)randomNumber {
+    _state = _state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return _state >> 33;
+}
+
+- (double)randomFraction {
+    return (double) [self randomNumber] / (double) (1ULL << 31);
+}
+
+@end
@@ -159,10 +159,16 @@
 
     node1.stringValue = @"this is really a random text";
     node2.stringValue = @"this is really a random text and this....";
+    node1.nodeId = @"ID_1";
+    node2.nodeId = @"ID_2";
 
     NSPasteboard *board = [NSPasteboard pasteboardWithName:NSDragPboard];
     [dataSource mindmapView:view prepareDragAndDropWithCells:@[cell1, cell2]];
 
+    assertThat(board.pasteboardItems, hasSize(2));
+    assertThat([board.pasteboardItems[0] propertyListForType:qNodeReferenceUti][qNodeReferenceNodeIdKey], is(@"ID_1"));
+    assertThat([board.pasteboardItems[1] propertyListForType:qNodeReferenceUti][qNodeReferenceNodeIdKey], is(@"ID_2"));
+
     NSArray *array = [board readObjectsForClasses:@[[QMNode class]] options:nil];
     assertThat([array[0] stringValue], is(@"this is really a random text"));
     assertThat([array[1] stringValue], is(@"this is really a random text and this...."));
@@ -313,8 +319,7 @@
     [verify(undoManager) beginUndoGrouping];
     [verify(undoManager) setActionName:NSLocalizedString(@"undo.node.deletion", @"Deletion of Node(s)")];
 
-    [verify(doc) deleteItem:object1];
-    [verify(doc) deleteItem:object2];
+    [verify(doc) deleteItems:@[object1, object2]];
 
     [verify(undoManager) endUndoGrouping];
 }
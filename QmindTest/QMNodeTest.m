@@ -12,6 +12,8 @@
 
 #define INITIAL_STRING_VALUE @"initial value"
 
+static NSUInteger const qDeepDepth = 20000;
+
 @interface QMNodeTest : QMBaseTestCase
 @end
 
@@ -73,6 +75,82 @@
     assertThat(copiedChild.unsupportedChildren, consistsOf(@"jfd"));
 }
 
+- (void)testCopyIsNotAffectedByLaterMutations {
+    QMNode *child = [[QMNode alloc] init];
+    QMNode *grandChild = [[QMNode alloc] init];
+    grandChild.stringValue = @"grand child";
+    [child addObjectInChildren:grandChild];
+    [node addObjectInChildren:child];
+
+    QMNode *copied = [node copy];
+
+    grandChild.stringValue = @"changed";
+    [grandChild addObjectInIcons:@"icon"];
+    [child addObjectInChildren:[[QMNode alloc] init]];
+    [node removeObjectFromChildrenAtIndex:0];
+
+    assertThat(copied.children, hasSize(1));
+
+    QMNode *copiedChild = [copied objectInChildrenAtIndex:0];
+    assertThat(copiedChild.parent, is(copied));
+    assertThat(copiedChild.children, hasSize(1));
+    assertThat([copiedChild objectInChildrenAtIndex:0].stringValue, is(@"grand child"));
+    assertThat([copiedChild objectInChildrenAtIndex:0].icons, isEmpty());
+}
+
+- (void)testCopyOfCopyIsNotAffectedByLaterMutations {
+    QMNode *child = [[QMNode alloc] init];
+    QMNode *grandChild = [[QMNode alloc] init];
+    grandChild.stringValue = @"grand child";
+    [child addObjectInChildren:grandChild];
+    [node addObjectInChildren:child];
+
+    QMNode *copied = [node copy];
+    QMNode *copiedChild = [copied objectInChildrenAtIndex:0];
+    QMNode *copyOfCopy = [copied copy];
+
+    // the children of copied children become part of the copied subtree of copied when they get copied
+    [copiedChild objectInChildrenAtIndex:0].stringValue = @"changed";
+
+    QMNode *grandChildOfCopyOfCopy = [[copyOfCopy objectInChildrenAtIndex:0] objectInChildrenAtIndex:0];
+    assertThat(grandChildOfCopyOfCopy.stringValue, is(@"grand child"));
+}
+
+- (void)testMutatingCopyDoesNotAffectSource {
+    QMNode *child = [[QMNode alloc] init];
+    child.stringValue = @"child";
+    [node addObjectInChildren:child];
+
+    QMNode *copied = [node copy];
+    QMNode *copyOfCopy = [copied copy];
+
+    [copied objectInChildrenAtIndex:0].stringValue = @"changed";
+    [copied addObjectInChildren:[[QMNode alloc] init]];
+
+    assertThat(node.children, hasSize(1));
+    assertThat(child.stringValue, is(@"child"));
+    assertThat(copyOfCopy.children, hasSize(1));
+    assertThat([copyOfCopy objectInChildrenAtIndex:0].stringValue, is(@"child"));
+}
+
+- (void)testIndexWithinParent {
+    QMNode *child1 = [[QMNode alloc] init];
+    QMNode *child2 = [[QMNode alloc] init];
+    QMNode *child3 = [[QMNode alloc] init];
+
+    [node addObjectInChildren:child1];
+    [node addObjectInChildren:child2];
+    [node insertChildren:@[child3] atIndexes:[NSIndexSet indexSetWithIndex:0]];
+
+    assertThat(@(child1.indexWithinParent), is(@(1)));
+    assertThat(@(child2.indexWithinParent), is(@(2)));
+
+    [node removeChildrenAtIndexes:[NSIndexSet indexSetWithIndex:1]];
+
+    assertThat(@(child3.indexWithinParent), is(@(0)));
+    assertThat(@(child2.indexWithinParent), is(@(1)));
+}
+
 - (void)testIsRoot {
     assertThat(@([node isRoot]), isNo);
 }
@@ -156,6 +234,9 @@
     NSPasteboardWritingOptions nodeWriteOption = [node writingOptionsForType:qNodeUti pasteboard:nil];
     assertThat(@(nodeWriteOption), is(@(NSPasteboardWritingPromised)));
 
+    NSPasteboardWritingOptions stringWriteOption = [node writingOptionsForType:NSPasteboardTypeString pasteboard:nil];
+    assertThat(@(stringWriteOption), is(@(NSPasteboardWritingPromised)));
+
     NSPasteboardWritingOptions otherOption = [node writingOptionsForType:@"fds" pasteboard:nil];
     assertThat(@(otherOption), is(@(0)));
 }
@@ -242,6 +323,43 @@
     assertThat(decodedChild.icons, consistsOf(@"childicon"));
 }
 
+- (void)testDeepSubtree {
+    QMNode *deepestNode = [[QMNode alloc] init];
+    deepestNode.stringValue = @"deepest";
+
+    QMNode *topNode = deepestNode;
+    for (NSUInteger i = 1; i < qDeepDepth; i++) {
+        QMNode *parentNode = [[QMNode alloc] init];
+        [parentNode addObjectInChildren:topNode];
+        topNode = parentNode;
+    }
+
+    [node addObjectInChildren:topNode];
+    assertThat(deepestNode.undoManager, is(undoManager));
+
+    NSMutableData *data = [NSMutableData data];
+    NSKeyedArchiver *encoder = [[NSKeyedArchiver alloc] initForWritingWithMutableData:data];
+    [node encodeWithCoder:encoder];
+    [encoder finishEncoding];
+
+    NSKeyedUnarchiver *decoder = [[NSKeyedUnarchiver alloc] initForReadingWithData:data];
+    QMNode *decodedNode = [[QMNode alloc] initWithCoder:decoder];
+    [decoder finishDecoding];
+
+    NSUInteger depth = 0;
+    QMNode *decodedDeepestNode = decodedNode;
+    while (decodedDeepestNode.children.count > 0) {
+        assertThat(decodedDeepestNode.children, hasSize(1));
+        assertThat([decodedDeepestNode.children[0] parent], is(decodedDeepestNode));
+
+        decodedDeepestNode = decodedDeepestNode.children[0];
+        depth++;
+    }
+
+    assertThat(@(depth), is(@(qDeepDepth)));
+    assertThat(decodedDeepestNode.stringValue, is(@"deepest"));
+}
+
 - (void)testInsertIcon {
     [node insertObject:@"icon 1" inIconsAtIndex:0];
     [node insertObject:@"icon 2" inIconsAtIndex:0];
@@ -298,7 +416,7 @@
 
     assertThat(childNode, is([node objectInChildrenAtIndex:1]));
     assertThat(childNode.parent, is(node));
-    assertThat(childNode.observerInfos, consistsOfInAnyOrder(strInfo, fontInfo, childrenInfo, foldingInfo, iconsInfo));
+    assertThat(childNode.observerInfos, hasSize(0));
     assertThat(childNode.undoManager, is(undoManager));
 
     assertThat(@(undoManager.canUndo), isYes);
@@ -325,7 +443,7 @@
 
     assertThat(childNode, is([node objectInChildrenAtIndex:0]));
     assertThat(childNode.parent, is(node));
-    assertThat(childNode.observerInfos, consistsOfInAnyOrder(strInfo, fontInfo, childrenInfo, foldingInfo, iconsInfo));
+    assertThat(childNode.observerInfos, hasSize(0));
     assertThat(childNode.undoManager, is(undoManager));
 
     assertThat(@(undoManager.canUndo), isYes);
@@ -333,6 +451,53 @@
     assertThat(node.children, hasSize(1));
 }
 
+- (void)testInsertChildren {
+    node.undoManager = nil;
+    [node addObjectInChildren:[[QMNode alloc] init]];
+
+    node.undoManager = undoManager;
+    QMNode *childNode1 = [[QMNode alloc] init];
+    QMNode *childNode2 = [[QMNode alloc] init];
+    [node insertChildren:@[childNode1, childNode2] atIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 2)]];
+
+    assertThat(node.children, hasSize(3));
+    assertThat([node objectInChildrenAtIndex:0], is(childNode1));
+    assertThat([node objectInChildrenAtIndex:1], is(childNode2));
+    assertThat(childNode2.parent, is(node));
+    assertThat(childNode2.observerInfos, hasSize(0));
+    assertThat(childNode2.undoManager, is(undoManager));
+    assertThat(observer.lastKeyPath, is(qNodeChildrenKey));
+
+    [undoManager undo];
+    assertThat(node.children, hasSize(1));
+    assertThat(@(undoManager.canUndo), isNo);
+}
+
+- (void)testRemoveChildren {
+    QMNode *childNode1 = [[QMNode alloc] init];
+    QMNode *childNode2 = [[QMNode alloc] init];
+    QMNode *childNode3 = [[QMNode alloc] init];
+
+    node.undoManager = nil;
+    [node addObjectInChildren:childNode1];
+    [node addObjectInChildren:childNode2];
+    [node addObjectInChildren:childNode3];
+    node.undoManager = undoManager;
+
+    NSMutableIndexSet *indexes = [[NSMutableIndexSet alloc] initWithIndex:0];
+    [indexes addIndex:2];
+    [node removeChildrenAtIndexes:indexes];
+
+    assertThat(node.children, consistsOf(childNode2));
+    assertThat(childNode1.parent, nilValue());
+    assertThat(childNode3.observerInfos, hasSize(0));
+
+    [undoManager undo];
+    assertThat(node.children, consistsOf(childNode1, childNode2, childNode3));
+    assertThat(childNode3.parent, is(node));
+    assertThat(@(undoManager.canUndo), isNo);
+}
+
 - (void)testChildAtIndex {
     QMNode *childNode = [[QMNode alloc] init];
     [node addObjectInChildren:childNode];
@@ -378,7 +543,41 @@
     [parentNode addObserver:observer forKeyPath:qNodeStringValueKey];
 
     assertThat(parentNode.observerInfos, consistsOf(observerInfo));
-    assertThat([NODE(1, 4) observerInfos], consistsOf(observerInfo));
+    assertThat([NODE(1, 4) observerInfos], hasSize(0));
+}
+
+- (void)testObserverGetsChangesOfDescendants {
+    QMRootNode *rootNode = [self rootNodeForTest];
+    QMNode *parentNode = NODE(1);
+
+    [parentNode addObserver:observer forKeyPath:qNodeStringValueKey];
+
+    [NODE(1, 4) setStringValue:@"changed"];
+    assertThat(observer.lastObservedObj, is(NODE(1, 4)));
+    assertThat(observer.lastKeyPath, is(qNodeStringValueKey));
+
+    [parentNode removeObserver:observer];
+}
+
+- (void)testObserverDoesNotGetChangesOfRemovedDescendants {
+    QMRootNode *rootNode = [self rootNodeForTest];
+    QMNode *parentNode = NODE(1);
+    QMNode *childNode = NODE(1, 4);
+
+    [parentNode addObserver:observer forKeyPath:qNodeStringValueKey];
+    [parentNode addObserver:observer forKeyPath:qNodeChildrenKey];
+    [parentNode removeObjectFromChildrenAtIndex:4];
+    assertThat(observer.lastObservedObj, is(parentNode));
+
+    childNode.stringValue = @"changed";
+    assertThat(observer.lastObservedObj, is(parentNode));
+    assertThat(observer.lastKeyPath, is(qNodeChildrenKey));
+
+    [parentNode insertObject:childNode inChildrenAtIndex:4];
+    childNode.stringValue = @"changed again";
+    assertThat(observer.lastObservedObj, is(childNode));
+
+    [parentNode removeObserver:observer];
 }
 
 - (void)testRemoveObserver {
@@ -392,6 +591,25 @@
     assertThat([NODE(1, 4) observerInfos], hasSize(0));
 }
 
+- (void)testObserversOfAllObservedAncestorsGetChanges {
+    QMRootNode *rootNode = [self rootNodeForTest];
+    DummyObserver *rootObserver = [[DummyObserver alloc] init];
+
+    [rootNode addObserver:rootObserver forKeyPath:qNodeStringValueKey];
+    [NODE(1) addObserver:observer forKeyPath:qNodeStringValueKey];
+
+    [NODE(1, 4) setStringValue:@"changed"];
+    assertThat(observer.lastObservedObj, is(NODE(1, 4)));
+    assertThat(rootObserver.lastObservedObj, is(NODE(1, 4)));
+
+    [NODE(1) removeObserver:observer];
+    [NODE(1, 5) setStringValue:@"changed"];
+    assertThat(observer.lastObservedObj, is(NODE(1, 4)));
+    assertThat(rootObserver.lastObservedObj, is(NODE(1, 5)));
+
+    [rootNode removeObserver:rootObserver];
+}
+
 - (void)testKvoForStringValue {
     [node addObserver:observer forKeyPath:qNodeStringValueKey];
 
@@ -0,0 +1,81 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import "QMBaseTestCase.h"
+#import "QMBaseTestCase+Util.h"
+#import "QMSearchIndex.h"
+#import "QMRootNode.h"
+
+@interface QMSearchIndexTest : QMBaseTestCase
+@end
+
+@implementation QMSearchIndexTest {
+    QMRootNode *rootNode;
+    QMSearchIndex *searchIndex;
+}
+
+- (void)setUp {
+    [super setUp];
+
+    rootNode = [self rootNodeForTest];
+    searchIndex = [[QMSearchIndex alloc] initWithRootNode:rootNode];
+}
+
+- (void)testPrefix {
+    assertThat([searchIndex nodesWithPrefix:@"lef"], hasSize(NUMBER_OF_LEFT_CHILD * (1 + NUMBER_OF_LEFT_GRAND_CHILD)));
+    assertThat([searchIndex nodesWithPrefix:@"ROOT"], consistsOf(rootNode));
+    assertThat([searchIndex nodesWithPrefix:@"7 lef"], hasSize(20));
+    assertThat([searchIndex nodesWithPrefix:@"ight"], hasSize(0));
+    assertThat([searchIndex nodesWithPrefix:@""], hasSize(0));
+}
+
+- (void)testSubstring {
+    assertThat([searchIndex nodesContainingString:@"7. RIGHT"], hasSize(NUMBER_OF_CHILD + 1));
+    assertThat([searchIndex nodesContainingString:@"ight nod"], hasSize(NUMBER_OF_CHILD * (1 + NUMBER_OF_GRAND_CHILD)));
+    assertThat([searchIndex nodesContainingString:@"upward"], hasSize(0));
+}
+
+- (void)testDocumentOrder {
+    NSArray *nodes = [searchIndex nodesContainingString:@"7. right"];
+
+    assertThat(nodes[0], is(NODE(0, 7)));
+    assertThat(nodes[7], is(NODE(7)));
+    assertThat(nodes[8], is(NODE(7, 7)));
+    assertThat(nodes.lastObject, is(NODE(9, 7)));
+
+    nodes = [searchIndex nodesWithPrefix:@"node"];
+    assertThat(nodes[0], is(rootNode));
+    assertThat(nodes[1], is(NODE(0)));
+    assertThat(nodes.lastObject, is(LNODE(9, 9)));
+}
+
+- (void)testUpdateNode {
+    NODE(3).stringValue = @"changed text";
+
+    assertThat([searchIndex nodesWithPrefix:@"changed"], hasSize(0));
+
+    [searchIndex updateNode:NODE(3)];
+
+    assertThat([searchIndex nodesWithPrefix:@"changed"], consistsOf(NODE(3)));
+    assertThat([searchIndex nodesContainingString:@"3. right node"], hasSize(NUMBER_OF_CHILD));
+}
+
+- (void)testRemoveNode {
+    QMNode *node = NODE(7);
+    [rootNode removeObjectFromChildrenAtIndex:7];
+    [searchIndex removeNode:node];
+
+    assertThat([searchIndex nodesContainingString:@"7. right"], hasSize(NUMBER_OF_CHILD - 1));
+    assertThat([searchIndex nodesWithPrefix:@"7 right"], hasSize(NUMBER_OF_CHILD - 1));
+
+    [rootNode insertObject:node inChildrenAtIndex:7];
+    [searchIndex addNode:node];
+    assertThat([searchIndex nodesContainingString:@"7. right"], hasSize(NUMBER_OF_CHILD + 1));
+}
+
+@end
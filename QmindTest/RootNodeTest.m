@@ -122,10 +122,12 @@
     assertThat(rootNode.observerInfos, hasSize(3));
     assertThat(rootNode.observerInfos, consistsOfInAnyOrder(strInfo, childrenInfo, leftChildrenInfo));
 
-    assertThat([NODE(1, 4) observerInfos], hasSize(2));
-    assertThat([NODE(1, 4) observerInfos], consistsOfInAnyOrder(strInfo, childrenInfo));
-    assertThat([LNODE(1, 4) observerInfos], hasSize(2));
-    assertThat([LNODE(1, 4) observerInfos], consistsOfInAnyOrder(strInfo, childrenInfo));
+    assertThat([NODE(1, 4) observerInfos], hasSize(0));
+    assertThat([LNODE(1, 4) observerInfos], hasSize(0));
+
+    [LNODE(1, 4) setStringValue:@"changed"];
+    assertThat(observer.lastObservedObj, is(LNODE(1, 4)));
+    assertThat(observer.lastKeyPath, is(qNodeStringValueKey));
 }
 
 - (void)testRemoveObserver {
@@ -272,7 +274,7 @@
 
     assertThat(childNode, is([rootNode.leftChildren objectAtIndex:1]));
     assertThat(childNode.parent, is(rootNode));
-    assertThat(childNode.observerInfos, consistsOfInAnyOrder(strInfo, fontInfo, childrenInfo));
+    assertThat(childNode.observerInfos, hasSize(0));
     assertThat(childNode.undoManager, is(undoManager));
 
     assertThat(@(undoManager.canUndo), isYes);
@@ -292,7 +294,7 @@
 
     assertThat(childNode, is([rootNode.leftChildren objectAtIndex:0]));
     assertThat(childNode.parent, is(rootNode));
-    assertThat(childNode.observerInfos, consistsOfInAnyOrder(strInfo, fontInfo, childrenInfo));
+    assertThat(childNode.observerInfos, hasSize(0));
     assertThat(childNode.undoManager, is(undoManager));
 
     assertThat(@(undoManager.canUndo), isYes);
@@ -337,6 +339,27 @@
     assertThat(@(removeChildKvo), isYes);
 }
 
+- (void)testLeftAndIndexWithinParent {
+    QMNode *childNode = [[QMNode alloc] init];
+    QMNode *grandChildNode = [[QMNode alloc] init];
+    [childNode addObjectInChildren:grandChildNode];
+
+    [rootNode addObjectInLeftChildren:[[QMNode alloc] init]];
+    [rootNode insertObject:childNode inLeftChildrenAtIndex:0];
+
+    assertThat(@(childNode.left), isYes);
+    assertThat(@(grandChildNode.left), isYes);
+    assertThat(@(childNode.indexWithinParent), is(@(0)));
+    assertThat(@([rootNode objectInLeftChildrenAtIndex:1].indexWithinParent), is(@(1)));
+
+    [rootNode removeObjectFromLeftChildrenAtIndex:0];
+    [rootNode addObjectInChildren:childNode];
+
+    assertThat(@(childNode.left), isNo);
+    assertThat(@(grandChildNode.left), isNo);
+    assertThat(@([rootNode objectInLeftChildrenAtIndex:0].indexWithinParent), is(@(0)));
+}
+
 - (void)observeValueForKeyPath:(NSString *)keyPath ofObject:(id)object change:(NSDictionary *)change context:(void *)context {
     if ([[change objectForKey:NSKeyValueChangeKindKey] intValue] == NSKeyValueChangeInsertion) {
         insertChildKvo = YES;
@@ -11,6 +11,7 @@
 #import <Qkit/Qkit.h>
 #import "QMAppSettings.h"
 #import "QMCacaoTestCase.h"
+#import "QMTextLayout.h"
 
 #define INFINITE_WIDTH 10000.0
 
@@ -111,4 +112,39 @@
                     lessThanFloat([manager sizeOfString:multilineStr maxWidth:MAX_CGFLOAT].height));
 }
 
+- (void)testTextLayout {
+    NSDictionary *attrDict = [manager stringAttributesDictWithFont:smallFont];
+    NSAttributedString *attrStr = [[NSAttributedString alloc] initWithString:longStr attributes:attrDict];
+    NSSize size = [manager sizeOfAttributedString:attrStr maxWidth:300];
+
+    QMTextLayout *textLayout = [manager textLayoutOfAttributedString:attrStr containerSize:size];
+    assertThat(textLayout.attributedString, is(attrStr));
+    assertThatSize(textLayout.containerSize, equalToSize(size));
+
+    assertThatBool([textLayout isLayoutOfAttributedString:attrStr containerSize:size], isTrue);
+    assertThatBool([textLayout isLayoutOfAttributedString:attrStr containerSize:NewSize(300, 10)], isFalse);
+    assertThatBool([textLayout isLayoutOfAttributedString:[attrStr copy] containerSize:size], isFalse);
+}
+
+- (void)testOnlyRecentlyUsedTextLayoutsAreKept {
+    QMTextLayoutManager *boundedManager = [[QMTextLayoutManager alloc] init];
+    boundedManager.maxCountOfTextLayouts = 2;
+
+    NSAttributedString *attrStr = [[NSAttributedString alloc] initWithString:shortStr];
+    __weak QMTextLayout *textLayout1;
+    __weak QMTextLayout *textLayout2;
+    __weak QMTextLayout *textLayout3;
+
+    @autoreleasepool {
+        textLayout1 = [boundedManager textLayoutOfAttributedString:attrStr containerSize:NewSize(100, 20)];
+        textLayout2 = [boundedManager textLayoutOfAttributedString:attrStr containerSize:NewSize(200, 20)];
+        [boundedManager touchTextLayout:textLayout1];
+        textLayout3 = [boundedManager textLayoutOfAttributedString:attrStr containerSize:NewSize(300, 20)];
+    }
+
+    assertThat(textLayout1, notNilValue());
+    assertThat(textLayout2, nilValue());
+    assertThat(textLayout3, notNilValue());
+}
+
 @end
@@ -0,0 +1,179 @@
+/**
+ * Tae Won Ha
+ * http://qvacua.com
+ * https://github.com/qvacua
+ *
+ * See LICENSE
+ */
+
+#import "QMBaseTestCase.h"
+#import "QMXmlParser.h"
+
+/**
+* Records the events as strings. When switching the delegate, it sets a new recorder, which shares the events, at each
+* start of an element and the parent at the end, like QMProxyNode; the recorders do not retain each other.
+*/
+@interface XmlParserTestRecorder : NSObject <NSXMLParserDelegate>
+
+@property NSMutableArray *events;
+@property (weak) XmlParserTestRecorder *parent;
+@property BOOL switchesDelegate;
+
+@end
+
+@implementation XmlParserTestRecorder
+
+- (id)init {
+    if ((self = [super init])) {
+        _events = [[NSMutableArray alloc] init];
+    }
+
+    return self;
+}
+
+- (void)parser:(NSXMLParser *)parser didStartElement:(NSString *)elementName namespaceURI:(NSString *)namespaceURI qualifiedName:(NSString *)qName attributes:(NSDictionary *)attributeDict {
+    NSArray *keys = [attributeDict.allKeys sortedArrayUsingSelector:@selector(compare:)];
+    NSMutableArray *attributes = [[NSMutableArray alloc] init];
+    for (NSString *key in keys) {
+        [attributes addObject:[NSString stringWithFormat:@"%@=%@", key, attributeDict[key]]];
+    }
+
+    [self.events addObject:[NSString stringWithFormat:@"start %@ %@", elementName, [attributes componentsJoinedByString:@","]]];
+
+    if (self.switchesDelegate) {
+        XmlParserTestRecorder *child = [[XmlParserTestRecorder alloc] init];
+        child.parent = self;
+        child.events = self.events;
+        child.switchesDelegate = YES;
+        [parser setDelegate:child];
+    }
+}
+
+- (void)parser:(NSXMLParser *)parser didEndElement:(NSString *)elementName namespaceURI:(NSString *)namespaceURI qualifiedName:(NSString *)qName {
+    XmlParserTestRecorder *recorderOfParent = self.switchesDelegate ? self.parent : self;
+    [self.events addObject:[NSString stringWithFormat:@"end %@", elementName]];
+
+    if (self.switchesDelegate) {
+        [parser setDelegate:recorderOfParent];
+    }
+}
+
+- (void)parser:(NSXMLParser *)parser foundCharacters:(NSString *)string {
+    [self.events addObject:[NSString stringWithFormat:@"text %@", string]];
+}
+
+- (void)parser:(NSXMLParser *)parser foundComment:(NSString *)comment {
+    [self.events addObject:[NSString stringWithFormat:@"comment %@", comment]];
+}
+
+@end
+
+@interface XmlParserTest : QMBaseTestCase @end
+
+@implementation XmlParserTest {
+    XmlParserTestRecorder *recorder;
+}
+
+- (void)setUp {
+    [super setUp];
+
+    recorder = [[XmlParserTestRecorder alloc] init];
+}
+
+- (void)testElementsAndAttributes {
+    assertThat(@([self parse:@"<map version=\"0.9.0\">\n<node TEXT='a' ID=\"1\"/>\n</map>"]), isYes);
+
+    assertThat(recorder.events, consistsOf(
+            @"start map version=0.9.0",
+            @"text \n",
+            @"start node ID=1,TEXT=a",
+            @"end node",
+            @"text \n",
+            @"end map"
+    ));
+}
+
+- (void)testEntities {
+    assertThat(@([self parse:@"<a b=\"&lt;&amp;&quot;&apos;&#xa;&#228;\nx\">&gt;&#x1F600;</a>"]), isYes);
+
+    assertThat(recorder.events, consistsOf(
+            @"start a b=<&\"'\nä x",
+            @"text >\U0001F600",
+            @"end a"
+    ));
+}
+
+- (void)testCommentsCDataAndDeclarations {
+    NSString *xml = @"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<!DOCTYPE map [<!ELEMENT map ANY>]>\n"
+            "<!-- before --><map><![CDATA[<b>&amp;</b>]]><!-- in --></map>";
+    assertThat(@([self parse:xml]), isYes);
+
+    assertThat(recorder.events, consistsOf(
+            @"comment  before ",
+            @"start map ",
+            @"text <b>&amp;</b>",
+            @"comment  in ",
+            @"end map"
+    ));
+}
+
+- (void)testDeclaredEncoding {
+    NSString *xml = @"<?xml version=\"1.0\" encoding=\"ISO-8859-1\"?><a b=\"ä\"/>";
+    QMXmlParser *parser = [[QMXmlParser alloc] initWithData:[xml dataUsingEncoding:NSISOLatin1StringEncoding]];
+    parser.delegate = recorder;
+
+    assertThat(@([parser parse]), isYes);
+    assertThat(recorder.events, consistsOf(@"start a b=ä", @"end a"));
+}
+
+- (void)testMismatchedEndTag {
+    QMXmlParser *parser = [self parserForString:@"<map>\n\n</node>\n</map>"];
+
+    assertThat(@([parser parse]), isNo);
+    assertThat(@(parser.parserError.code), is(@(NSXMLParserTagNameMismatchError)));
+    assertThat(@(parser.lineNumber), is(@3));
+}
+
+- (void)testMalformedDocuments {
+    assertThat(@([self parse:@""]), isNo);
+    assertThat(@([self parse:@"<map>"]), isNo);
+    assertThat(@([self parse:@"<map a=b/>"]), isNo);
+    assertThat(@([self parse:@"<map a=\"1\" a=\"2\"/>"]), isNo);
+    assertThat(@([self parse:@"<map>&nbsp;</map>"]), isNo);
+    assertThat(@([self parse:@"<map/><map/>"]), isNo);
+}
+
+- (void)testDeepDocument {
+    NSUInteger depth = 10000;
+
+    NSMutableString *xml = [[NSMutableString alloc] init];
+    for (NSUInteger i = 0; i < depth; i++) {
+        [xml appendString:@"<node>"];
+    }
+    for (NSUInteger i = 0; i < depth; i++) {
+        [xml appendString:@"</node>"];
+    }
+
+    // the recorders are only retained by the parser
+    recorder.switchesDelegate = YES;
+    assertThat(@([self parse:xml]), isYes);
+
+    assertThat(recorder.events, hasSize(2 * depth));
+    assertThat(recorder.events[depth - 1], is(@"start node "));
+    assertThat(recorder.events[depth], is(@"end node"));
+}
+
+#pragma mark Private
+- (QMXmlParser *)parserForString:(NSString *)xml {
+    QMXmlParser *parser = [[QMXmlParser alloc] initWithData:[xml dataUsingEncoding:NSUTF8StringEncoding]];
+    parser.delegate = recorder;
+
+    return parser;
+}
+
+- (BOOL)parse:(NSString *)xml {
+    [recorder.events removeAllObjects];
+    return [[self parserForString:xml] parse];
+}
+
+@end